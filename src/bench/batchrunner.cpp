@@ -0,0 +1,48 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/batchrunner.hpp>
+
+using namespace Amber;
+using namespace Bench;
+using namespace Gameboy;
+
+#define BENCH_TAGS "[batchrunner]"
+
+TEST_CASE("BatchRunner::Run", BENCH_TAGS)
+{
+	constexpr size_t instance_count = 16;
+	constexpr size_t frame_count = 2;
+
+	DeviceFixture fixture;
+	auto base = fixture.GetDevice().Fork();
+
+	const auto run = [&base](size_t a_ThreadCount, bool a_Lockstep = false)
+	{
+		BatchRunner runner(a_ThreadCount);
+		runner.SetLockstepEnabled(a_Lockstep);
+		for (size_t i = 0; i < instance_count; ++i)
+		{
+			runner.AddInstance(base->Fork(), frame_count);
+		}
+
+		runner.Run();
+		return runner.GetResult(0).m_FrameBufferHash;
+	};
+
+	BENCHMARK("BatchRunner::Run 16 instances, 1 thread")
+	{
+		return run(1);
+	};
+
+	BENCHMARK("BatchRunner::Run 16 instances, every hardware thread")
+	{
+		return run(0);
+	};
+
+	BENCHMARK("BatchRunner::Run 16 identical instances, 1 thread, lockstep")
+	{
+		return run(1, true);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/mmu.hpp>
+
+#include <common/ram.hpp>
+
+#include <initializer_list>
+#include <memory>
+
+using namespace Amber;
+using namespace Bench;
+using namespace Gameboy;
+
+#define BENCH_TAGS "[cpu]"
+
+namespace
+{
+	// CPU running on a flat 64 kb address space, so only the interpreter itself is measured
+	class CPUFixture
+	{
+		public:
+		CPUFixture():
+			m_Memory(0x10000),
+			m_CPU(m_Memory)
+		{
+			m_CPU.StoreRegister16(CPU::RegisterSP, 0xFFFE);
+		}
+
+		// Fills the whole address space with the given instruction sequence
+		void Fill(std::initializer_list<uint8_t> a_Pattern)
+		{
+			uint8_t* data = m_Memory.GetData();
+			for (size_t i = 0; i < m_Memory.GetSize(); i += a_Pattern.size())
+			{
+				for (size_t j = 0; j < a_Pattern.size() && i + j < m_Memory.GetSize(); ++j)
+				{
+					data[i + j] = a_Pattern.begin()[j];
+				}
+			}
+		}
+
+		// Places the given program at address 0
+		void Load(std::initializer_list<uint8_t> a_Program)
+		{
+			uint8_t* data = m_Memory.GetData();
+			for (const uint8_t byte : a_Program)
+			{
+				*data++ = byte;
+			}
+		}
+
+		CPU& GetCPU() noexcept
+		{
+			return m_CPU;
+		}
+
+		private:
+		Common::RAM16<false> m_Memory;
+		CPU m_CPU;
+	};
+}
+
+TEST_CASE("CPU::CPU", BENCH_TAGS)
+{
+	// Batch runs create a lot of short-lived devices, so construction has to stay cheap
+	Common::RAM16<false> memory(0x10000);
+
+	BENCHMARK("CPU::CPU")
+	{
+		return std::make_unique<CPU>(memory);
+	};
+}
+
+TEST_CASE("CPU::Tick", BENCH_TAGS)
+{
+	SECTION("NOP stream")
+	{
+		CPUFixture fixture;
+		auto& cpu = fixture.GetCPU();
+
+		BENCHMARK("CPU::Tick NOP")
+		{
+			return cpu.Tick();
+		};
+	}
+
+	SECTION("ALU stream")
+	{
+		CPUFixture fixture;
+		fixture.Fill({
+			0x80, // ADD A, B
+			0xA9, // XOR A, C
+			0x14, // INC D
+			0x1D, // DEC E
+			0xA4, // AND A, H
+			0xB5, // OR A, L
+			0x90, // SUB A, B
+			0xB9, // CP A, C
+			0x27, // DAA
+			0x1F, // RRA
+			0x09, // ADD HL, BC
+			0xCB, 0x37, // SWAP A
+		});
+		auto& cpu = fixture.GetCPU();
+
+		BENCHMARK("CPU::Tick ALU")
+		{
+			return cpu.Tick();
+		};
+	}
+
+	SECTION("Register loop")
+	{
+		// The same register-only loop on each execution tier, a JIT trace covers the whole loop body
+		const auto make_fixture = []
+		{
+			auto fixture = std::make_unique<CPUFixture>();
+			fixture->Load({
+				0x80,       // 0x0000: ADD A, B
+				0xA9,       // 0x0001: XOR A, C
+				0x14,       // 0x0002: INC D
+				0x1D,       // 0x0003: DEC E
+				0xA4,       // 0x0004: AND A, H
+				0xB5,       // 0x0005: OR A, L
+				0x90,       // 0x0006: SUB A, B
+				0xB9,       // 0x0007: CP A, C
+				0x27,       // 0x0008: DAA
+				0x1F,       // 0x0009: RRA
+				0x09,       // 0x000A: ADD HL, BC
+				0xCB, 0x37, // 0x000B: SWAP A
+				0x18, 0xF1, // 0x000D: JR 0x0000
+			});
+			return fixture;
+		};
+
+		auto interpreter = make_fixture();
+		BENCHMARK("CPU::Tick register loop")
+		{
+			return interpreter->GetCPU().Tick();
+		};
+
+		auto block_cache = make_fixture();
+		block_cache->GetCPU().SetBlockCacheEnabled(true);
+		BENCHMARK("CPU::Tick register loop, block cache")
+		{
+			return block_cache->GetCPU().Tick();
+		};
+
+		if (JIT::IsSupported())
+		{
+			auto jit = make_fixture();
+			jit->GetCPU().SetJITEnabled(true);
+			BENCHMARK("CPU::Tick register loop, JIT")
+			{
+				return jit->GetCPU().Tick();
+			};
+		}
+	}
+
+	SECTION("Load/store stream")
+	{
+		CPUFixture fixture;
+		fixture.Load({
+			0x21, 0x00, 0xC0, // 0x0000: LD HL, 0xC000
+			0x7E,             // 0x0003: LD A, (HL)
+			0x3C,             // 0x0004: INC A
+			0x77,             // 0x0005: LD (HL), A
+			0x2C,             // 0x0006: INC L
+			0x06, 0x42,       // 0x0007: LD B, 0x42
+			0xEA, 0x00, 0xD0, // 0x0009: LD (0xD000), A
+			0xFA, 0x00, 0xD0, // 0x000C: LD A, (0xD000)
+			0x18, 0xF2,       // 0x000F: JR 0x0003
+		});
+		auto& cpu = fixture.GetCPU();
+
+		BENCHMARK("CPU::Tick load/store")
+		{
+			return cpu.Tick();
+		};
+	}
+
+	SECTION("Branch stream")
+	{
+		CPUFixture fixture;
+		fixture.Load({
+			0xCD, 0x08, 0x00, // 0x0000: CALL 0x0008
+			0xC2, 0x00, 0x00, // 0x0003: JP NZ, 0x0000
+			0x18, 0xF8,       // 0x0006: JR 0x0000
+			0xC5,             // 0x0008: PUSH BC
+			0xC1,             // 0x0009: POP BC
+			0xC9,             // 0x000A: RET
+		});
+		auto& cpu = fixture.GetCPU();
+
+		BENCHMARK("CPU::Tick branch")
+		{
+			return cpu.Tick();
+		};
+	}
+
+	SECTION("Immediate stream")
+	{
+		// Runs from cartridge ROM through the device's MMU, every instruction fetches a 16-bit operand
+		DeviceFixture fixture;
+		uint8_t* rom = fixture.GetCartridge().GetROM().GetData() + 0x100;
+		for (const uint8_t byte : {
+			0x01, 0x34, 0x12, // 0x0100: LD BC, 0x1234
+			0x11, 0x78, 0x56, // 0x0103: LD DE, 0x5678
+			0x21, 0x00, 0xC0, // 0x0106: LD HL, 0xC000
+			0x31, 0xFE, 0xDF, // 0x0109: LD SP, 0xDFFE
+			0xCD, 0x12, 0x01, // 0x010C: CALL 0x0112
+			0xC3, 0x00, 0x01, // 0x010F: JP 0x0100
+			0xC9,             // 0x0112: RET
+		})
+		{
+			*rom++ = byte;
+		}
+
+		auto& cpu = fixture.GetDevice().GetCPU();
+		cpu.StoreRegister16(CPU::RegisterPC, 0x0100);
+
+		BENCHMARK("CPU::Tick immediate")
+		{
+			return cpu.Tick();
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/device.hpp>
+#include <gameboy/ppu.hpp>
+
+#include <initializer_list>
+
+using namespace Amber;
+using namespace Bench;
+using namespace Gameboy;
+
+#define BENCH_TAGS "[device]"
+
+namespace
+{
+	void LoadProgram(DeviceFixture& a_Fixture, std::initializer_list<uint8_t> a_Program)
+	{
+		uint8_t* rom = a_Fixture.GetCartridge().GetROM().GetData() + 0x100;
+		for (const uint8_t byte : a_Program)
+		{
+			*rom++ = byte;
+		}
+
+		auto& cpu = a_Fixture.GetDevice().GetCPU();
+		cpu.StoreRegister16(CPU::RegisterSP, 0xFFFE);
+		cpu.StoreRegister16(CPU::RegisterPC, 0x0100);
+	}
+}
+
+TEST_CASE("Device::Run", BENCH_TAGS)
+{
+	SECTION("Waiting for VBlank")
+	{
+		// The usual main loop of a game that's done with its frame early: wait for LY to reach VBlank, then halt. The
+		// PPU runs as in headless turbo mode, so it doesn't hide what the CPU saves.
+		DeviceFixture fixture;
+		LoadProgram(fixture, {
+			0x3E, 0x01,       // 0x0100: LD A, 0x01
+			0xE0, 0xFF,       // 0x0102: LD (0xFFFF), A
+			0xF0, 0x44,       // 0x0104: LD A, (0xFF44)
+			0xFE, 0x90,       // 0x0106: CP A, 0x90
+			0x20, 0xFA,       // 0x0108: JR NZ, 0x0104
+			0x76,             // 0x010A: HALT
+			0x18, 0xF7,       // 0x010B: JR 0x0104
+		});
+		auto& device = fixture.GetDevice();
+		device.SetSchedulerEnabled(true);
+		device.GetPPU().SetScanlineRendererEnabled(true);
+
+		BENCHMARK("Device::Tick idle frame")
+		{
+			for (size_t i = 0; i < PPU::FrameCycles / 4; ++i)
+			{
+				device.Tick();
+			}
+			return device.GetPPU().GetLY();
+		};
+
+		BENCHMARK("Device::Run idle frame")
+		{
+			device.Run(PPU::FrameCycles / 4);
+			return device.GetPPU().GetLY();
+		};
+	}
+
+	SECTION("Busy")
+	{
+		// Never idle, measures what looking for idle loops costs
+		DeviceFixture fixture;
+		LoadProgram(fixture, {
+			0x21, 0x00, 0xC0, // 0x0100: LD HL, 0xC000
+			0x7E,             // 0x0103: LD A, (HL)
+			0x3C,             // 0x0104: INC A
+			0x22,             // 0x0105: LD (HL+), A
+			0xCB, 0x74,       // 0x0106: BIT 6, H
+			0x28, 0xF9,       // 0x0108: JR Z, 0x0103
+			0x18, 0xF4,       // 0x010A: JR 0x0100
+		});
+		auto& device = fixture.GetDevice();
+
+		BENCHMARK("Device::Tick busy frame")
+		{
+			for (size_t i = 0; i < PPU::FrameCycles / 4; ++i)
+			{
+				device.Tick();
+			}
+			return device.GetPPU().GetLY();
+		};
+
+		BENCHMARK("Device::Run busy frame")
+		{
+			device.Run(PPU::FrameCycles / 4);
+			return device.GetPPU().GetLY();
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <fixture.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/mmu.hpp>
+#include <gameboy/ppu.hpp>
+
+using namespace Amber;
+using namespace Bench;
+
+DeviceFixture::DeviceFixture(bool a_UseBootROM):
+	m_BootROM(0x100),
+	m_VRAM(0x2000),
+	m_WRAM(0x2000),
+	m_Cartridge(0x8000, 0x2000),
+	m_Device(Gameboy::DeviceDescription::DMG)
+{
+	FillRandom(m_BootROM.GetData(), m_BootROM.GetSize(), 1);
+	FillRandom(m_VRAM.GetData(), m_VRAM.GetSize(), 2);
+	FillRandom(m_WRAM.GetData(), m_WRAM.GetSize(), 3);
+	FillRandom(m_Cartridge.GetROM().GetData(), m_Cartridge.GetROM().GetSize(), 4);
+
+	auto& mmu = m_Device.GetMMU();
+	mmu.SetBootROM(a_UseBootROM ? &m_BootROM : nullptr);
+	mmu.SetCartridge(&m_Cartridge);
+	mmu.SetVRAM(&m_VRAM);
+	mmu.SetWRAM(&m_WRAM);
+
+	// Spread all 40 sprites over the screen so the fetcher has to mix them in on most lines
+	auto& ppu = m_Device.GetPPU();
+	uint8_t* oam = ppu.GetOAM();
+	for (uint8_t i = 0; i < 40; ++i)
+	{
+		oam[i * 4 + 0] = static_cast<uint8_t>(16 + i * 4);
+		oam[i * 4 + 1] = static_cast<uint8_t>(8 + (i * 37) % 160);
+		oam[i * 4 + 2] = static_cast<uint8_t>(i);
+		oam[i * 4 + 3] = static_cast<uint8_t>((i & 0b11) << 5);
+	}
+
+	// Background and sprites enabled
+	ppu.SetLCDC(0x93);
+	ppu.SetBGP(0xE4);
+	ppu.SetOBP0(0xE4);
+	ppu.SetOBP1(0x1B);
+}
+
+Gameboy::Device& DeviceFixture::GetDevice() noexcept
+{
+	return m_Device;
+}
+
+Gameboy::BasicCartridge& DeviceFixture::GetCartridge() noexcept
+{
+	return m_Cartridge;
+}
+
+Common::RAM16<false>& DeviceFixture::GetVRAM() noexcept
+{
+	return m_VRAM;
+}
+
+Common::RAM16<false>& DeviceFixture::GetWRAM() noexcept
+{
+	return m_WRAM;
+}
+
+void Bench::FillRandom(void* a_Data, size_t a_Size, uint32_t a_Seed)
+{
+	// Simple LCG, the quality of the randomness is irrelevant but it has to be stable across platforms
+	uint32_t state = a_Seed;
+	uint8_t* data = static_cast<uint8_t*>(a_Data);
+	for (size_t i = 0; i < a_Size; ++i)
+	{
+		state = state * 1664525 + 1013904223;
+		data[i] = static_cast<uint8_t>(state >> 24);
+	}
+}
\ No newline at end of file
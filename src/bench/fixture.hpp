@@ -0,0 +1,35 @@
+#ifndef H_AMBER_BENCH_FIXTURE
+#define H_AMBER_BENCH_FIXTURE
+
+#include <gameboy/basiccartridge.hpp>
+#include <gameboy/device.hpp>
+
+#include <common/ram.hpp>
+
+namespace Amber::Bench
+{
+	// A fully wired DMG with a 32 kb ROM-only cartridge and 8 kb of cartridge RAM. The boot ROM, VRAM, WRAM and
+	// cartridge ROM hold deterministic pseudo-random bytes and OAM spreads all 40 sprites over the screen, so every
+	// benchmark starts from the same state.
+	class DeviceFixture
+	{
+		public:
+		explicit DeviceFixture(bool a_UseBootROM = false);
+
+		Gameboy::Device& GetDevice() noexcept;
+		Gameboy::BasicCartridge& GetCartridge() noexcept;
+		Common::RAM16<false>& GetVRAM() noexcept;
+		Common::RAM16<false>& GetWRAM() noexcept;
+
+		private:
+		Common::RAM16<false> m_BootROM;
+		Common::RAM16<false> m_VRAM;
+		Common::RAM16<false> m_WRAM;
+		Gameboy::BasicCartridge m_Cartridge;
+		Gameboy::Device m_Device;
+	};
+
+	void FillRandom(void* a_Data, size_t a_Size, uint32_t a_Seed);
+}
+
+#endif
\ No newline at end of file
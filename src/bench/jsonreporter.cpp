@@ -0,0 +1,100 @@
+#include <jsonreporter.hpp>
+
+#include <iomanip>
+#include <ostream>
+
+using namespace Amber;
+using namespace Bench;
+
+CATCH_REGISTER_REPORTER("json", JsonReporter)
+
+namespace
+{
+	void WriteString(std::ostream& a_Stream, const std::string& a_String)
+	{
+		a_Stream << '"';
+		for (const char c : a_String)
+		{
+			switch (c)
+			{
+				case '"':  a_Stream << "\\\""; break;
+				case '\\': a_Stream << "\\\\"; break;
+				case '\n': a_Stream << "\\n"; break;
+				case '\r': a_Stream << "\\r"; break;
+				case '\t': a_Stream << "\\t"; break;
+
+				default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					a_Stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+				}
+				else
+				{
+					a_Stream << c;
+				}
+				break;
+			}
+		}
+		a_Stream << '"';
+	}
+}
+
+std::string JsonReporter::getDescription()
+{
+	return "Reports benchmark results as JSON";
+}
+
+void JsonReporter::assertionStarting(const Catch::AssertionInfo& a_Info)
+{
+}
+
+bool JsonReporter::assertionEnded(const Catch::AssertionStats& a_Stats)
+{
+	return true;
+}
+
+void JsonReporter::benchmarkEnded(const Catch::BenchmarkStats<>& a_Stats)
+{
+	Result result;
+	result.m_TestCase = currentTestCaseInfo->name;
+	result.m_Name = a_Stats.info.name;
+	result.m_Samples = a_Stats.info.samples;
+	result.m_Iterations = a_Stats.info.iterations;
+	result.m_Mean = a_Stats.mean.point.count();
+	result.m_MeanLower = a_Stats.mean.lower_bound.count();
+	result.m_MeanUpper = a_Stats.mean.upper_bound.count();
+	result.m_StandardDeviation = a_Stats.standardDeviation.point.count();
+	result.m_OutlierVariance = a_Stats.outlierVariance;
+
+	m_Results.emplace_back(std::move(result));
+}
+
+void JsonReporter::testRunEnded(const Catch::TestRunStats& a_Stats)
+{
+	stream << "{\n";
+	stream << "\t\"unit\": \"ns\",\n";
+	stream << "\t\"benchmarks\": [";
+
+	for (size_t i = 0; i < m_Results.size(); ++i)
+	{
+		const auto& result = m_Results[i];
+
+		stream << (i == 0 ? "\n" : ",\n");
+		stream << "\t\t{\n";
+		stream << "\t\t\t\"test_case\": "; WriteString(stream, result.m_TestCase); stream << ",\n";
+		stream << "\t\t\t\"name\": "; WriteString(stream, result.m_Name); stream << ",\n";
+		stream << "\t\t\t\"samples\": " << result.m_Samples << ",\n";
+		stream << "\t\t\t\"iterations\": " << result.m_Iterations << ",\n";
+		stream << "\t\t\t\"mean\": " << result.m_Mean << ",\n";
+		stream << "\t\t\t\"mean_lower_bound\": " << result.m_MeanLower << ",\n";
+		stream << "\t\t\t\"mean_upper_bound\": " << result.m_MeanUpper << ",\n";
+		stream << "\t\t\t\"standard_deviation\": " << result.m_StandardDeviation << ",\n";
+		stream << "\t\t\t\"outlier_variance\": " << result.m_OutlierVariance << "\n";
+		stream << "\t\t}";
+	}
+
+	stream << "\n\t]\n";
+	stream << "}" << std::endl;
+
+	StreamingReporterBase::testRunEnded(a_Stats);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef H_AMBER_BENCH_JSONREPORTER
+#define H_AMBER_BENCH_JSONREPORTER
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Amber::Bench
+{
+	// Collects every benchmark result of a run and writes them out as a single JSON document,
+	// so results can be compared across commits.
+	class JsonReporter : public Catch::StreamingReporterBase<JsonReporter>
+	{
+		public:
+		using StreamingReporterBase::StreamingReporterBase;
+
+		static std::string getDescription();
+
+		void assertionStarting(const Catch::AssertionInfo& a_Info) override;
+		bool assertionEnded(const Catch::AssertionStats& a_Stats) override;
+
+		void benchmarkEnded(const Catch::BenchmarkStats<>& a_Stats) override;
+		void testRunEnded(const Catch::TestRunStats& a_Stats) override;
+
+		private:
+		struct Result
+		{
+			std::string m_TestCase;
+			std::string m_Name;
+			int m_Samples;
+			int m_Iterations;
+			double m_Mean;
+			double m_MeanLower;
+			double m_MeanUpper;
+			double m_StandardDeviation;
+			double m_OutlierVariance;
+		};
+
+		std::vector<Result> m_Results;
+	};
+}
+
+#endif
\ No newline at end of file
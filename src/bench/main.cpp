@@ -0,0 +1,8 @@
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch.hpp>
+
+// Usage: bench_amber -r json -o results.json
+int main(int argc, char* argv[])
+{
+	return Catch::Session().run(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/mmu.hpp>
+
+#include <string>
+
+using namespace Amber;
+using namespace Bench;
+using namespace Gameboy;
+
+#define BENCH_TAGS "[mmu]"
+
+namespace
+{
+	struct PageHandler
+	{
+		const char* m_Name;
+		uint16_t m_Address;
+	};
+
+	// One address per distinct MMU load/store handler
+	constexpr PageHandler g_PageHandlers[] =
+	{
+		{"boot ROM",      0x0000},
+		{"cartridge ROM", 0x4000},
+		{"VRAM",          0x8000},
+		{"cartridge RAM", 0xA000},
+		{"WRAM",          0xC000},
+		{"echo RAM",      0xE000},
+		{"OAM",           0xFE00},
+		{"unusable",      0xFEA0},
+		{"joypad",        0xFF00},
+		{"timer",         0xFF05},
+		{"PPU register",  0xFF42},
+		{"HRAM",          0xFF80},
+		{"IE",            0xFFFF},
+	};
+}
+
+TEST_CASE("MMU::Load8", BENCH_TAGS)
+{
+	DeviceFixture fixture(true);
+	auto& mmu = fixture.GetDevice().GetMMU();
+
+	for (const auto& handler : g_PageHandlers)
+	{
+		const uint16_t address = handler.m_Address;
+
+		BENCHMARK(std::string("MMU::Load8 ") + handler.m_Name)
+		{
+			return mmu.Load8(address);
+		};
+	}
+}
+
+TEST_CASE("MMU::Load16", BENCH_TAGS)
+{
+	DeviceFixture fixture(true);
+	auto& mmu = fixture.GetDevice().GetMMU();
+
+	for (const auto& handler : g_PageHandlers)
+	{
+		const uint16_t address = handler.m_Address;
+
+		BENCHMARK(std::string("MMU::Load16 ") + handler.m_Name)
+		{
+			return mmu.Load16(address);
+		};
+	}
+}
+
+TEST_CASE("MMU::Store8", BENCH_TAGS)
+{
+	DeviceFixture fixture(true);
+	auto& mmu = fixture.GetDevice().GetMMU();
+
+	for (const auto& handler : g_PageHandlers)
+	{
+		const uint16_t address = handler.m_Address;
+		uint8_t value = 0;
+
+		BENCHMARK(std::string("MMU::Store8 ") + handler.m_Name)
+		{
+			mmu.Store8(address, value++);
+		};
+	}
+}
\ No newline at end of file
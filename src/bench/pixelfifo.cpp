@@ -0,0 +1,45 @@
+#include <catch2/catch.hpp>
+
+#include <gameboy/pixelfifo.hpp>
+
+using namespace Amber;
+using namespace Gameboy;
+
+#define BENCH_TAGS "[pixelfifo]"
+
+TEST_CASE("PixelFIFO", BENCH_TAGS)
+{
+	const uint8_t colors[2] = { 0b1010'0101, 0b1100'0011 };
+	const uint8_t sprite_colors[2] = { 0b0111'1110, 0b0011'1100 };
+
+	PixelFIFO fifo;
+
+	BENCHMARK("PixelFIFO::Push")
+	{
+		fifo.Reset(0);
+		fifo.Push(colors, PixelSource::Background);
+		return fifo.GetPixelCount();
+	};
+
+	BENCHMARK("PixelFIFO::Pop")
+	{
+		fifo.Reset(0);
+		fifo.Push(colors, PixelSource::Background);
+
+		uint8_t result = 0;
+		for (size_t i = 0; i < 8; ++i)
+		{
+			result ^= fifo.Pop().GetData();
+		}
+		return result;
+	};
+
+	BENCHMARK("PixelFIFO::MixSprite")
+	{
+		fifo.Reset(0);
+		fifo.Push(colors, PixelSource::Background);
+		fifo.MixSprite(sprite_colors, PixelFIFO::XFlipAttributeMask);
+		fifo.MixSprite(colors, PixelFIFO::PriorityAttributeMask | PixelFIFO::PaletteAttributeMask);
+		return fifo.GetPixel(0).GetData();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/ppu.hpp>
+
+#include <memory>
+
+using namespace Amber;
+using namespace Bench;
+using namespace Gameboy;
+
+#define BENCH_TAGS "[ppu]"
+
+TEST_CASE("PPU::Tick", BENCH_TAGS)
+{
+	DeviceFixture fixture;
+	auto& ppu = fixture.GetDevice().GetPPU();
+
+	BENCHMARK("PPU::Tick scanline")
+	{
+		for (size_t i = 0; i < PPU::LineCycles; ++i)
+		{
+			ppu.Tick();
+		}
+		return ppu.GetLY();
+	};
+
+	BENCHMARK("PPU::Tick frame")
+	{
+		for (size_t i = 0; i < PPU::FrameCycles; ++i)
+		{
+			ppu.Tick();
+		}
+		return ppu.GetLY();
+	};
+}
+
+TEST_CASE("PPU::Blit", BENCH_TAGS)
+{
+	DeviceFixture fixture;
+	auto& ppu = fixture.GetDevice().GetPPU();
+
+	// Render a frame so the LCD buffer holds a realistic image
+	for (size_t i = 0; i < PPU::FrameCycles; ++i)
+	{
+		ppu.Tick();
+	}
+
+	const auto buffer = std::make_unique<uint8_t[]>(PPU::LCDWidth * PPU::LCDHeight * 4 * 16);
+
+	BENCHMARK("PPU::Blit RGBA")
+	{
+		ppu.Blit(buffer.get(), PPU::LCDWidth);
+		return buffer[0];
+	};
+
+	BENCHMARK("PPU::Blit RGB565")
+	{
+		ppu.Blit(buffer.get(), PPU::LCDWidth, PixelFormat::RGB565);
+		return buffer[0];
+	};
+
+	BENCHMARK("PPU::Blit indexed")
+	{
+		ppu.Blit(buffer.get(), PPU::LCDWidth, PixelFormat::Indexed8);
+		return buffer[0];
+	};
+
+	BENCHMARK("PPU::Blit RGBA 3x")
+	{
+		ppu.Blit(buffer.get(), PPU::LCDWidth * 3, PixelFormat::RGBA8888, 3);
+		return buffer[0];
+	};
+
+	BENCHMARK("PPU::Blit RGBA 4x")
+	{
+		ppu.Blit(buffer.get(), PPU::LCDWidth * 4, PixelFormat::RGBA8888, 4);
+		return buffer[0];
+	};
+}
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/devicereplayer.hpp>
+#include <gameboy/joypad.hpp>
+
+#include <common/recorder.hpp>
+
+#include <cstring>
+#include <memory>
+
+using namespace Amber;
+using namespace Bench;
+using namespace Common;
+
+#define BENCH_TAGS "[recorder]"
+
+namespace
+{
+	struct ChannelLayout
+	{
+		const char* m_Name;
+		size_t m_Size;
+	};
+
+	// Roughly the state a DMG would record per frame
+	constexpr ChannelLayout g_Channels[] =
+	{
+		{"CPU",  0x0020},
+		{"PPU",  0x0020},
+		{"OAM",  0x00A0},
+		{"HRAM", 0x007F},
+		{"VRAM", 0x2000},
+		{"WRAM", 0x2000},
+	};
+
+	constexpr size_t ChannelCount = sizeof(g_Channels) / sizeof(g_Channels[0]);
+
+	RecorderDescription CreateDescription()
+	{
+		RecorderDescription description;
+		for (const auto& channel : g_Channels)
+		{
+			RecorderMemberDescription member_description;
+			member_description.SetName("Data");
+			member_description.SetType(RecorderMemberType::Raw);
+			member_description.SetSize(channel.m_Size);
+
+			RecorderChannelDescription channel_description;
+			channel_description.SetName(channel.m_Name);
+			channel_description.AddMember(member_description);
+			description.AddChannel(channel_description);
+		}
+
+		// Keep blocks small, the default is far larger than a benchmark needs
+		description.SetBlockSize(16 * 1024 * 1024);
+
+		return description;
+	}
+
+	std::unique_ptr<uint8_t[]> CreateChannelData(size_t a_Channel, uint32_t a_Seed)
+	{
+		auto data = std::make_unique<uint8_t[]>(g_Channels[a_Channel].m_Size);
+		FillRandom(data.get(), g_Channels[a_Channel].m_Size, a_Seed);
+		return data;
+	}
+
+	// Stands in for re-emulating a frame, so the benchmark only measures the recorder's own share of a seek
+	class NullReplayer : public RecorderReplayer
+	{
+		public:
+		void ReplayFrame(Recorder& a_Recorder, size_t a_Frame) override
+		{
+			a_Recorder.WriteChannelData(0, a_Recorder.ReadChannelData(0));
+		}
+	};
+
+	// Stores the directions held at every VBlank to WRAM, so every frame depends on the input
+	void WriteJoypadProgram(DeviceFixture& a_Fixture)
+	{
+		const uint8_t handler[] =
+		{
+			0x1C, // INC E
+			0xD9, // RETI
+		};
+		const uint8_t program[] =
+		{
+			0x3E, 0x01,       // 0x0100: LD A, 0x01
+			0xEA, 0xFF, 0xFF, // 0x0102: LD (0xFFFF), A
+			0x21, 0x00, 0xC0, // 0x0105: LD HL, 0xC000
+			0xFB,             // 0x0108: EI
+			0x76,             // 0x0109: HALT
+			0x3E, 0x20,       // 0x010A: LD A, 0x20
+			0xE0, 0x00,       // 0x010C: LDH (0x00), A
+			0xF0, 0x00,       // 0x010E: LDH A, (0x00)
+			0x22,             // 0x0110: LD (HL+), A
+			0x18, 0xF6,       // 0x0111: JR 0x0109
+		};
+
+		uint8_t* const rom = a_Fixture.GetCartridge().GetROM().GetData();
+		std::memcpy(rom + 0x0040, handler, sizeof(handler));
+		std::memcpy(rom + 0x0100, program, sizeof(program));
+
+		auto& cpu = a_Fixture.GetDevice().GetCPU();
+		cpu.StoreRegister16(Gameboy::CPU::RegisterSP, 0xFFFE);
+		cpu.StoreRegister16(Gameboy::CPU::RegisterPC, 0x0100);
+	}
+
+	// Twenty seconds of a device running the joypad program, holding a different direction every ten frames
+	void RecordDeviceSession(DeviceFixture& a_Fixture, Gameboy::DeviceReplayer& a_Replayer, Recorder& a_Recorder)
+	{
+		static constexpr size_t FrameCount = 1200;
+
+		auto& device = a_Fixture.GetDevice();
+		auto& joypad = device.GetJoypad();
+		for (size_t frame = 0; frame < FrameCount; ++frame)
+		{
+			if (frame % 10 == 0)
+			{
+				joypad.SetButtonState(0b1111, false);
+				joypad.SetButtonState(static_cast<uint8_t>(1 << ((frame / 10) % 4)), true);
+			}
+
+			a_Replayer.RunFrame();
+			a_Recorder.NewFrame();
+			device.Record(a_Recorder);
+		}
+	}
+
+	// An hour and a half of frames, each touching a few bytes of most channels
+	void RecordLongSession(Recorder& a_Recorder, std::unique_ptr<uint8_t[]> (&a_ChannelData)[ChannelCount])
+	{
+		static constexpr size_t FrameCount = 100000;
+
+		for (size_t frame = 0; frame < FrameCount; ++frame)
+		{
+			a_Recorder.NewFrame();
+			for (size_t i = 0; i < ChannelCount; ++i)
+			{
+				a_ChannelData[i][(frame * 13) % g_Channels[i].m_Size] = static_cast<uint8_t>(frame);
+				a_Recorder.WriteChannelData(i, a_ChannelData[i].get());
+			}
+		}
+	}
+}
+
+TEST_CASE("Recorder", BENCH_TAGS)
+{
+	const RecorderDescription description = CreateDescription();
+
+	std::unique_ptr<uint8_t[]> channel_data[ChannelCount];
+	for (size_t i = 0; i < ChannelCount; ++i)
+	{
+		channel_data[i] = CreateChannelData(i, static_cast<uint32_t>(i + 1));
+	}
+
+	BENCHMARK_ADVANCED("Recorder::NewFrame")(Catch::Benchmark::Chronometer a_Meter)
+	{
+		Recorder recorder(description);
+
+		a_Meter.measure([&](int a_Run)
+		{
+			// Only touch part of the state, like a typical frame would
+			channel_data[0][0] = static_cast<uint8_t>(a_Run);
+			recorder.WriteChannelData(0, channel_data[0].get());
+			recorder.WriteChannelData(4, channel_data[4].get());
+			return recorder.NewFrame();
+		});
+	};
+
+	BENCHMARK_ADVANCED("Recorder::SetCurrentFrame")(Catch::Benchmark::Chronometer a_Meter)
+	{
+		static constexpr size_t FrameCount = 64;
+
+		Recorder recorder(description);
+		for (size_t frame = 0; frame < FrameCount; ++frame)
+		{
+			for (size_t i = 0; i < ChannelCount; ++i)
+			{
+				channel_data[i][0] = static_cast<uint8_t>(frame);
+				recorder.WriteChannelData(i, channel_data[i].get());
+			}
+			recorder.NewFrame();
+		}
+
+		a_Meter.measure([&](int a_Run)
+		{
+			// Alternate between distant frames so every call actually restores a frame
+			recorder.SetCurrentFrame((a_Run * 37) % FrameCount);
+			return recorder.GetCurrentFrame();
+		});
+	};
+}
+
+TEST_CASE("Recorder long session", BENCH_TAGS)
+{
+	std::unique_ptr<uint8_t[]> channel_data[ChannelCount];
+	for (size_t i = 0; i < ChannelCount; ++i)
+	{
+		channel_data[i] = CreateChannelData(i, static_cast<uint32_t>(i + 1));
+	}
+
+	BENCHMARK_ADVANCED("Recorder::SetCurrentFrame 100k frames random")(Catch::Benchmark::Chronometer a_Meter)
+	{
+		Recorder recorder(CreateDescription());
+		RecordLongSession(recorder, channel_data);
+
+		a_Meter.measure([&](int a_Run)
+		{
+			recorder.SetCurrentFrame((static_cast<size_t>(a_Run) * 7919) % recorder.GetFrameCount());
+			return recorder.GetCurrentFrame();
+		});
+	};
+
+	BENCHMARK_ADVANCED("Recorder::SetCurrentFrame 100k frames scrub")(Catch::Benchmark::Chronometer a_Meter)
+	{
+		Recorder recorder(CreateDescription());
+		RecordLongSession(recorder, channel_data);
+
+		// A slider being dragged backwards a few frames per UI frame
+		a_Meter.measure([&](int a_Run)
+		{
+			recorder.SetCurrentFrame(recorder.GetFrameCount() - 1 - (static_cast<size_t>(a_Run) * 3) % recorder.GetFrameCount());
+			return recorder.GetCurrentFrame();
+		});
+	};
+
+	BENCHMARK_ADVANCED("Recorder::SetCurrentFrame 100k frames journaled")(Catch::Benchmark::Chronometer a_Meter)
+	{
+		// Only the CPU channel is journaled (standing in for the inputs), everything else is stored at keyframes
+		RecorderDescription description;
+		const RecorderDescription layout = CreateDescription();
+		for (size_t i = 0; i < layout.GetChannelCount(); ++i)
+		{
+			RecorderChannelDescription channel_description = layout.GetChannel(i);
+			channel_description.SetJournaled(i == 0);
+			description.AddChannel(channel_description);
+		}
+		description.SetBlockSize(layout.GetBlockSize());
+
+		NullReplayer replayer;
+		Recorder recorder(description);
+		recorder.SetReplayer(&replayer);
+		RecordLongSession(recorder, channel_data);
+
+		a_Meter.measure([&](int a_Run)
+		{
+			recorder.SetCurrentFrame((static_cast<size_t>(a_Run) * 7919) % recorder.GetFrameCount());
+			return recorder.GetCurrentFrame();
+		});
+	};
+}
+
+TEST_CASE("Recorder device session", BENCH_TAGS)
+{
+	// A keyframe every second either way, the journaled recorder only stores the input in between and re-runs the
+	// device on seek instead
+	static constexpr size_t KeyframeInterval = 60;
+
+	DeviceFixture stored_fixture;
+	WriteJoypadProgram(stored_fixture);
+	auto& stored_device = stored_fixture.GetDevice();
+	Gameboy::DeviceReplayer stored_runner(stored_device);
+
+	RecorderDescription stored_description;
+	stored_device.AddRecorderChannels(stored_description);
+	stored_description.SetKeyframeInterval(KeyframeInterval);
+	stored_description.SetBlockSize(16 * 1024 * 1024);
+
+	Recorder stored(stored_description);
+	RecordDeviceSession(stored_fixture, stored_runner, stored);
+
+	DeviceFixture journaled_fixture;
+	WriteJoypadProgram(journaled_fixture);
+	auto& journaled_device = journaled_fixture.GetDevice();
+	Gameboy::DeviceReplayer replayer(journaled_device);
+
+	RecorderDescription journaled_description;
+	journaled_device.AddRecorderChannels(journaled_description, true);
+	journaled_description.SetKeyframeInterval(KeyframeInterval);
+	journaled_description.SetBlockSize(16 * 1024 * 1024);
+
+	Recorder journaled(journaled_description);
+	journaled.SetReplayer(&replayer);
+	RecordDeviceSession(journaled_fixture, replayer, journaled);
+
+	// A seek through the journal can take longer than a sample, so the frames to seek to carry on across samples
+	size_t seek = 0;
+
+	BENCHMARK_ADVANCED("Recorder::SetCurrentFrame device, every frame stored")(Catch::Benchmark::Chronometer a_Meter)
+	{
+		a_Meter.measure([&]
+		{
+			stored.SetCurrentFrame((++seek * 7919) % stored.GetFrameCount());
+			stored_device.Restore(stored);
+			return stored.GetCurrentFrame();
+		});
+	};
+
+	BENCHMARK_ADVANCED("Recorder::SetCurrentFrame device, input journaled")(Catch::Benchmark::Chronometer a_Meter)
+	{
+		a_Meter.measure([&]
+		{
+			journaled.SetCurrentFrame((++seek * 7919) % journaled.GetFrameCount());
+			journaled_device.Restore(journaled);
+			return journaled.GetCurrentFrame();
+		});
+	};
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/device.hpp>
+
+#include <vector>
+
+using namespace Amber;
+using namespace Bench;
+using namespace Gameboy;
+
+#define BENCH_TAGS "[savestate]"
+
+TEST_CASE("Device::SaveState", BENCH_TAGS)
+{
+	DeviceFixture fixture;
+	auto& device = fixture.GetDevice();
+
+	std::vector<uint8_t> state;
+	device.SaveState(state);
+
+	BENCHMARK("Device::SaveState")
+	{
+		device.SaveState(state);
+		return state.size();
+	};
+
+	BENCHMARK("Device::LoadState")
+	{
+		device.LoadState(state.data(), state.size());
+		return state.size();
+	};
+}
+
+TEST_CASE("Device::Fork", BENCH_TAGS)
+{
+	DeviceFixture fixture;
+	auto base = fixture.GetDevice().Fork();
+
+	BENCHMARK("Device::Fork")
+	{
+		return base->Fork();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include <gameboy/cartridgeloader.hpp>
+#include <gameboy/cpu.hpp>
+#include <gameboy/device.hpp>
+#include <gameboy/mmu.hpp>
+#include <gameboy/ppu.hpp>
+#include <gameboy/ppuobserver.hpp>
+
+#include <common/ram.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace Amber;
+using namespace Gameboy;
+
+namespace
+{
+	// Every Device::Tick advances the machine by a single M-cycle
+	constexpr uint64_t ClockFrequency = 4194304;
+	constexpr uint64_t TicksPerMCycle = 4;
+
+	struct Options
+	{
+		std::string m_ROMPath;
+		std::string m_BootROMPath;
+		uint64_t m_Frames = 600;
+		std::optional<uint64_t> m_Cycles;
+		bool m_BlockCache = false;
+		bool m_JIT = false;
+		bool m_Turbo = false;
+		bool m_Scanline = false;
+	};
+
+	class FrameCounter : public PPUObserver
+	{
+		public:
+		void OnLCDModeChange(LCDMode::Enum a_From, LCDMode::Enum a_To) override
+		{
+			if (a_To == LCDMode::VBlank)
+			{
+				++m_Frames;
+			}
+		}
+
+		uint64_t GetFrames() const noexcept
+		{
+			return m_Frames;
+		}
+
+		private:
+		uint64_t m_Frames = 0;
+	};
+
+	void PrintUsage(const char* a_Executable)
+	{
+		std::cerr << "Usage: " << a_Executable << " <rom> [--boot <bootrom>] [--frames <count> | --cycles <count>] [--cached | --jit] [--turbo] [--scanline]" << std::endl;
+		std::cerr << "  --boot <bootrom>  Run the given boot ROM instead of starting at the cartridge entry point" << std::endl;
+		std::cerr << "  --frames <count>  Run until <count> frames have been completed (default: 600)" << std::endl;
+		std::cerr << "  --cycles <count>  Run for <count> M-cycles" << std::endl;
+		std::cerr << "  --cached          Run the CPU from pre-decoded blocks" << std::endl;
+		std::cerr << "  --jit             Compile hot blocks to native code where supported" << std::endl;
+		std::cerr << "  --turbo           Catch the PPU up on demand instead of ticking it in lock-step" << std::endl;
+		std::cerr << "  --scanline        Draw whole lines at once, using the pixel FIFO only for lines written mid-line" << std::endl;
+	}
+
+	bool ParseCount(const char* a_Text, uint64_t& a_Count)
+	{
+		char* end = nullptr;
+		a_Count = std::strtoull(a_Text, &end, 10);
+		return end != a_Text && *end == '\0';
+	}
+
+	std::optional<Options> ParseOptions(int a_ArgumentCount, char** a_Arguments)
+	{
+		Options options;
+
+		for (int i = 1; i < a_ArgumentCount; ++i)
+		{
+			const std::string_view argument = a_Arguments[i];
+			const bool has_value = i + 1 < a_ArgumentCount;
+
+			if (argument == "--boot" && has_value)
+			{
+				options.m_BootROMPath = a_Arguments[++i];
+			}
+			else if (argument == "--frames" && has_value)
+			{
+				if (!ParseCount(a_Arguments[++i], options.m_Frames))
+				{
+					return std::nullopt;
+				}
+			}
+			else if (argument == "--cycles" && has_value)
+			{
+				uint64_t cycles = 0;
+				if (!ParseCount(a_Arguments[++i], cycles))
+				{
+					return std::nullopt;
+				}
+				options.m_Cycles = cycles;
+			}
+			else if (argument == "--cached")
+			{
+				options.m_BlockCache = true;
+			}
+			else if (argument == "--jit")
+			{
+				options.m_JIT = true;
+			}
+			else if (argument == "--turbo")
+			{
+				options.m_Turbo = true;
+			}
+			else if (argument == "--scanline")
+			{
+				options.m_Scanline = true;
+			}
+			else if (!argument.empty() && argument[0] != '-' && options.m_ROMPath.empty())
+			{
+				options.m_ROMPath = argument;
+			}
+			else
+			{
+				return std::nullopt;
+			}
+		}
+
+		if (options.m_ROMPath.empty())
+		{
+			return std::nullopt;
+		}
+
+		return options;
+	}
+
+	// Register state as left behind by the DMG boot ROM
+	void SkipBootROM(CPU& a_CPU)
+	{
+		a_CPU.StoreRegister16(CPU::RegisterAF, 0x01B0);
+		a_CPU.StoreRegister16(CPU::RegisterBC, 0x0013);
+		a_CPU.StoreRegister16(CPU::RegisterDE, 0x00D8);
+		a_CPU.StoreRegister16(CPU::RegisterHL, 0x014D);
+		a_CPU.StoreRegister16(CPU::RegisterSP, 0xFFFE);
+		a_CPU.StoreRegister16(CPU::RegisterPC, 0x0100);
+	}
+}
+
+int main(int a_ArgumentCount, char** a_Arguments)
+{
+	const auto options = ParseOptions(a_ArgumentCount, a_Arguments);
+	if (!options)
+	{
+		PrintUsage(a_Arguments[0]);
+		return EXIT_FAILURE;
+	}
+
+	// Load cartridge
+	std::ifstream cartridge_file(options->m_ROMPath, std::ios::binary | std::ios::ate);
+	if (!cartridge_file)
+	{
+		std::cerr << "Error: could not open " << options->m_ROMPath << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	CartridgeLoader loader;
+	const auto cartridge = loader.LoadCartridge(cartridge_file);
+	if (cartridge == nullptr)
+	{
+		std::cerr << "Error: unsupported cartridge type in " << options->m_ROMPath << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// Load boot ROM
+	std::unique_ptr<Common::RAM<uint16_t, false>> bootrom;
+	if (!options->m_BootROMPath.empty())
+	{
+		std::ifstream boot_file(options->m_BootROMPath, std::ios::binary);
+		if (!boot_file)
+		{
+			std::cerr << "Error: could not open " << options->m_BootROMPath << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		bootrom = std::make_unique<Common::RAM<uint16_t, false>>(0x100);
+		boot_file.read(reinterpret_cast<char*>(bootrom->GetData()), bootrom->GetSize());
+	}
+
+	// Initialize device
+	Common::RAM<uint16_t, false> vram(0x2000);
+	Common::RAM<uint16_t, false> wram(0x2000);
+
+	Device device(DeviceDescription::DMG);
+
+	auto& mmu = device.GetMMU();
+	mmu.SetBootROM(bootrom.get());
+	mmu.SetCartridge(cartridge.get());
+	mmu.SetVRAM(&vram);
+	mmu.SetWRAM(&wram);
+
+	if (bootrom == nullptr)
+	{
+		SkipBootROM(device.GetCPU());
+	}
+
+	device.GetCPU().SetBlockCacheEnabled(options->m_BlockCache);
+	device.GetCPU().SetJITEnabled(options->m_JIT);
+	if (options->m_JIT && !device.GetCPU().IsJITEnabled())
+	{
+		std::cerr << "Warning: JIT is not supported on this platform, using the interpreter" << std::endl;
+	}
+
+	device.SetSchedulerEnabled(options->m_Turbo);
+	device.GetPPU().SetScanlineRendererEnabled(options->m_Scanline);
+
+	FrameCounter frame_counter;
+	device.GetPPU().AddObserver(frame_counter);
+
+	std::cout << "Running " << cartridge->GetHeader().GetTitle() << std::endl;
+
+	// Run
+	uint64_t cycles = 0;
+	const auto start = std::chrono::steady_clock::now();
+
+	if (options->m_Cycles)
+	{
+		cycles = *options->m_Cycles;
+		device.Run(cycles);
+	}
+	else
+	{
+		// A ROM that turns the LCD off or never reaches VBlank doesn't complete frames, give up after four times the
+		// cycles the frames should take
+		const uint64_t frame_count = options->m_Frames;
+		const uint64_t max_cycles = frame_count * PPU::FrameCycles;
+		while (frame_counter.GetFrames() < frame_count && cycles < max_cycles)
+		{
+			// A frame always takes the same number of cycles, so running all but the last one can't overshoot
+			const uint64_t frames_left = frame_count - frame_counter.GetFrames();
+			if (frames_left > 1)
+			{
+				const uint64_t run_cycles = std::min<uint64_t>((frames_left - 1) * (PPU::FrameCycles / 4), max_cycles - cycles);
+				device.Run(run_cycles);
+				cycles += run_cycles;
+			}
+			else
+			{
+				device.Tick();
+				++cycles;
+			}
+		}
+
+		if (frame_counter.GetFrames() < frame_count)
+		{
+			std::cerr << "Warning: only " << frame_counter.GetFrames() << " of " << frame_count << " frames completed in " << cycles << " M-cycles, stopped early" << std::endl;
+		}
+	}
+
+	device.Synchronize();
+	const auto end = std::chrono::steady_clock::now();
+	device.GetPPU().RemoveObserver(frame_counter);
+
+	// Report
+	const double seconds = std::chrono::duration<double>(end - start).count();
+	const uint64_t frames = frame_counter.GetFrames();
+	const double cycles_per_second = seconds > 0.0 ? cycles / seconds : 0.0;
+	const double frames_per_second = seconds > 0.0 ? frames / seconds : 0.0;
+	const double speed = cycles_per_second * TicksPerMCycle / ClockFrequency;
+
+	std::cout << "Frames:   " << frames << std::endl;
+	std::cout << "M-cycles: " << cycles << " (" << cycles * TicksPerMCycle << " T-cycles)" << std::endl;
+	std::cout << "Time:     " << seconds << " s" << std::endl;
+	std::cout << "Cycles/s: " << cycles_per_second << std::endl;
+	std::cout << "FPS:      " << frames_per_second << std::endl;
+	std::cout << "Speed:    " << speed << "x realtime" << std::endl;
+
+	return EXIT_SUCCESS;
+}
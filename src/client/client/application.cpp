@@ -2,6 +2,7 @@
 
 #include <client/breakpoints.hpp>
 #include <client/disassembly.hpp>
+#include <client/emulationthread.hpp>
 #include <client/gameboywidgets.hpp>
 #include <client/texture.hpp>
 
@@ -9,6 +10,7 @@
 #include <gameboy/cpu.hpp>
 #include <gameboy/debugger.hpp>
 #include <gameboy/device.hpp>
+#include <gameboy/devicereplayer.hpp>
 #include <gameboy/joypad.hpp>
 #include <gameboy/mmu.hpp>
 #include <gameboy/ppu.hpp>
@@ -21,6 +23,8 @@
 #include <imgui/imgui_internal.h>
 #include <imgui/imgui_memory_editor.h>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -87,7 +91,36 @@ void Application::Tick()
 		return device;
 	}();
 
-	static Gameboy::VideoViewer video_viewer(vram);
+	// Record every component of the device, but between keyframes only the input is stored and seeks re-run the
+	// device from the nearest keyframe, at most a second of emulation
+	static Gameboy::DeviceReplayer replayer(*device);
+	static auto recorder = []
+	{
+		RecorderDescription recorder_description;
+		device->AddRecorderChannels(recorder_description, true);
+		recorder_description.SetKeyframeInterval(60);
+
+		auto recorder = std::make_unique<Recorder>(recorder_description);
+		recorder->SetReplayer(&replayer);
+		return recorder;
+	}();
+
+	// Create debugger and hand the device and recorder over to the emulation thread, from here on they may only be
+	// touched directly while the thread is idle. Any command submitted below keeps it busy, so idleness is checked
+	// again right before each direct access rather than once per tick
+	static Gameboy::Debugger debugger(*device);
+	static EmulationThread emulation(*device, debugger, recorder.get());
+
+	const bool running = emulation.IsRunning();
+	emulation.AcquireSnapshot();
+	const auto& snapshot = emulation.GetSnapshot();
+	const uint16_t pc = snapshot.m_Registers[Gameboy::CPU::RegisterPC];
+
+	// The video viewer works on the snapshot's copy of VRAM, the real one belongs to the emulation thread
+	static Common::RAM<uint16_t, false> vram_snapshot(0x2000);
+	std::memcpy(vram_snapshot.GetData(), snapshot.m_VRAM.data(), snapshot.m_VRAM.size());
+
+	static Gameboy::VideoViewer video_viewer(vram_snapshot);
 
 	static const size_t tile_columns = 16;
 	static const size_t tile_rows = video_viewer.GetTileCount() / tile_columns;
@@ -115,22 +148,14 @@ void Application::Tick()
 	tile_texture.Blit(0, 0, tile_texture_width, tile_texture_height, tile_buffer.get());
 
 	static Texture lcd_texture(Gameboy::PPU::LCDWidth, Gameboy::PPU::LCDHeight);
-	static const size_t lcd_buffer_size = Gameboy::PPU::LCDWidth * Gameboy::PPU::LCDHeight * 4;
-	static const auto lcd_buffer = std::make_unique<uint8_t[]>(lcd_buffer_size);
-
-	device->GetPPU().Blit(lcd_buffer.get(), Gameboy::PPU::LCDWidth);
-	lcd_texture.Blit(0, 0, Gameboy::PPU::LCDWidth, Gameboy::PPU::LCDHeight, lcd_buffer.get());
 
-	static auto recorder = []
+	// Only upload the LCD when the PPU has presented a new frame, the emulation thread already converted it
+	static uint64_t lcd_frame_sequence = 0;
+	if (snapshot.m_FrameSequence != lcd_frame_sequence)
 	{
-		RecorderDescription recorder_description;
-
-		auto recorder = std::make_unique<Recorder>(recorder_description);
-
-		recorder->NewFrame();
-
-		return recorder;
-	}();
+		lcd_texture.Blit(0, 0, Gameboy::PPU::LCDWidth, Gameboy::PPU::LCDHeight, snapshot.m_LCD.data());
+		lcd_frame_sequence = snapshot.m_FrameSequence;
+	}
 
 
 	// Show memory
@@ -181,132 +206,155 @@ void Application::Tick()
 
 		if (ImGui::Button("PC"))
 		{
-			const uint16_t pc = device->GetCPU().LoadRegister16(Gameboy::CPU::RegisterPC);
 			memory_editor.GotoAddrAndHighlight(pc, pc + 1);
 		}
 		ImGui::SameLine();
 		if (ImGui::Button("SP"))
 		{
-			const uint16_t sp = device->GetCPU().LoadRegister16(Gameboy::CPU::RegisterSP);
+			const uint16_t sp = snapshot.m_Registers[Gameboy::CPU::RegisterSP];
 			memory_editor.GotoAddrAndHighlight(sp, sp + 1);
 		}
 
-		memory_editor.DrawContents(&(device->GetMMU()), 0x10000);
+		if (emulation.IsIdle())
+		{
+			memory_editor.HighlightMin = pc;
+			memory_editor.HighlightMax = pc + 1;
+			memory_editor.DrawContents(&(device->GetMMU()), 0x10000);
+		}
+		else
+		{
+			ImGui::TextUnformatted("Break to inspect memory");
+		}
 	}
 	ImGui::End();
 
-	// Create debugger
-	static Gameboy::Debugger debugger(*device);
-
 	//ImGui::ShowDemoWindow();
 
 	// Show debugger
-	static bool running = false;
-	if (running)
-	{
-		running = debugger.Run();
-		memory_editor.HighlightMin = device->GetCPU().LoadRegister16(Gameboy::CPU::RegisterPC);
-		memory_editor.HighlightMax = memory_editor.HighlightMin + 1;
-	}
-
 	if (ImGui::Begin("Debugger"))
 	{
 		if (!running)
 		{
 			if (ImGui::ButtonEx("Run", ImVec2(0, 0), ImGuiButtonFlags_Repeat))
 			{
-				running = true;
+				emulation.Run();
 			}
 		}
 		else
 		{
 			if (ImGui::Button("Break"))
 			{
-				running = false;
+				emulation.Break();
 			}
 		}
 
 		ImGui::SameLine();
 		if (ImGui::ButtonEx("Step", ImVec2(0, 0), ImGuiButtonFlags_Repeat) && !running)
 		{
-			debugger.Step();
-			memory_editor.HighlightMin = device->GetCPU().LoadRegister16(Gameboy::CPU::RegisterPC);
-			memory_editor.HighlightMax = memory_editor.HighlightMin + 1;
+			emulation.Step();
 		}
 
 		ImGui::SameLine();
 		if (ImGui::ButtonEx("Step Frame", ImVec2(0, 0), ImGuiButtonFlags_Repeat) && !running)
 		{
-			debugger.Run();
-			memory_editor.HighlightMin = device->GetCPU().LoadRegister16(Gameboy::CPU::RegisterPC);
-			memory_editor.HighlightMax = memory_editor.HighlightMin + 1;
+			emulation.StepFrame();
 		}
 
 		ImGui::SameLine();
 		if (ImGui::ButtonEx("Microstep", ImVec2(0, 0), ImGuiButtonFlags_Repeat) && !running)
 		{
-			debugger.Microstep();
-
-			memory_editor.HighlightMin = device->GetCPU().LoadRegister16(Gameboy::CPU::RegisterPC);
-			memory_editor.HighlightMax = memory_editor.HighlightMin + 1;
+			emulation.Microstep();
 		}
 
 		ImGui::SameLine();
 		if (ImGui::Button("Reset"))
 		{
-			running = debugger.Reset() && running;
+			emulation.Reset();
+		}
+
+		ImGui::SameLine();
+		if (bool throttle = emulation.IsThrottleEnabled(); ImGui::Checkbox("Throttle", &throttle))
+		{
+			emulation.SetThrottleEnabled(throttle);
 		}
 
 		ImGui::Image(reinterpret_cast<ImTextureID>(lcd_texture.GetNativeHandle()), ImVec2(Gameboy::PPU::LCDWidth * 2, Gameboy::PPU::LCDHeight * 2));
 		ImGui::Image(reinterpret_cast<ImTextureID>(tile_texture.GetNativeHandle()), ImVec2(tile_texture_width * 2, tile_texture_height * 2));
 		ImGui::SameLine();
-		ImGui::Text("LY: %i", static_cast<int>(device->GetPPU().GetLY()));
+		ImGui::Text("LY: %i", static_cast<int>(snapshot.m_LY));
 	}
 	ImGui::End();
 
 	// Show registers
 	ImGui::SetNextWindowDockID(dock_id, ImGuiSetCond_FirstUseEver);
-	DrawRegisterWindow("Registers", device->GetCPU());
+	if (emulation.IsIdle())
+	{
+		DrawRegisterWindow("Registers", device->GetCPU());
+	}
+	else
+	{
+		if (ImGui::Begin("Registers"))
+		{
+			const char* names[] = { "AF", "BC", "DE", "HL", "SP", "PC", "XY", "ZW" };
+			for (uint8_t i = 0; i < snapshot.m_Registers.size(); ++i)
+			{
+				if (i % 2 != 0)
+				{
+					ImGui::SameLine();
+				}
+				ImGui::Text("%s: %04X", names[i], static_cast<unsigned int>(snapshot.m_Registers[i]));
+			}
+		}
+		ImGui::End();
+	}
 
 	// Show joypad
 	if (ImGui::Begin("Joypad"))
 	{
-		auto& joypad = device->GetJoypad();
-		uint8_t state = joypad.GetRegister();
-
-		const ImGuiInputTextFlags flags = ImGuiInputTextFlags_NoHorizontalScroll | ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_CharsHexadecimal;
-		uint32_t value = state;
-		if (ImGui::InputScalar("Register", ImGuiDataType_U32, &value, nullptr, nullptr, "%02X", flags))
+		// The register is only written by the game and the debugger, so it can only be poked while idle
+		if (emulation.IsIdle())
 		{
-			state = static_cast<uint8_t>(value);
-		}
-		bool buttons_selected = (state & Gameboy::Joypad::ButtonSelectMask) == 0;
-		if (ImGui::Checkbox("Buttons", &buttons_selected))
-		{
-			if (buttons_selected)
+			auto& joypad = device->GetJoypad();
+			uint8_t state = joypad.GetRegister();
+
+			const ImGuiInputTextFlags flags = ImGuiInputTextFlags_NoHorizontalScroll | ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_CharsHexadecimal;
+			uint32_t value = state;
+			if (ImGui::InputScalar("Register", ImGuiDataType_U32, &value, nullptr, nullptr, "%02X", flags))
 			{
-				state &= ~Gameboy::Joypad::ButtonSelectMask;
+				state = static_cast<uint8_t>(value);
 			}
-			else
+			bool buttons_selected = (state & Gameboy::Joypad::ButtonSelectMask) == 0;
+			if (ImGui::Checkbox("Buttons", &buttons_selected))
 			{
-				state |= Gameboy::Joypad::ButtonSelectMask;
+				if (buttons_selected)
+				{
+					state &= ~Gameboy::Joypad::ButtonSelectMask;
+				}
+				else
+				{
+					state |= Gameboy::Joypad::ButtonSelectMask;
+				}
 			}
-		}
 
-		ImGui::SameLine(100.0f);
-		bool direction_selected = (state & Gameboy::Joypad::DirectionSelectMask) == 0;
-		if (ImGui::Checkbox("Directions", &direction_selected))
-		{
-			if (direction_selected)
-			{
-				state &= ~Gameboy::Joypad::DirectionSelectMask;
-			}
-			else
+			ImGui::SameLine(100.0f);
+			bool direction_selected = (state & Gameboy::Joypad::DirectionSelectMask) == 0;
+			if (ImGui::Checkbox("Directions", &direction_selected))
 			{
-				state |= Gameboy::Joypad::DirectionSelectMask;
+				if (direction_selected)
+				{
+					state &= ~Gameboy::Joypad::DirectionSelectMask;
+				}
+				else
+				{
+					state |= Gameboy::Joypad::DirectionSelectMask;
+				}
 			}
+
+			joypad.SetRegister(state);
 		}
 
+		// Button presses go through the emulation thread, so keep our own copy of what was sent
+		static uint8_t button_states = 0b11111111;
 		for (uint8_t i = 0; i < 8; ++i)
 		{
 			const char* names[] = { "Right", "Left", "Up", "Down", "A", "B", "Select", "Start" };
@@ -318,29 +366,35 @@ void Application::Tick()
 			}
 
 			const uint8_t button = 1 << i;
-			bool set = joypad.GetButtonState(button) != 0;
+			bool set = (button_states & button) != 0;
 
 			if (ImGui::Checkbox(name, &set))
 			{
-				joypad.SetButtonState(button, set);
+				button_states = set ? (button_states | button) : (button_states & ~button);
+				emulation.SetButtonState(button, set);
 			}
 		}
-
-		joypad.SetRegister(state);
 	}
 	ImGui::End();
 
 	// Show disassembly
 	static DisassemblyState disassembly_state;
 	disassembly_state.m_Debugger = &debugger;
-	disassembly_state.m_ProgramCounter = device->GetCPU().LoadRegister16(Gameboy::CPU::RegisterPC);
+	disassembly_state.m_ProgramCounter = pc;
 	disassembly_state.m_ViewAddress = disassembly_state.m_ProgramCounter;
 
 	ImGui::SetNextWindowDockID(dock_id, ImGuiSetCond_FirstUseEver);
 	ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f));
 	if (ImGui::Begin("Disassembly"))
 	{
-		ShowDisassembly("disassembly", disassembly_state);
+		if (emulation.IsIdle())
+		{
+			ShowDisassembly("disassembly", disassembly_state);
+		}
+		else
+		{
+			ImGui::TextUnformatted("Break to inspect disassembly");
+		}
 	}
 	ImGui::PopStyleVar();
 	ImGui::End();
@@ -353,7 +407,14 @@ void Application::Tick()
 	if (ImGui::Begin("Breakpoints"))
 	{
 		ImGui::PopStyleVar();
-		ShowBreakpoints("breakpoints", breakpoints_state);
+		if (emulation.IsIdle())
+		{
+			ShowBreakpoints("breakpoints", breakpoints_state);
+		}
+		else
+		{
+			ImGui::TextUnformatted("Break to edit breakpoints");
+		}
 	}
 	else
 	{
@@ -364,13 +425,16 @@ void Application::Tick()
 
 	if (ImGui::Begin("Recorder"))
 	{
-		int current = static_cast<int>(recorder->GetCurrentFrame());
-		int count = static_cast<int>(recorder->GetFrameCount());
+		int current = static_cast<int>(snapshot.m_RecorderCurrentFrame);
+		const int first = static_cast<int>(snapshot.m_RecorderFirstFrame);
+		const int last = std::max(first, static_cast<int>(snapshot.m_RecorderFrameCount) - 1);
 
-		if (ImGui::SliderInt("Frame", &current, 0, count))
+		// Seeks re-run the device from the nearest keyframe, so a seek costs at most a second of emulation wherever it lands
+		if (ImGui::SliderInt("Frame", &current, first, last) && !running)
 		{
-
+			emulation.Seek(static_cast<size_t>(current));
 		}
+		ImGui::Text("%zu keyframes, %zu kb", snapshot.m_RecorderKeyframeCount, snapshot.m_RecorderMemoryUsage / 1024);
 	}
 	ImGui::End();
 	
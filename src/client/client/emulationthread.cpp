@@ -0,0 +1,319 @@
+#include <client/emulationthread.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/debugger.hpp>
+#include <gameboy/device.hpp>
+#include <gameboy/joypad.hpp>
+#include <gameboy/mmu.hpp>
+
+#include <common/recorder.hpp>
+
+using namespace Amber;
+using namespace Client;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr auto FramePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / EmulationThread::FrameRate));
+
+	// Falling further behind than this (a breakpoint, a hitch, a debugger attached) restarts the pacing instead of
+	// running flat out until the lost time is made up
+	constexpr auto MaximumLag = FramePeriod * 4;
+
+	// How long the thread sleeps between polling the command queue while it isn't running
+	constexpr auto IdlePollInterval = std::chrono::milliseconds(1);
+}
+
+EmulationThread::EmulationThread(Gameboy::Device& a_Device, Gameboy::Debugger& a_Debugger, Common::Recorder* a_Recorder):
+	m_Device(a_Device),
+	m_Debugger(a_Debugger),
+	m_Recorder(a_Recorder)
+{
+	// The first snapshot is taken before the thread exists, so the UI always has something to show
+	Record();
+	Publish();
+	m_Thread = std::thread(&EmulationThread::Main, this);
+}
+
+EmulationThread::~EmulationThread() noexcept
+{
+	Submit({ Command::Quit, 0, false });
+	m_Thread.join();
+}
+
+void EmulationThread::Run()
+{
+	Submit({ Command::Run, 0, false });
+}
+
+void EmulationThread::Break()
+{
+	Submit({ Command::Break, 0, false });
+}
+
+void EmulationThread::Step()
+{
+	Submit({ Command::Step, 0, false });
+}
+
+void EmulationThread::StepFrame()
+{
+	Submit({ Command::StepFrame, 0, false });
+}
+
+void EmulationThread::Microstep()
+{
+	Submit({ Command::Microstep, 0, false });
+}
+
+void EmulationThread::Reset()
+{
+	Submit({ Command::Reset, 0, false });
+}
+
+void EmulationThread::SetButtonState(uint8_t a_Buttons, bool a_State)
+{
+	Submit({ Command::SetButtonState, a_Buttons, a_State });
+}
+
+void EmulationThread::SetThrottleEnabled(bool a_Enabled)
+{
+	Submit({ Command::SetThrottleEnabled, 0, a_Enabled });
+}
+
+void EmulationThread::Seek(size_t a_Frame)
+{
+	Submit({ Command::Seek, 0, false, a_Frame });
+}
+
+bool EmulationThread::IsRunning() const noexcept
+{
+	return m_Running.load(std::memory_order_acquire);
+}
+
+bool EmulationThread::IsIdle() const noexcept
+{
+	return m_CompletedCommands.load(std::memory_order_acquire) == m_SubmittedCommands && !m_Running.load(std::memory_order_acquire);
+}
+
+bool EmulationThread::IsThrottleEnabled() const noexcept
+{
+	return m_ThrottleEnabled.load(std::memory_order_relaxed);
+}
+
+bool EmulationThread::AcquireSnapshot() noexcept
+{
+	return m_Snapshots.Acquire();
+}
+
+const EmulationThread::Snapshot& EmulationThread::GetSnapshot() const noexcept
+{
+	return m_Snapshots.GetFront();
+}
+
+void EmulationThread::Submit(const Command& a_Command)
+{
+	// The queue only fills up if the UI issues commands faster than a frame can be emulated, just wait it out
+	while (!m_Commands.TryPush(a_Command))
+	{
+		std::this_thread::yield();
+	}
+
+	++m_SubmittedCommands;
+}
+
+void EmulationThread::Execute(const Command& a_Command)
+{
+	const bool running = m_Running.load(std::memory_order_relaxed);
+
+	// Anything that touches the device has to publish before clearing the running flag, once the UI sees the thread
+	// idle it's free to use the device itself
+	switch (a_Command.m_Type)
+	{
+		case Command::Run:
+		if (!running)
+		{
+			m_ForceKeyframe = true;
+			m_FrameDeadline = Clock::now();
+			m_Running.store(true, std::memory_order_release);
+		}
+		break;
+
+		case Command::Break:
+		if (running)
+		{
+			Publish();
+			m_Running.store(false, std::memory_order_release);
+		}
+		break;
+
+		case Command::Step:
+		if (!running)
+		{
+			m_Debugger.Step();
+			Publish();
+		}
+		break;
+
+		case Command::StepFrame:
+		if (!running)
+		{
+			m_ForceKeyframe = true;
+			if (m_Debugger.Run())
+			{
+				Record();
+			}
+			Publish();
+		}
+		break;
+
+		case Command::Microstep:
+		if (!running)
+		{
+			m_Debugger.Microstep();
+			Publish();
+		}
+		break;
+
+		case Command::Reset:
+		{
+			const bool keep_running = m_Debugger.Reset();
+			m_ForceKeyframe = true;
+			Publish();
+			m_FrameDeadline = Clock::now();
+			m_Running.store(running && keep_running, std::memory_order_release);
+		}
+		break;
+
+		case Command::SetButtonState:
+		m_Device.GetJoypad().SetButtonState(a_Command.m_Buttons, a_Command.m_State);
+		break;
+
+		case Command::SetThrottleEnabled:
+		m_FrameDeadline = Clock::now();
+		m_ThrottleEnabled.store(a_Command.m_State, std::memory_order_relaxed);
+		break;
+
+		case Command::Seek:
+		if (!running && m_Recorder != nullptr && m_Recorder->GetFrameCount() != 0)
+		{
+			m_Recorder->SetCurrentFrame(a_Command.m_Frame);
+			m_Device.Restore(*m_Recorder);
+			Publish();
+		}
+		break;
+
+		case Command::Quit:
+		m_Quit = true;
+		break;
+	}
+}
+
+void EmulationThread::Record()
+{
+	// Frames are appended as they complete, even after seeking back
+	if (m_Recorder != nullptr)
+	{
+		m_Recorder->NewFrame();
+		if (m_ForceKeyframe)
+		{
+			m_Recorder->ForceKeyframe();
+			m_ForceKeyframe = false;
+		}
+		m_Device.Record(*m_Recorder);
+	}
+}
+
+void EmulationThread::Publish()
+{
+	m_Device.Synchronize();
+
+	auto& snapshot = m_Snapshots.GetBack();
+	auto& ppu = m_Device.GetPPU();
+	auto& cpu = m_Device.GetCPU();
+	auto& mmu = m_Device.GetMMU();
+
+	ppu.Blit(snapshot.m_LCD.data(), Gameboy::PPU::LCDWidth);
+	for (size_t i = 0; i < snapshot.m_VRAM.size(); ++i)
+	{
+		snapshot.m_VRAM[i] = mmu.Load8(static_cast<uint16_t>(0x8000 + i));
+	}
+	for (uint8_t i = 0; i < snapshot.m_Registers.size(); ++i)
+	{
+		snapshot.m_Registers[i] = cpu.LoadRegister16(i);
+	}
+	snapshot.m_FrameSequence = ppu.GetFrameSequence();
+	snapshot.m_LY = ppu.GetLY();
+
+	if (m_Recorder != nullptr)
+	{
+		snapshot.m_RecorderFirstFrame = m_Recorder->GetFirstFrame();
+		snapshot.m_RecorderFrameCount = m_Recorder->GetFrameCount();
+		snapshot.m_RecorderCurrentFrame = m_Recorder->GetCurrentFrame();
+		snapshot.m_RecorderKeyframeCount = m_Recorder->GetKeyframeCount();
+		snapshot.m_RecorderMemoryUsage = m_Recorder->GetMemoryUsage();
+	}
+	else
+	{
+		snapshot.m_RecorderFirstFrame = 0;
+		snapshot.m_RecorderFrameCount = 0;
+		snapshot.m_RecorderCurrentFrame = 0;
+		snapshot.m_RecorderKeyframeCount = 0;
+		snapshot.m_RecorderMemoryUsage = 0;
+	}
+
+	m_Snapshots.Publish();
+}
+
+void EmulationThread::Main()
+{
+	while (!m_Quit)
+	{
+		while (const auto command = m_Commands.TryPop())
+		{
+			Execute(*command);
+			m_CompletedCommands.fetch_add(1, std::memory_order_release);
+		}
+
+		if (m_Quit)
+		{
+			break;
+		}
+
+		if (!m_Running.load(std::memory_order_relaxed))
+		{
+			std::this_thread::sleep_for(IdlePollInterval);
+			continue;
+		}
+
+		// One frame per iteration, so commands are never more than a frame late
+		const bool keep_running = m_Debugger.Run();
+		if (keep_running)
+		{
+			Record();
+		}
+		Publish();
+
+		if (!keep_running)
+		{
+			m_Running.store(false, std::memory_order_release);
+			continue;
+		}
+
+		if (m_ThrottleEnabled.load(std::memory_order_relaxed))
+		{
+			m_FrameDeadline += FramePeriod;
+
+			const auto now = Clock::now();
+			if (now - m_FrameDeadline > MaximumLag)
+			{
+				m_FrameDeadline = now;
+			}
+			else
+			{
+				std::this_thread::sleep_until(m_FrameDeadline);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef H_AMBER_CLIENT_EMULATIONTHREAD
+#define H_AMBER_CLIENT_EMULATIONTHREAD
+
+#include <client/api.hpp>
+
+#include <gameboy/ppu.hpp>
+
+#include <common/spscqueue.hpp>
+#include <common/triplebuffer.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace Amber::Common
+{
+	class Recorder;
+}
+
+namespace Amber::Gameboy
+{
+	class Debugger;
+	class Device;
+}
+
+namespace Amber::Client
+{
+	// Runs a device through its debugger on a dedicated thread, so emulation speed no longer depends on how fast the
+	// UI happens to draw. The UI talks to it through a lock-free command queue and reads back the latest frame through
+	// a lock-free mailbox. While IsIdle() returns true the thread is guaranteed not to touch the device, which is the
+	// only time the UI may inspect or modify the device and debugger directly.
+	//
+	// Given a recorder, the thread records the device every time a frame completes and can restore any recorded frame.
+	// The recorder belongs to the thread just like the device, the UI sees its progress through the snapshots. While
+	// idle the device can change in ways the recorder doesn't see (stepping, seeking, the UI editing it), so the first
+	// frame after resuming or resetting is stored as a keyframe and a recorder that journals the input can always
+	// replay up to it.
+	class CLIENT_API EmulationThread
+	{
+		public:
+		static constexpr size_t ClockRate = 4194304;
+		static constexpr double FrameRate = static_cast<double>(ClockRate) / Gameboy::PPU::FrameCycles;
+
+		struct Snapshot
+		{
+			std::array<uint8_t, Gameboy::PPU::LCDWidth * Gameboy::PPU::LCDHeight * 4> m_LCD; // RGBA, converted on the emulation thread
+			std::array<uint8_t, 0x2000> m_VRAM;
+			std::array<uint16_t, 8> m_Registers;
+			uint64_t m_FrameSequence;
+			uint8_t m_LY;
+
+			// Recorder progress, all zero without a recorder
+			size_t m_RecorderFirstFrame;
+			size_t m_RecorderFrameCount;
+			size_t m_RecorderCurrentFrame;
+			size_t m_RecorderKeyframeCount;
+			size_t m_RecorderMemoryUsage;
+		};
+
+		EmulationThread(Gameboy::Device& a_Device, Gameboy::Debugger& a_Debugger, Common::Recorder* a_Recorder = nullptr);
+		~EmulationThread() noexcept;
+
+		EmulationThread(const EmulationThread&) = delete;
+		EmulationThread& operator=(const EmulationThread&) = delete;
+
+		// Commands, executed in order on the emulation thread
+		void Run();
+		void Break();
+		void Step();
+		void StepFrame();
+		void Microstep();
+		void Reset();
+		void SetButtonState(uint8_t a_Buttons, bool a_State);
+		void SetThrottleEnabled(bool a_Enabled);
+		void Seek(size_t a_Frame);
+
+		bool IsRunning() const noexcept;
+		bool IsIdle() const noexcept;
+		bool IsThrottleEnabled() const noexcept;
+
+		// Returns true if a newer snapshot was published since the last call
+		bool AcquireSnapshot() noexcept;
+		const Snapshot& GetSnapshot() const noexcept;
+
+		private:
+		struct Command
+		{
+			enum Type : uint8_t
+			{
+				Run,
+				Break,
+				Step,
+				StepFrame,
+				Microstep,
+				Reset,
+				SetButtonState,
+				SetThrottleEnabled,
+				Seek,
+				Quit,
+			};
+
+			Type m_Type;
+			uint8_t m_Buttons;
+			bool m_State;
+			size_t m_Frame = 0;
+		};
+
+		void Submit(const Command& a_Command);
+		void Execute(const Command& a_Command);
+		void Record();
+		void Publish();
+		void Main();
+
+		Gameboy::Device& m_Device;
+		Gameboy::Debugger& m_Debugger;
+		Common::Recorder* const m_Recorder;
+
+		Common::SPSCQueue<Command, 64> m_Commands;
+		Common::TripleBuffer<Snapshot> m_Snapshots;
+
+		// UI thread only
+		uint64_t m_SubmittedCommands = 0;
+
+		// Emulation thread only
+		bool m_Quit = false;
+		bool m_ForceKeyframe = false; // The device may no longer follow on from the last recorded frame
+		std::chrono::steady_clock::time_point m_FrameDeadline;
+
+		// Written by the emulation thread, read by the UI thread
+		std::atomic<uint64_t> m_CompletedCommands = 0;
+		std::atomic<bool> m_Running = false;
+		std::atomic<bool> m_ThrottleEnabled = true;
+
+		std::thread m_Thread;
+	};
+}
+
+#endif
\ No newline at end of file
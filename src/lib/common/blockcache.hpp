@@ -0,0 +1,154 @@
+#ifndef H_AMBER_COMMON_BLOCKCACHE
+#define H_AMBER_COMMON_BLOCKCACHE
+
+#include <common/api.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Amber::Common
+{
+	// Cache of pre-decoded basic blocks. Blocks are keyed by physical address (see Memory::GetPhysicalAddress), so
+	// the same logical address in two different banks never shares a block. Pages containing writable memory can be
+	// watched, after which a store to that page drops every block that was decoded from it.
+	template <typename Address, typename MicroOp, size_t PageBits = 8>
+	class BlockCache
+	{
+		public:
+		static_assert(std::is_unsigned_v<Address> && sizeof(Address) <= 2, "Block cache only supports up to 16-bit address spaces");
+
+		static constexpr size_t PageSize = size_t(1) << PageBits;
+		static constexpr size_t PageCount = (size_t(std::numeric_limits<Address>::max()) >> PageBits) + 1;
+
+		// The ops aren't copied into the block, they point into the instruction set they were decoded from. That way
+		// they stay valid while the CPU is still running them, even if the block gets dropped halfway through.
+		struct Instruction
+		{
+			const MicroOp* m_Ops;
+			const MicroOp* m_ExtendedOps; // Ops of the instruction following a prefix, or null
+			uint8_t m_OpCount;
+			uint8_t m_ExtendedOpCount;
+			uint8_t m_Size;   // Bytes consumed by the decoder (opcode and prefix)
+			uint8_t m_Length; // Bytes consumed by the whole instruction, including operands
+		};
+
+		struct Block
+		{
+			uint64_t m_Key = 0;
+			Address m_Address = 0;
+			Address m_Length = 0;
+			std::vector<Instruction> m_Instructions;
+		};
+
+		const Block* Find(uint64_t a_Key) const
+		{
+			const auto it = m_Blocks.find(a_Key);
+			return it != m_Blocks.end() ? &it->second : nullptr;
+		}
+
+		const Block* Insert(uint64_t a_Key, Block&& a_Block, bool a_Watch)
+		{
+			auto& block = m_Blocks[a_Key];
+			Unwatch(block);
+			block = std::move(a_Block);
+			block.m_Key = a_Key;
+
+			if (a_Watch && block.m_Length != 0)
+			{
+				const size_t first_page = block.m_Address >> PageBits;
+				const size_t last_page = (size_t(block.m_Address) + block.m_Length - 1) >> PageBits;
+				for (size_t page = first_page; page <= last_page && page < PageCount; ++page)
+				{
+					m_Pages[page].push_back(a_Key);
+				}
+			}
+
+			return &block;
+		}
+
+		void Invalidate(Address a_Address)
+		{
+			auto& page = m_Pages[a_Address >> PageBits];
+			if (page.empty())
+			{
+				return;
+			}
+
+			// A block can span several pages, its key has to leave all of them or recompiling it adds it again
+			std::swap(page, m_Invalidated);
+			for (const uint64_t key : m_Invalidated)
+			{
+				const auto it = m_Blocks.find(key);
+				if (it != m_Blocks.end())
+				{
+					Unwatch(it->second);
+					m_Blocks.erase(it);
+				}
+			}
+			m_Invalidated.clear();
+
+			NewGeneration();
+		}
+
+		void Clear()
+		{
+			m_Blocks.clear();
+			for (auto& page : m_Pages)
+			{
+				page.clear();
+			}
+
+			NewGeneration();
+		}
+
+		// Blocks handed out before a generation change may be stale and must be looked up again
+		uint64_t GetGeneration() const noexcept
+		{
+			return m_Generation;
+		}
+
+		void NewGeneration() noexcept
+		{
+			++m_Generation;
+		}
+
+		size_t GetBlockCount() const noexcept
+		{
+			return m_Blocks.size();
+		}
+
+		// Blocks a store to the address would drop
+		size_t GetWatchCount(Address a_Address) const noexcept
+		{
+			return m_Pages[a_Address >> PageBits].size();
+		}
+
+		private:
+		void Unwatch(const Block& a_Block)
+		{
+			if (a_Block.m_Length == 0)
+			{
+				return;
+			}
+
+			const size_t first_page = a_Block.m_Address >> PageBits;
+			const size_t last_page = (size_t(a_Block.m_Address) + a_Block.m_Length - 1) >> PageBits;
+			for (size_t page = first_page; page <= last_page && page < PageCount; ++page)
+			{
+				auto& keys = m_Pages[page];
+				keys.erase(std::remove(keys.begin(), keys.end(), a_Block.m_Key), keys.end());
+			}
+		}
+
+		std::unordered_map<uint64_t, Block> m_Blocks;
+		std::vector<uint64_t> m_Pages[PageCount];
+		std::vector<uint64_t> m_Invalidated;
+		uint64_t m_Generation = 0;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -24,21 +24,29 @@ namespace Amber::Common
 			return Read(&a_Destination, sizeof(T));
 		}
 
+		// Reads a quantity written by ByteWriter::WriteVLQ. Returns the number of bytes read, or 0 if the source ended
+		// before the last byte of the quantity.
 		template <typename T>
 		size_t ReadVLQ(T& a_Quantity) noexcept
 		{
 			a_Quantity = 0;
 			size_t bytes_read = 0;
 
-			for (;;)
+			for (size_t shift = 0;; shift += 7)
 			{
 				uint8_t byte = 0;
-				bytes_read += Read(byte);
+				if (Read(byte) == 0)
+				{
+					return 0;
+				}
+				++bytes_read;
 
-				a_Quantity <<= 7;
-				a_Quantity |= byte & 0b0111'1111;
+				if (shift < sizeof(T) * 8)
+				{
+					a_Quantity |= static_cast<T>(byte & 0b0111'1111) << shift;
+				}
 
-				if (byte & 0b1000'0000)
+				if ((byte & 0b1000'0000) == 0)
 				{
 					break;
 				}
@@ -24,6 +24,8 @@ namespace Amber::Common
 			return Write(&a_Source, sizeof(T));
 		}
 
+		// Writes 7 bits at a time starting with the least significant ones, the high bit of every byte but the last is set.
+		// Returns the number of bytes written, or 0 if the quantity didn't fit.
 		template <typename T>
 		size_t WriteVLQ(T a_Quantity) noexcept
 		{
@@ -47,7 +49,6 @@ namespace Amber::Common
 			}
 			while (a_Quantity != 0);
 
-			m_Position += bytes_written;
 			return bytes_written;
 		}
 
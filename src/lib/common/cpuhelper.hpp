@@ -45,6 +45,17 @@ namespace Amber::Common
 				reg.Store<T>(a_Register & RegisterMask, a_Value);
 			}
 
+			// Runs several ops as one, the instruction builder uses it to turn a cycle into a single op
+			template <auto Op, auto... Ops>
+			void ConcatOp()
+			{
+				(static_cast<CPU*>(this)->*Op)();
+				if constexpr (sizeof...(Ops) != 0)
+				{
+					ConcatOp<Ops...>();
+				}
+			}
+
 			protected:
 			// Program counter
 			RegisterType LoadProgramCounter() const noexcept
@@ -57,19 +68,33 @@ namespace Amber::Common
 				StoreRegister<RegisterType>(ProgramCounter, a_Value);
 			}
 
+			// Memory access: every load and store of the ops below goes through these, a CPU that knows the concrete
+			// type of its memory can hide them with non-virtual versions
+			template <typename T>
+			T LoadMemory(RegisterType a_Address) const
+			{
+				return m_Memory.template Load<T>(a_Address);
+			}
+
+			template <typename T>
+			void StoreMemory(RegisterType a_Address, T a_Value)
+			{
+				m_Memory.template Store<T>(a_Address, a_Value);
+			}
+
 			// Decoding
 			template <typename T>
 			T PeekNext() const noexcept
 			{
 				const auto pc = LoadProgramCounter();
-				return m_Memory.Load<T>(pc);
+				return static_cast<const CPU*>(this)->template LoadMemory<T>(pc);
 			}
 
 			template <typename T>
 			T ReadNext() noexcept
 			{
 				auto pc = LoadProgramCounter();
-				const auto result = m_Memory.Load<T>(pc);
+				const auto result = static_cast<const CPU*>(this)->template LoadMemory<T>(pc);
 				pc += sizeof(T);
 				StoreProgramCounter(pc);
 
@@ -103,35 +128,24 @@ namespace Amber::Common
 				}
 			}
 
-			template <auto Op, auto... Ops>
-			void ConcatOp() noexcept
-			{
-				(static_cast<CPU*>(this)->*Op)();
-				if constexpr (sizeof...(Ops) != 0)
-				{
-					ConcatOp<Ops...>();
-				}
-			}
-
 			template <auto Op, uint8_t Counter>
 			void DelayOp() noexcept
 			{
 				if constexpr (Counter == 0)
 				{
-					ExtendInstruction(Op);
+					AppendOp(Op);
 				}
 				else
 				{
-					PushOp(&CPU::DelayOp<Op, Counter - 1>);
+					DeferOp(&CPU::DelayOp<Op, Counter - 1>);
 				}
 			}
 
 			void SkipOp() noexcept
 			{
-				while (!IsInstructionDone())
-				{
-					PopOp();
-				}
+				m_Op = m_OpEnd;
+				m_ExtendedOps = m_ExtendedOpsEnd;
+				m_AppendedOp = nullptr;
 			}
 
 			// Load ops
@@ -159,7 +173,7 @@ namespace Amber::Common
 			void LoadOp_r_ar() noexcept
 			{
 				const RegisterType address = LoadRegister<RegisterType>(Source);
-				const T value = m_Memory.Load<T>(address);
+				const T value = static_cast<const CPU*>(this)->template LoadMemory<T>(address);
 				LoadOp_r_x<T, Destination>(value);
 			}
 
@@ -168,7 +182,7 @@ namespace Amber::Common
 			{
 				const RegisterType address = LoadRegister<RegisterType>(Destination);
 				const T value = LoadRegister<T>(Source);
-				m_Memory.Store<T>(address, value);
+				static_cast<CPU*>(this)->template StoreMemory<T>(address, value);
 			}
 
 			// Jump ops
@@ -190,29 +204,17 @@ namespace Amber::Common
 				JumpOp_x(Address);
 			}
 
-			// Managing op queue
-			void PushOp(MicroOp a_Op) noexcept
-			{
-				#ifdef _DEBUG
-				assert(m_MicroOps[m_OpBack] == nullptr);
-				#endif
-
-				m_MicroOps[m_OpBack] = a_Op;
-				IncrementOpCounter(m_OpBack);
-			}
-
-			MicroOp PopOp() noexcept
+			// Op execution: the ops of the current instruction are read in place through a cursor, so they have to stay
+			// alive until it's done (instruction sets or static sequences). Ops from outside the instruction (interrupts)
+			// wait in a small side queue until the next instruction boundary, after which the decode op runs.
+			MicroOp NextOp() noexcept
 			{
-				const MicroOp op = m_MicroOps[m_OpFront];
-
-				#ifdef _DEBUG
-				assert(m_MicroOps[m_OpFront] != nullptr);
-				m_MicroOps[m_OpFront] = nullptr;
-				#endif
-
-				IncrementOpCounter(m_OpFront);
+				if (m_Op != m_OpEnd)
+				{
+					return *m_Op++;
+				}
 
-				return op;
+				return NextBoundaryOp();
 			}
 
 			void CallOp(MicroOp a_Op)
@@ -222,99 +224,145 @@ namespace Amber::Common
 
 			void ClearOps() noexcept
 			{
-				m_OpBack = m_OpFront;
-
-				#ifdef _DEBUG
-				std::memset(m_MicroOps, 0, sizeof(m_MicroOps));
-				#endif
+				m_Op = m_OpEnd = nullptr;
+				m_ExtendedOps = m_ExtendedOpsEnd = nullptr;
+				m_AppendedOp = nullptr;
+				m_DeferredOp = nullptr;
+				m_QueueFront = m_QueueBack = 0;
 			}
 
-			void PushInstruction(MicroOp a_Op) noexcept
+			// Starts a decoded instruction, an op deferred by the previous one runs right away
+			void PushInstruction(const MicroOp* a_Ops, size_t a_Count)
 			{
-				PushInstruction(&a_Op, 1);
-			}
+				m_Op = a_Ops;
+				m_OpEnd = a_Ops + a_Count;
 
-			// TODO: use span
-			void PushInstruction(const MicroOp* a_Ops, size_t a_Count) noexcept
-			{
-				for (size_t i = 0; i < a_Count; ++i)
+				if (m_DeferredOp != nullptr)
 				{
-					PushOp(a_Ops[i]);
+					const MicroOp op = m_DeferredOp;
+					m_DeferredOp = nullptr;
+					CallOp(op);
 				}
+			}
 
-				m_OpDone = m_OpBack;
+			// Starts a sequence that isn't decoded from memory (e.g. an interrupt dispatch), it leaves deferred ops alone
+			void InsertInstruction(const MicroOp* a_Ops, size_t a_Count) noexcept
+			{
+				m_Op = a_Ops;
+				m_OpEnd = a_Ops + a_Count;
 			}
 
-			void InsertOpBeforeInstruction(MicroOp a_Op)
+			// Continues the current instruction with more ops once its own are done, used by prefixes
+			void ExtendInstruction(const MicroOp* a_Ops, size_t a_Count) noexcept
 			{
-				InsertOp(a_Op, m_OpFront);
+				m_ExtendedOps = a_Ops;
+				m_ExtendedOpsEnd = a_Ops + a_Count;
 			}
 
-			void InsertOpAfterInstruction(MicroOp a_Op)
+			// Runs a single op as the last one of the current instruction
+			void AppendOp(MicroOp a_Op) noexcept
 			{
-				InsertOp(a_Op, m_OpDone);
+				m_AppendedOp = a_Op;
 			}
 
-			void ExtendInstruction(MicroOp a_Op) noexcept
+			// Runs a single op as the first one of the next decoded instruction
+			void DeferOp(MicroOp a_Op) noexcept
 			{
-				ExtendInstruction(&a_Op, 1);
+				m_DeferredOp = a_Op;
 			}
 
-			// TODO: use span
-			void ExtendInstruction(const MicroOp* a_Ops, size_t a_Count) noexcept
+			MicroOp GetDeferredOp() const noexcept
 			{
-				for (size_t i = 0; i < a_Count; ++i)
+				return m_DeferredOp;
+			}
+
+			// Runs an op at the next instruction boundary, after the ones queued earlier. Queueing an op that's already
+			// waiting does nothing, running it twice in a row wouldn't do anything either.
+			void QueueOp(MicroOp a_Op) noexcept
+			{
+				for (uint8_t i = m_QueueFront; i != m_QueueBack; ++i)
 				{
-					InsertOpAfterInstruction(a_Ops[i]);
-					IncrementInstruction();
+					if (m_QueuedOps[i % std::size(m_QueuedOps)] == a_Op)
+					{
+						return;
+					}
 				}
+
+				#ifdef _DEBUG
+				assert(static_cast<uint8_t>(m_QueueBack - m_QueueFront) < std::size(m_QueuedOps));
+				#endif
+
+				m_QueuedOps[m_QueueBack++ % std::size(m_QueuedOps)] = a_Op;
 			}
 
-			bool IsInstructionDone() const noexcept
+			// Same, but ahead of all ops queued so far
+			void QueueOpFirst(MicroOp a_Op) noexcept
 			{
-				return m_OpFront == m_OpDone;
+				#ifdef _DEBUG
+				assert(static_cast<uint8_t>(m_QueueBack - m_QueueFront) < std::size(m_QueuedOps));
+				#endif
+
+				m_QueuedOps[--m_QueueFront % std::size(m_QueuedOps)] = a_Op;
 			}
 
-			void IncrementInstruction() noexcept
+			bool IsInstructionDone() const noexcept
 			{
-				IncrementOpCounter(m_OpDone);
+				return m_Op == m_OpEnd && m_ExtendedOps == m_ExtendedOpsEnd && m_AppendedOp == nullptr;
 			}
 
-			void ResetInstruction() noexcept
+			// Whether the next instruction gets decoded right away, without queued or deferred ops running first
+			bool IsDecodeNext() const noexcept
 			{
-				m_OpDone = m_OpFront;
+				return IsInstructionDone() && m_DeferredOp == nullptr && m_QueueFront == m_QueueBack;
 			}
 
 			// Memory variables
 			Memory<RegisterType>& m_Memory;
 			Register<RegisterType> m_Registers[RegisterCount];
 
+			// Runs whenever there's nothing left to do, decodes and pushes the next instruction
+			MicroOp m_DecodeOp = nullptr;
+
 			private:
-			// Managing op queue
-			void IncrementOpCounter(size_t& a_Counter) const noexcept
+			MicroOp NextBoundaryOp() noexcept
 			{
-				++a_Counter;
-				a_Counter %= std::size(m_MicroOps);
-			}
+				if (m_ExtendedOps != m_ExtendedOpsEnd)
+				{
+					m_Op = m_ExtendedOps;
+					m_OpEnd = m_ExtendedOpsEnd;
+					m_ExtendedOps = m_ExtendedOpsEnd = nullptr;
+					return *m_Op++;
+				}
 
-			void InsertOp(MicroOp a_Op, size_t a_Index) noexcept
-			{
-				for (size_t i = m_OpBack; i != a_Index; i = (i - 1) % std::size(m_MicroOps))
+				if (m_AppendedOp != nullptr)
 				{
-					const size_t prev = (i - 1) % std::size(m_MicroOps);
+					const MicroOp op = m_AppendedOp;
+					m_AppendedOp = nullptr;
+					return op;
+				}
 
-					m_MicroOps[i] = m_MicroOps[prev];
+				if (m_QueueFront != m_QueueBack)
+				{
+					return m_QueuedOps[m_QueueFront++ % std::size(m_QueuedOps)];
 				}
 
-				m_MicroOps[a_Index] = a_Op;
-				IncrementOpCounter(m_OpBack);
+				return m_DecodeOp;
 			}
 
-			// Op queue variables
-			MicroOp m_MicroOps[32] = {};
-			size_t m_OpFront = 0;
-			size_t m_OpBack = 0;
-			size_t m_OpDone = 0;
+			// Current instruction
+			const MicroOp* m_Op = nullptr;
+			const MicroOp* m_OpEnd = nullptr;
+			const MicroOp* m_ExtendedOps = nullptr;
+			const MicroOp* m_ExtendedOpsEnd = nullptr;
+			MicroOp m_AppendedOp = nullptr;
+
+			// Next instruction
+			MicroOp m_DeferredOp = nullptr;
+
+			// Side queue, the indices wrap around together with the (power of two sized) array
+			MicroOp m_QueuedOps[8] = {};
+			uint8_t m_QueueFront = 0;
+			uint8_t m_QueueBack = 0;
 		};
 
 		/*template <typename CPU, typename RegisterType, size_t RegisterCount>
@@ -2,116 +2,131 @@
 #define H_AMBER_COMMON_INSTRUCTIONBUILDER
 
 #include <common/api.hpp>
+#include <common/exception.hpp>
 #include <common/instructionset.hpp>
 
-#include <memory>
-#include <vector>
+#include <array>
 
 namespace Amber::Common
 {
-	template <typename Opcode, typename MicroOp, MicroOp EndOp>
+	namespace Internal
+	{
+		template <typename MicroOp>
+		struct MicroOpClass;
+
+		template <typename Class>
+		struct MicroOpClass<void (Class::*)()>
+		{
+			using Type = Class;
+		};
+	}
+
+	// The ops of every cycle are template arguments, so each cycle gets a single op (the CPU's ConcatOp) that runs all
+	// of them with direct calls. The interpreter then dispatches once per cycle, with the ops inlined into that call.
+	// Everything is constexpr: the CPU runs its definitions at compile time and only the built table ends up in the
+	// binary, shared by all instances.
+	template <typename Opcode, typename MicroOp, MicroOp EndOp, size_t InstructionCount, size_t MaxInstructionSize = 8>
 	class InstructionBuilder
 	{
+		using Class = typename Internal::MicroOpClass<MicroOp>::Type;
+
 		public:
-		template <typename... Ops>
-		InstructionBuilder& Begin(Opcode a_Opcode, Ops... a_Ops)
+		constexpr InstructionBuilder() noexcept
+		{
+			if constexpr (EndOp != nullptr)
+			{
+				for (auto& instruction : m_Instructions)
+				{
+					instruction.m_Ops[0] = EndOp;
+					instruction.m_Size = 1;
+				}
+			}
+		}
+
+		template <auto... Ops>
+		constexpr InstructionBuilder& Begin(Opcode a_Opcode)
 		{
 			m_CurrentOp = a_Opcode;
-			Allocate(m_CurrentOp);
-			Clear(m_CurrentOp);
-			return Cycle(a_Ops...);
+			m_Instructions[m_CurrentOp].m_Size = 0;
+			return Cycle<Ops...>();
 		}
 
-		template <typename... Ops>
-		InstructionBuilder& Cycle(Ops... a_Ops)
+		template <auto... Ops>
+		constexpr InstructionBuilder& Cycle()
 		{
-			if constexpr (sizeof...(Ops) > 0)
+			if constexpr (EndOp != nullptr)
 			{
-				Push(m_CurrentOp, a_Ops...);
+				Push<Ops..., EndOp>(m_CurrentOp);
 			}
-			if constexpr (EndOp != nullptr)
+			else if constexpr (sizeof...(Ops) > 0)
 			{
-				Push(m_CurrentOp, EndOp);
+				Push<Ops...>(m_CurrentOp);
 			}
 			return *this;
 		}
 
-		std::unique_ptr<InstructionSet<Opcode, MicroOp>> Build()
+		constexpr size_t GetOpCount() const noexcept
 		{
-			// Count the total amount of ops
-			const size_t instruction_count = m_Instructions.size();
-			size_t total_op_count = 0;
-			for (size_t instruction_index = 0; instruction_index < instruction_count; ++instruction_index)
+			size_t op_count = 0;
+			for (const auto& instruction : m_Instructions)
 			{
-				auto& instruction = m_Instructions[instruction_index];
-				total_op_count += instruction.size();
+				op_count += instruction.m_Size;
 			}
 
-			// Allocate the instruction set
-			auto instruction_set = std::make_unique<InstructionSet<Opcode, MicroOp>>(instruction_count, total_op_count);
+			return op_count;
+		}
+
+		// The op count has to be a constant, pass GetOpCount() of the finished builder
+		template <size_t OpCount>
+		constexpr InstructionTable<Opcode, MicroOp, InstructionCount, OpCount> Build() const
+		{
+			InstructionTable<Opcode, MicroOp, InstructionCount, OpCount> instruction_table;
 
-			// Fill the instruction set
-			total_op_count = 0;
-			for (size_t instruction_index = 0; instruction_index < instruction_count; ++instruction_index)
+			size_t offset = 0;
+			for (size_t instruction_index = 0; instruction_index < InstructionCount; ++instruction_index)
 			{
-				auto& instruction = m_Instructions[instruction_index];
-				const auto opcode = static_cast<Opcode>(instruction_index);
-				const size_t op_count = instruction.size();
-
-				instruction_set->SetInstructionOffset(opcode, total_op_count);
-				instruction_set->SetInstructionSize(opcode, op_count);
-				
-				for (size_t op_index = 0; op_index < op_count; ++op_index)
+				const auto& instruction = m_Instructions[instruction_index];
+				instruction_table.SetInstruction(static_cast<Opcode>(instruction_index), offset, instruction.m_Size);
+
+				for (size_t op_index = 0; op_index < instruction.m_Size; ++op_index)
 				{
-					instruction_set->SetOp(total_op_count + op_index, instruction[op_index]);
+					instruction_table.SetOp(offset + op_index, instruction.m_Ops[op_index]);
 				}
 
-				total_op_count += instruction.size();
+				offset += instruction.m_Size;
 			}
 
-			// Return result
-			return instruction_set;
+			return instruction_table;
 		}
 
-		void Resize(size_t a_Size)
+		private:
+		struct Instruction
 		{
-			std::vector<MicroOp> default_ops;
-			if constexpr (EndOp != nullptr)
-			{
-				default_ops.push_back(EndOp);
-			}
-
-			m_Instructions.resize(a_Size, default_ops);
-		}
+			std::array<MicroOp, MaxInstructionSize> m_Ops = {};
+			size_t m_Size = 0;
+		};
 
-		private:
-		void Allocate(Opcode a_Opcode)
+		template <auto Op, auto... Ops>
+		constexpr void Push(Opcode a_Opcode)
 		{
-			const size_t required_size = static_cast<size_t>(a_Opcode) + 1;
-			if (m_Instructions.size() < required_size)
+			auto& instruction = m_Instructions[a_Opcode];
+			if (instruction.m_Size == MaxInstructionSize)
 			{
-				Resize(required_size);
+				throw Exception("Instruction has too many cycles");
 			}
-		}
-
-		void Clear(Opcode a_Opcode)
-		{
-			m_Instructions[a_Opcode].clear();
-		}
-
-		template <typename... Ops>
-		void Push(Opcode a_Opcode, MicroOp a_Op, Ops... a_Ops)
-		{
-			m_Instructions[a_Opcode].push_back(a_Op);
 
 			if constexpr (sizeof...(Ops) > 0)
 			{
-				Push(a_Opcode, a_Ops...);
+				instruction.m_Ops[instruction.m_Size++] = &Class::template ConcatOp<Op, Ops...>;
+			}
+			else
+			{
+				instruction.m_Ops[instruction.m_Size++] = Op;
 			}
 		}
 
-		std::vector<std::vector<MicroOp>> m_Instructions;
-		Opcode m_CurrentOp;
+		std::array<Instruction, InstructionCount> m_Instructions = {};
+		Opcode m_CurrentOp = {};
 	};
 }
 
@@ -3,85 +3,87 @@
 
 #include <common/api.hpp>
 
-#include <memory>
+#include <array>
 
 namespace Amber::Common
 {
+	// Read-only view of an instruction table, the table itself is generated at compile time by InstructionBuilder
 	template <typename Opcode, typename MicroOp>
 	class InstructionSet
 	{
 		public:
-		InstructionSet(size_t a_InstructionCount, size_t a_OpCount):
+		struct Instruction
+		{
+			size_t m_Offset = 0;
+			size_t m_Size = 0;
+		};
+
+		constexpr InstructionSet(const Instruction* a_Instructions, size_t a_InstructionCount, const MicroOp* a_Ops, size_t a_OpCount) noexcept:
+			m_Instructions(a_Instructions),
 			m_InstructionCount(a_InstructionCount),
+			m_Ops(a_Ops),
 			m_OpCount(a_OpCount)
 		{
-			// Calculate buffer sizes
-			const size_t instruction_buffer_size = m_InstructionCount * sizeof(Instruction);
-			const size_t op_buffer_size = m_OpCount * sizeof(MicroOp);
-
-			// Make sure that op buffer has correct alignment (member pointers can be weird)
-			size_t op_buffer_offset = 0;
-			if (instruction_buffer_size % alignof(MicroOp) != 0)
-			{
-				op_buffer_offset = alignof(MicroOp) - (instruction_buffer_size % alignof(MicroOp));
-			}
-
-			// Allocate the buffer
-			const size_t buffer_size = instruction_buffer_size + op_buffer_offset + op_buffer_size;
-			m_Buffer = std::make_unique<uint8_t[]>(buffer_size);
-
-			// Get pointers to the arrays
-			m_Instructions = reinterpret_cast<Instruction*>(m_Buffer.get());
-			m_Ops = reinterpret_cast<MicroOp*>(m_Buffer.get() + m_InstructionCount * sizeof(Instruction) + op_buffer_offset);
 		}
 
-		size_t GetInstructionCount() const noexcept
+		constexpr size_t GetInstructionCount() const noexcept
 		{
 			return m_InstructionCount;
 		}
 
-		size_t GetInstructionOffset(Opcode a_Opcode)
+		constexpr size_t GetOpCount() const noexcept
+		{
+			return m_OpCount;
+		}
+
+		constexpr size_t GetInstructionOffset(Opcode a_Opcode) const noexcept
 		{
 			return m_Instructions[a_Opcode].m_Offset;
 		}
 
-		size_t GetInstructionSize(Opcode a_Opcode)
+		constexpr size_t GetInstructionSize(Opcode a_Opcode) const noexcept
 		{
 			return m_Instructions[a_Opcode].m_Size;
 		}
 
-		const MicroOp* GetInstructionOps(Opcode a_Opcode)
+		constexpr const MicroOp* GetInstructionOps(Opcode a_Opcode) const noexcept
 		{
 			return m_Ops + GetInstructionOffset(a_Opcode);
 		}
 
-		void SetInstructionOffset(Opcode a_Opcode, size_t a_Offset)
+		private:
+		const Instruction* m_Instructions;
+		size_t m_InstructionCount;
+		const MicroOp* m_Ops;
+		size_t m_OpCount;
+	};
+
+	// Storage of an instruction set, sized to hold exactly its ops
+	template <typename Opcode, typename MicroOp, size_t InstructionCount, size_t OpCount>
+	class InstructionTable
+	{
+		public:
+		using Instruction = typename InstructionSet<Opcode, MicroOp>::Instruction;
+
+		constexpr InstructionSet<Opcode, MicroOp> GetInstructionSet() const noexcept
 		{
-			m_Instructions[a_Opcode].m_Offset = a_Offset;
+			return InstructionSet<Opcode, MicroOp>(m_Instructions.data(), InstructionCount, m_Ops.data(), OpCount);
 		}
 
-		void SetInstructionSize(Opcode a_Opcode, size_t a_Size)
+		constexpr void SetInstruction(Opcode a_Opcode, size_t a_Offset, size_t a_Size) noexcept
 		{
+			m_Instructions[a_Opcode].m_Offset = a_Offset;
 			m_Instructions[a_Opcode].m_Size = a_Size;
 		}
 
-		void SetOp(size_t a_Offset, MicroOp a_Op)
+		constexpr void SetOp(size_t a_Offset, MicroOp a_Op) noexcept
 		{
 			m_Ops[a_Offset] = a_Op;
 		}
 
 		private:
-		struct Instruction
-		{
-			size_t m_Offset;
-			size_t m_Size;
-		};
-
-		size_t m_InstructionCount;
-		size_t m_OpCount;
-		Instruction* m_Instructions;
-		MicroOp* m_Ops;
-		std::unique_ptr<uint8_t[]> m_Buffer;
+		std::array<Instruction, InstructionCount> m_Instructions = {};
+		std::array<MicroOp, OpCount> m_Ops = {};
 	};
 }
 
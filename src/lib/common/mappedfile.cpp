@@ -0,0 +1,118 @@
+#include <common/mappedfile.hpp>
+
+#include <common/exception.hpp>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Amber;
+using namespace Common;
+
+MappedFile::MappedFile(std::string_view a_Path, bool a_Create):
+	m_Path(a_Path)
+{
+	#if defined(_WIN32)
+	m_Handle = CreateFileA(m_Path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, a_Create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_Handle == INVALID_HANDLE_VALUE)
+	{
+		throw Exception("Unable to open file");
+	}
+
+	LARGE_INTEGER size;
+	GetFileSizeEx(m_Handle, &size);
+	m_Size = static_cast<uint64_t>(size.QuadPart);
+	#else
+	m_Descriptor = open(m_Path.c_str(), a_Create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+	if (m_Descriptor < 0)
+	{
+		throw Exception("Unable to open file");
+	}
+
+	struct stat status;
+	fstat(m_Descriptor, &status);
+	m_Size = static_cast<uint64_t>(status.st_size);
+	#endif
+}
+
+MappedFile::~MappedFile() noexcept
+{
+	#if defined(_WIN32)
+	CloseHandle(m_Handle);
+	#else
+	close(m_Descriptor);
+	#endif
+}
+
+const std::string& MappedFile::GetPath() const noexcept
+{
+	return m_Path;
+}
+
+uint64_t MappedFile::GetSize() const noexcept
+{
+	return m_Size;
+}
+
+void MappedFile::Resize(uint64_t a_Size)
+{
+	#if defined(_WIN32)
+	LARGE_INTEGER size;
+	size.QuadPart = static_cast<LONGLONG>(a_Size);
+	if (!SetFilePointerEx(m_Handle, size, nullptr, FILE_BEGIN) || !SetEndOfFile(m_Handle))
+	{
+		throw Exception("Unable to resize file");
+	}
+	#else
+	if (ftruncate(m_Descriptor, static_cast<off_t>(a_Size)) != 0)
+	{
+		throw Exception("Unable to resize file");
+	}
+	#endif
+
+	m_Size = a_Size;
+}
+
+void* MappedFile::Map(uint64_t a_Offset, size_t a_Size)
+{
+	#if defined(_WIN32)
+	// The view keeps the mapping object alive, so there's no need to hold on to it
+	const uint64_t end = a_Offset + a_Size;
+	HANDLE mapping = CreateFileMappingA(m_Handle, nullptr, PAGE_READWRITE, static_cast<DWORD>(end >> 32), static_cast<DWORD>(end), nullptr);
+	if (mapping == nullptr)
+	{
+		throw Exception("Unable to map file");
+	}
+
+	void* const data = MapViewOfFile(mapping, FILE_MAP_WRITE, static_cast<DWORD>(a_Offset >> 32), static_cast<DWORD>(a_Offset), a_Size);
+	CloseHandle(mapping);
+	if (data == nullptr)
+	{
+		throw Exception("Unable to map file");
+	}
+	#else
+	void* const data = mmap(nullptr, a_Size, PROT_READ | PROT_WRITE, MAP_SHARED, m_Descriptor, static_cast<off_t>(a_Offset));
+	if (data == MAP_FAILED)
+	{
+		throw Exception("Unable to map file");
+	}
+	#endif
+
+	return data;
+}
+
+void MappedFile::Unmap(void* a_Data, size_t a_Size) noexcept
+{
+	#if defined(_WIN32)
+	UnmapViewOfFile(a_Data);
+	#else
+	munmap(a_Data, a_Size);
+	#endif
+}
\ No newline at end of file
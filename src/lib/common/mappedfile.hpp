@@ -0,0 +1,43 @@
+#ifndef H_AMBER_COMMON_MAPPEDFILE
+#define H_AMBER_COMMON_MAPPEDFILE
+
+#include <common/api.hpp>
+
+#include <string>
+
+namespace Amber::Common
+{
+	// A file that is read and written through shared memory mappings, so whatever is written to a mapping ends up in
+	// the file even if the process dies without closing it.
+	class COMMON_API MappedFile
+	{
+		public:
+		// Offsets passed to Map have to be a multiple of this (the allocation granularity on Windows)
+		static constexpr size_t Alignment = 0x10000;
+
+		MappedFile(std::string_view a_Path, bool a_Create);
+		~MappedFile() noexcept;
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		const std::string& GetPath() const noexcept;
+		uint64_t GetSize() const noexcept;
+
+		void Resize(uint64_t a_Size);
+		void* Map(uint64_t a_Offset, size_t a_Size);
+		void Unmap(void* a_Data, size_t a_Size) noexcept;
+
+		private:
+		std::string m_Path;
+		uint64_t m_Size = 0;
+
+		#if defined(_WIN32)
+		void* m_Handle;
+		#else
+		int m_Descriptor;
+		#endif
+	};
+}
+
+#endif
\ No newline at end of file
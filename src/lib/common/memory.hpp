@@ -78,6 +78,21 @@ namespace Amber::Common
 		{
 			return static_cast<uint64_t>(a_Address);
 		}
+
+		// Direct access: the host memory backing the whole page starting at a page aligned address, so callers can
+		// skip Load8 and Store8 for it. Null means every access has to go through them. The pointers stay valid until
+		// the memory is remapped, copied or stored to through Store8, ask again after any of those.
+		static constexpr size_t PageSize = 0x1000;
+
+		virtual const uint8_t* GetReadPage(Address a_Address) const
+		{
+			return nullptr;
+		}
+
+		virtual uint8_t* GetWritePage(Address a_Address)
+		{
+			return nullptr;
+		}
 	};
 
 	template <typename T>
@@ -0,0 +1,184 @@
+#ifndef H_AMBER_COMMON_PAGEDRAM
+#define H_AMBER_COMMON_PAGEDRAM
+
+#include <common/memory.hpp>
+#include <common/recordable.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace Amber::Common
+{
+	// RAM split into 4 kb pages that copies share until one of them writes to a page, so a copy only costs the
+	// pages it (or the original) dirties. Pages can be written from multiple threads as long as each copy is only
+	// used by one thread at a time.
+	template <typename T, bool BE>
+	class PagedRAM : public MemoryHelper<T, BE>, public Recordable
+	{
+		public:
+		using Address = typename Memory<T>::Address;
+
+		static constexpr size_t PageBits = 12;
+		static constexpr size_t PageSize = size_t(1) << PageBits;
+		static constexpr size_t PageMask = PageSize - 1;
+		static_assert(PageSize == Memory<T>::PageSize);
+
+		explicit PagedRAM(size_t a_Size):
+			m_Size(a_Size),
+			m_Pages((a_Size + PageMask) >> PageBits),
+			m_RecorderMember("Data", RecorderMemberType::Raw, a_Size)
+		{
+			for (auto& page : m_Pages)
+			{
+				page.reset(new uint8_t[PageSize]());
+			}
+		}
+
+		PagedRAM(const void* a_Data, size_t a_Size):
+			PagedRAM(a_Size)
+		{
+			Write(0, a_Data, a_Size);
+		}
+
+		PagedRAM(const PagedRAM& a_Other) = default;
+		PagedRAM& operator=(const PagedRAM& a_Other) = default;
+
+		size_t GetSize() const noexcept
+		{
+			return m_Size;
+		}
+
+		// Pages this memory shares with a copy of it
+		size_t GetSharedPageCount() const noexcept
+		{
+			return std::count_if(m_Pages.begin(), m_Pages.end(), [](const auto& a_Page) { return a_Page.use_count() > 1; });
+		}
+
+		void Read(size_t a_Offset, void* a_Destination, size_t a_Size) const noexcept
+		{
+			auto* destination = static_cast<uint8_t*>(a_Destination);
+			while (a_Size != 0)
+			{
+				const size_t offset = a_Offset & PageMask;
+				const size_t size = std::min(a_Size, PageSize - offset);
+				std::memcpy(destination, m_Pages[a_Offset >> PageBits].get() + offset, size);
+
+				destination += size;
+				a_Offset += size;
+				a_Size -= size;
+			}
+		}
+
+		void Write(size_t a_Offset, const void* a_Source, size_t a_Size)
+		{
+			const auto* source = static_cast<const uint8_t*>(a_Source);
+			while (a_Size != 0)
+			{
+				const size_t offset = a_Offset & PageMask;
+				const size_t size = std::min(a_Size, PageSize - offset);
+				std::memcpy(GetWritablePage(a_Offset >> PageBits) + offset, source, size);
+
+				source += size;
+				a_Offset += size;
+				a_Size -= size;
+			}
+		}
+
+		uint8_t Load8(Address a_Address) const override
+		{
+			return m_Pages[a_Address >> PageBits][a_Address & PageMask];
+		}
+
+		void Store8(Address a_Address, uint8_t a_Value) override
+		{
+			GetWritablePage(a_Address >> PageBits)[a_Address & PageMask] = a_Value;
+		}
+
+		const uint8_t* GetReadPage(Address a_Address) const override
+		{
+			return a_Address + PageSize <= m_Size ? m_Pages[a_Address >> PageBits].get() : nullptr;
+		}
+
+		// Shared pages are only written through Store8, which gives this memory its own copy first
+		uint8_t* GetWritePage(Address a_Address) override
+		{
+			if (a_Address + PageSize > m_Size || m_Pages[a_Address >> PageBits].use_count() > 1)
+			{
+				return nullptr;
+			}
+
+			return GetWritablePage(a_Address >> PageBits);
+		}
+
+		size_t GetRecorderMemberCount() const noexcept override
+		{
+			return 1;
+		}
+
+		const RecorderMemberDescription& GetRecorderMember(size_t a_Index) const noexcept override
+		{
+			return m_RecorderMember;
+		}
+
+		void SaveRecorderState(ByteWriter& a_Writer) const noexcept override
+		{
+			for (size_t i = 0; i < m_Pages.size(); ++i)
+			{
+				a_Writer.Write(m_Pages[i].get(), GetPageSize(i));
+			}
+		}
+
+		// Pages that already hold the loaded contents stay shared
+		void LoadRecorderState(ByteReader& a_Reader) noexcept override
+		{
+			uint8_t page[PageSize];
+			for (size_t i = 0; i < m_Pages.size(); ++i)
+			{
+				const size_t size = GetPageSize(i);
+				a_Reader.Read(page, size);
+				if (std::memcmp(m_Pages[i].get(), page, size) != 0)
+				{
+					std::memcpy(GetWritablePage(i), page, size);
+				}
+			}
+		}
+
+		private:
+		size_t GetPageSize(size_t a_Page) const noexcept
+		{
+			return std::min(PageSize, m_Size - (a_Page << PageBits));
+		}
+
+		uint8_t* GetWritablePage(size_t a_Page)
+		{
+			auto& page = m_Pages[a_Page];
+			if (page.use_count() > 1)
+			{
+				std::shared_ptr<uint8_t[]> copy(new uint8_t[PageSize]);
+				std::memcpy(copy.get(), page.get(), PageSize);
+				page = std::move(copy);
+			}
+			else
+			{
+				// Pairs with the release of the last other copy, which may have read the page on another thread
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
+
+			return page.get();
+		}
+
+		size_t m_Size;
+		std::vector<std::shared_ptr<uint8_t[]>> m_Pages;
+		RecorderMemberDescription m_RecorderMember;
+	};
+
+	template <bool BE> using PagedRAM8  = PagedRAM<uint8_t, BE>;
+	template <bool BE> using PagedRAM16 = PagedRAM<uint16_t, BE>;
+	template <bool BE> using PagedRAM32 = PagedRAM<uint32_t, BE>;
+	template <bool BE> using PagedRAM64 = PagedRAM<uint64_t, BE>;
+}
+
+#endif
\ No newline at end of file
@@ -1,16 +1,18 @@
 #ifndef H_AMBER_COMMON_RAM
 #define H_AMBER_COMMON_RAM
 
+#include <common/recordable.hpp>
 #include <common/rom.hpp>
 
 namespace Amber::Common
 {
 	template <typename T, bool BE>
-	class RAM : public ROM<T, BE>
+	class RAM : public ROM<T, BE>, public Recordable
 	{
 		public:
 		explicit RAM(size_t a_Size):
-			ROM(a_Size)
+			ROM(a_Size),
+			m_RecorderMember("Data", RecorderMemberType::Raw, a_Size)
 		{
 		}
 		
@@ -18,6 +20,34 @@ namespace Amber::Common
 		{
 			GetData()[a_Address] = a_Value;
 		}
+
+		uint8_t* GetWritePage(Address a_Address) override
+		{
+			return a_Address + Memory<T>::PageSize <= GetSize() ? GetData() + a_Address : nullptr;
+		}
+
+		size_t GetRecorderMemberCount() const noexcept override
+		{
+			return 1;
+		}
+
+		const RecorderMemberDescription& GetRecorderMember(size_t a_Index) const noexcept override
+		{
+			return m_RecorderMember;
+		}
+
+		void SaveRecorderState(ByteWriter& a_Writer) const noexcept override
+		{
+			a_Writer.Write(GetData(), GetSize());
+		}
+
+		void LoadRecorderState(ByteReader& a_Reader) noexcept override
+		{
+			a_Reader.Read(GetData(), GetSize());
+		}
+
+		private:
+		RecorderMemberDescription m_RecorderMember;
 	};
 
 	template <bool BE> using RAM8  = RAM<uint8_t, BE>;
@@ -0,0 +1,29 @@
+#include <common/recordable.hpp>
+
+using namespace Amber;
+using namespace Common;
+
+Recordable::~Recordable() noexcept = default;
+
+size_t Recordable::GetRecorderStateSize() const noexcept
+{
+	size_t size = 0;
+	for (size_t i = 0; i < GetRecorderMemberCount(); ++i)
+	{
+		size += GetRecorderMember(i).GetSize();
+	}
+
+	return size;
+}
+
+RecorderChannelDescription Recordable::GetRecorderChannelDescription(std::string_view a_Name) const
+{
+	RecorderChannelDescription description;
+	description.SetName(a_Name);
+	for (size_t i = 0; i < GetRecorderMemberCount(); ++i)
+	{
+		description.AddMember(GetRecorderMember(i));
+	}
+
+	return description;
+}
\ No newline at end of file
@@ -2,10 +2,15 @@
 #define H_AMBER_COMMON_RECORDABLE
 
 #include <common/api.hpp>
+#include <common/bytereader.hpp>
+#include <common/bytewriter.hpp>
+#include <common/recorderchanneldescription.hpp>
 #include <common/recordermemberdescription.hpp>
 
 namespace Amber::Common
 {
+	// Something whose state can be stored in a recorder channel. The state is laid out as its members back to back in
+	// the order they are described, typed members in host byte order.
 	class COMMON_API Recordable
 	{
 		public:
@@ -13,6 +18,13 @@ namespace Amber::Common
 
 		virtual size_t GetRecorderMemberCount() const noexcept = 0;
 		virtual const RecorderMemberDescription& GetRecorderMember(size_t a_Index) const noexcept = 0;
+
+		// Writes or reads exactly GetRecorderStateSize() bytes
+		virtual void SaveRecorderState(ByteWriter& a_Writer) const noexcept = 0;
+		virtual void LoadRecorderState(ByteReader& a_Reader) noexcept = 0;
+
+		size_t GetRecorderStateSize() const noexcept;
+		RecorderChannelDescription GetRecorderChannelDescription(std::string_view a_Name) const;
 	};
 }
 
@@ -1,23 +1,264 @@
 #include <common/recorder.hpp>
 
-#include <set>
+#include <common/bytereader.hpp>
+#include <common/bytewriter.hpp>
+#include <common/exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <vector>
 
 using namespace Amber;
 using namespace Common;
 
+namespace
+{
+	constexpr size_t MaximumVLQSize = (sizeof(size_t) * 8 + 6) / 7;
+
+	size_t WriteVLQ(uint8_t* a_Output, size_t a_Value) noexcept
+	{
+		size_t size = 0;
+		while (a_Value >= 0b1000'0000)
+		{
+			a_Output[size++] = static_cast<uint8_t>(a_Value) | 0b1000'0000;
+			a_Value >>= 7;
+		}
+		a_Output[size++] = static_cast<uint8_t>(a_Value);
+
+		return size;
+	}
+
+	const uint8_t* ReadVLQ(const uint8_t* a_Input, size_t& a_Value) noexcept
+	{
+		a_Value = 0;
+		for (size_t shift = 0;; shift += 7)
+		{
+			const uint8_t byte = *a_Input++;
+			a_Value |= static_cast<size_t>(byte & 0b0111'1111) << shift;
+
+			if ((byte & 0b1000'0000) == 0)
+			{
+				return a_Input;
+			}
+		}
+	}
+
+	// Encodes a_Current XOR a_Previous as pairs of (unchanged byte count, changed byte count) followed by the changed
+	// bytes XORed. Unchanged bytes at the end are left implicit, so an unchanged channel encodes to nothing.
+	size_t EncodeDelta(const uint8_t* a_Current, const uint8_t* a_Previous, size_t a_Size, uint8_t* a_Output) noexcept
+	{
+		uint8_t* output = a_Output;
+		size_t position = 0;
+
+		for (;;)
+		{
+			const size_t unchanged_start = position;
+
+			// Most of a frame doesn't change, so skip unchanged bytes a word at a time first
+			for (; position + sizeof(uint64_t) <= a_Size; position += sizeof(uint64_t))
+			{
+				uint64_t current;
+				uint64_t previous;
+				std::memcpy(&current, a_Current + position, sizeof(current));
+				std::memcpy(&previous, a_Previous + position, sizeof(previous));
+
+				if (current != previous)
+				{
+					break;
+				}
+			}
+
+			while (position < a_Size && a_Current[position] == a_Previous[position])
+			{
+				++position;
+			}
+
+			if (position == a_Size)
+			{
+				break;
+			}
+
+			const size_t changed_start = position;
+			while (position < a_Size && a_Current[position] != a_Previous[position])
+			{
+				++position;
+			}
+
+			output += WriteVLQ(output, changed_start - unchanged_start);
+			output += WriteVLQ(output, position - changed_start);
+			for (size_t i = changed_start; i < position; ++i)
+			{
+				*output++ = a_Current[i] ^ a_Previous[i];
+			}
+		}
+
+		return output - a_Output;
+	}
+
+	// Journal layout: a header describing the recorder padded to JournalHeaderSize, followed by blocks. Each block
+	// starts with a JournalBlockHeader and a table of JournalFrameEntry that grows forward, while frame data grows
+	// backward from the end of the block. A frame only counts once the block header's frame count includes it.
+	constexpr char JournalMagic[8] = { 'A', 'M', 'B', 'E', 'R', 'R', 'E', 'C' };
+	constexpr uint32_t JournalVersion = 1;
+	constexpr size_t JournalHeaderSize = MappedFile::Alignment;
+	constexpr uint32_t JournalBlockMagic = 0x4B4C4223; // "#BLK"
+	constexpr uint32_t JournalKeyframeBit = 0x8000'0000;
+
+	struct JournalBlockHeader
+	{
+		uint32_t m_Magic;
+		uint32_t m_FrameCount;
+		uint64_t m_Size;
+	};
+
+	struct JournalFrameEntry
+	{
+		uint32_t m_Offset;
+		uint32_t m_Size; // Keyframes have JournalKeyframeBit set
+	};
+
+	JournalBlockHeader& GetJournalBlockHeader(uint8_t* a_Block) noexcept
+	{
+		return *reinterpret_cast<JournalBlockHeader*>(a_Block);
+	}
+
+	RecorderDescription ReadJournalHeader(MappedFile& a_Journal)
+	{
+		if (a_Journal.GetSize() < JournalHeaderSize)
+		{
+			throw Exception("Not a recorder journal");
+		}
+
+		// Copy the header out of the mapping so nothing has to be cleaned up if it turns out to be corrupt
+		std::vector<uint8_t> header(JournalHeaderSize);
+		void* const mapping = a_Journal.Map(0, JournalHeaderSize);
+		std::memcpy(header.data(), mapping, header.size());
+		a_Journal.Unmap(mapping, JournalHeaderSize);
+
+		ByteReader reader(header.data(), header.size());
+		const auto read = [&reader](auto& a_Value)
+		{
+			if (reader.Read(a_Value) != sizeof(a_Value))
+			{
+				throw Exception("Corrupt recorder journal header");
+			}
+		};
+		const auto read_string = [&]()
+		{
+			uint32_t length;
+			read(length);
+			if (length > reader.GetSize() - reader.GetPosition())
+			{
+				throw Exception("Corrupt recorder journal header");
+			}
+
+			std::string string(reinterpret_cast<const char*>(header.data()) + reader.GetPosition(), length);
+			reader.SetPosition(reader.GetPosition() + length);
+			return string;
+		};
+
+		char magic[sizeof(JournalMagic)];
+		uint32_t version;
+		read(magic);
+		read(version);
+		if (std::memcmp(magic, JournalMagic, sizeof(magic)) != 0)
+		{
+			throw Exception("Not a recorder journal");
+		}
+		if (version != JournalVersion)
+		{
+			throw Exception("Unsupported recorder journal version");
+		}
+
+		uint64_t block_size;
+		uint64_t keyframe_interval;
+		uint64_t keyframe_byte_budget;
+		uint32_t channel_count;
+		read(block_size);
+		read(keyframe_interval);
+		read(keyframe_byte_budget);
+		read(channel_count);
+
+		RecorderDescription description;
+		description.SetBlockSize(static_cast<size_t>(block_size));
+		description.SetKeyframeInterval(static_cast<size_t>(keyframe_interval));
+		description.SetKeyframeByteBudget(static_cast<size_t>(keyframe_byte_budget));
+
+		for (uint32_t channel = 0; channel < channel_count; ++channel)
+		{
+			RecorderChannelDescription channel_description;
+			channel_description.SetName(read_string());
+
+			uint8_t journaled;
+			uint32_t member_count;
+			read(journaled);
+			read(member_count);
+			channel_description.SetJournaled(journaled != 0);
+
+			for (uint32_t member = 0; member < member_count; ++member)
+			{
+				RecorderMemberDescription member_description;
+				member_description.SetName(read_string());
+
+				uint64_t size;
+				uint8_t type;
+				read(size);
+				read(type);
+				member_description.SetSize(static_cast<size_t>(size));
+				member_description.SetType(static_cast<RecorderMemberType::Enum>(type));
+
+				channel_description.AddMember(member_description);
+			}
+
+			description.AddChannel(channel_description);
+		}
+
+		return description;
+	}
+
+	void ApplyDelta(const uint8_t* a_Delta, size_t a_Size, uint8_t* a_State) noexcept
+	{
+		const uint8_t* const end = a_Delta + a_Size;
+
+		while (a_Delta != end)
+		{
+			size_t unchanged;
+			size_t changed;
+			a_Delta = ReadVLQ(a_Delta, unchanged);
+			a_Delta = ReadVLQ(a_Delta, changed);
+
+			a_State += unchanged;
+			for (size_t i = 0; i < changed; ++i)
+			{
+				*a_State++ ^= *a_Delta++;
+			}
+		}
+	}
+}
+
 Recorder::Recorder(const RecorderDescription& a_Description):
 	m_Description(a_Description)
 {
+	size_t working_buffer_size = 0;
 	for (size_t i = 0; i < m_Description.GetChannelCount(); ++i)
 	{
-		const size_t channel_size = m_Description.GetChannel(i).GetSize();
+		const auto& channel_description = m_Description.GetChannel(i);
+		const size_t channel_size = channel_description.GetSize();
 
 		ChannelInfo channel_info{};
 		channel_info.m_Offset = m_FrameSize;
 		channel_info.m_Size = channel_size;
+		channel_info.m_Journaled = channel_description.IsJournaled();
 		m_Channels.push_back(channel_info);
 
+		m_Journaled |= channel_info.m_Journaled;
+
 		m_FrameSize += channel_size;
+
+		// Worst case a delta alternates between one changed and one unchanged byte, costing three bytes for every two
+		working_buffer_size += MaximumVLQSize * 4 + channel_size * 2;
 	}
 
 	m_CurrentFrameState = std::make_unique<uint8_t[]>(m_FrameSize);
@@ -25,7 +266,35 @@ Recorder::Recorder(const RecorderDescription& a_Description):
 	std::memset(m_CurrentFrameState.get(), 0, m_FrameSize);
 	std::memset(m_LastFrameState.get(), 0, m_FrameSize);
 
-	AllocateNewBuffer();
+	m_WorkingBuffer.resize(working_buffer_size);
+}
+
+Recorder::Recorder(const RecorderDescription& a_Description, std::string_view a_JournalPath):
+	Recorder(a_Description)
+{
+	m_Journal = std::make_unique<MappedFile>(a_JournalPath, true);
+	WriteJournalHeader();
+}
+
+Recorder::~Recorder() noexcept
+{
+	if (m_Journal)
+	{
+		for (const auto& buffer : m_Buffers)
+		{
+			m_Journal->Unmap(buffer.m_Data, buffer.m_Size);
+		}
+	}
+}
+
+std::unique_ptr<Recorder> Recorder::OpenJournal(std::string_view a_Path)
+{
+	auto journal = std::make_unique<MappedFile>(a_Path, false);
+	auto recorder = std::make_unique<Recorder>(ReadJournalHeader(*journal));
+	recorder->m_Journal = std::move(journal);
+	recorder->LoadJournal();
+
+	return recorder;
 }
 
 const RecorderDescription& Recorder::GetDescription() const noexcept
@@ -35,29 +304,38 @@ const RecorderDescription& Recorder::GetDescription() const noexcept
 
 size_t Recorder::GetFrameCount() const noexcept
 {
-	return m_Frames.size();
+	return m_FirstFrame + m_Frames.size() + (m_FrameOpen ? 1 : 0);
 }
 
-size_t Recorder::NewFrame()
+size_t Recorder::GetFirstFrame() const noexcept
 {
-	Frame frame = {};
-	if (m_Buffers.back().m_Size - m_Buffers.back().m_Used < m_FrameSize)
+	return m_FirstFrame;
+}
+
+size_t Recorder::GetKeyframeCount() const noexcept
+{
+	return m_Keyframes.size();
+}
+
+size_t Recorder::GetMemoryUsage() const noexcept
+{
+	size_t usage = 0;
+	for (const auto& buffer : m_Buffers)
 	{
-		AllocateNewBuffer();
+		usage += buffer.m_Size;
 	}
 
-	auto& buffer = m_Buffers.back();
-	frame.m_Data = buffer.m_Data.get() + buffer.m_Used;
-	std::memcpy(frame.m_Data, m_CurrentFrameState.get(), m_FrameSize);
-	buffer.m_Used += m_FrameSize;
+	return usage;
+}
 
-	const size_t frame_index = m_Frames.size();
-	m_Frames.push_back(frame);
+size_t Recorder::NewFrame()
+{
+	CommitFrame();
 
-	m_CurrentFrame = frame_index;
-	std::memcpy(m_LastFrameState.get(), m_CurrentFrameState.get(), m_FrameSize);
+	m_FrameOpen = true;
+	m_CurrentFrame = GetFrameCount() - 1;
 
-	return frame_index;
+	return m_CurrentFrame;
 }
 
 size_t Recorder::GetCurrentFrame() const noexcept
@@ -65,16 +343,63 @@ size_t Recorder::GetCurrentFrame() const noexcept
 	return m_CurrentFrame;
 }
 
-void Recorder::SetCurrentFrame(size_t a_Frame) noexcept
+void Recorder::SetCurrentFrame(size_t a_Frame)
 {
-	if (m_CurrentFrame == a_Frame)
+	CommitFrame();
+
+	if (m_Frames.empty())
 	{
 		return;
 	}
 
+	a_Frame = std::clamp(a_Frame, m_FirstFrame, m_FirstFrame + m_Frames.size() - 1);
+	if (m_CurrentFrame == a_Frame && !m_CurrentFrameModified)
+	{
+		return;
+	}
+
+	// Pick whichever of stepping from the current frame (in either direction) or replaying from the keyframe touches
+	// the fewest frames. Deltas can't be stepped across a keyframe, since keyframes don't store one, and a journaled
+	// recording can't be stepped back at all, since the replayed channels have no deltas.
+	const size_t keyframe = FindKeyframe(a_Frame);
+	const bool current_frame_valid = !m_CurrentFrameModified && m_CurrentFrame >= keyframe;
+
+	if (current_frame_valid && a_Frame > m_CurrentFrame)
+	{
+		for (size_t frame = m_CurrentFrame + 1; frame <= a_Frame; ++frame)
+		{
+			ReplayFrame(frame);
+		}
+	}
+	else if (current_frame_valid && !m_Journaled && m_CurrentFrame - a_Frame <= a_Frame - keyframe && FindKeyframe(m_CurrentFrame) == keyframe)
+	{
+		for (size_t frame = m_CurrentFrame; frame > a_Frame; --frame)
+		{
+			ApplyFrame(frame);
+		}
+	}
+	else
+	{
+		ApplyFrame(keyframe);
+		for (size_t frame = keyframe + 1; frame <= a_Frame; ++frame)
+		{
+			ReplayFrame(frame);
+		}
+	}
+
 	m_CurrentFrame = a_Frame;
-	auto& current_frame = m_Frames[m_CurrentFrame];
-	std::memcpy(m_CurrentFrameState.get(), current_frame.m_Data, m_FrameSize);
+	m_CurrentFrameModified = false;
+
+	// The state no longer follows on from the last stored frame, so the next frame has to compare every channel
+	for (auto& channel_info : m_Channels)
+	{
+		channel_info.m_Dirty = true;
+	}
+}
+
+void Recorder::ForceKeyframe() noexcept
+{
+	m_ForceKeyframe = true;
 }
 
 void Recorder::WriteChannelData(size_t a_Channel, const void* a_Data)
@@ -82,6 +407,17 @@ void Recorder::WriteChannelData(size_t a_Channel, const void* a_Data)
 	auto& channel_info = m_Channels[a_Channel];
 	std::memcpy(m_CurrentFrameState.get() + channel_info.m_Offset, a_Data, channel_info.m_Size);
 	channel_info.m_Dirty = true;
+	m_CurrentFrameModified = true;
+}
+
+RecorderReplayer* Recorder::GetReplayer() const noexcept
+{
+	return m_Replayer;
+}
+
+void Recorder::SetReplayer(RecorderReplayer* a_Replayer) noexcept
+{
+	m_Replayer = a_Replayer;
 }
 
 const void* Recorder::ReadChannelData(size_t a_Channel) const noexcept
@@ -90,11 +426,399 @@ const void* Recorder::ReadChannelData(size_t a_Channel) const noexcept
 	return m_CurrentFrameState.get() + channel_info.m_Offset;
 }
 
-void Recorder::AllocateNewBuffer()
+void Recorder::CommitFrame()
+{
+	if (!m_FrameOpen)
+	{
+		return;
+	}
+
+	const size_t frame_index = GetFrameCount() - 1;
+	const size_t keyframe_interval = m_Description.GetKeyframeInterval();
+
+	const size_t keyframe_byte_budget = m_Description.GetKeyframeByteBudget();
+
+	Frame frame = {};
+	frame.m_Keyframe = m_ForceKeyframe || m_Frames.empty() || (keyframe_interval != 0 && frame_index % keyframe_interval == 0) || (keyframe_byte_budget != 0 && m_BytesSinceKeyframe >= keyframe_byte_budget);
+
+	if (!frame.m_Keyframe)
+	{
+		uint8_t* output = m_WorkingBuffer.data();
+		for (size_t channel = 0; channel < m_Channels.size(); ++channel)
+		{
+			const auto& channel_info = m_Channels[channel];
+			if (!channel_info.m_Dirty || (m_Journaled && !channel_info.m_Journaled))
+			{
+				continue;
+			}
+
+			// Encode past the space reserved for the header, then move it back once the size is known
+			uint8_t* const payload = output + MaximumVLQSize * 2;
+			const size_t payload_size = EncodeDelta(m_CurrentFrameState.get() + channel_info.m_Offset, m_LastFrameState.get() + channel_info.m_Offset, channel_info.m_Size, payload);
+			if (payload_size == 0)
+			{
+				continue;
+			}
+
+			output += WriteVLQ(output, channel);
+			output += WriteVLQ(output, payload_size);
+			std::memmove(output, payload, payload_size);
+			output += payload_size;
+		}
+
+		frame.m_Size = output - m_WorkingBuffer.data();
+		frame.m_Data = AllocateFrameData(frame.m_Size);
+
+		// Making room may have dropped the frame this delta is against, in which case it becomes a keyframe
+		if (m_Frames.empty())
+		{
+			frame.m_Keyframe = true;
+		}
+		else
+		{
+			std::memcpy(frame.m_Data, m_WorkingBuffer.data(), frame.m_Size);
+		}
+	}
+
+	if (frame.m_Keyframe)
+	{
+		frame.m_Size = m_FrameSize;
+		frame.m_Data = AllocateFrameData(frame.m_Size);
+		std::memcpy(frame.m_Data, m_CurrentFrameState.get(), m_FrameSize);
+	}
+
+	frame.m_Buffer = m_FirstBuffer + m_Buffers.size() - 1;
+	m_Frames.push_back(frame);
+
+	if (m_Journal)
+	{
+		AppendJournalFrame(frame);
+	}
+
+	if (frame.m_Keyframe)
+	{
+		m_Keyframes.push_back(frame_index);
+		m_BytesSinceKeyframe = 0;
+	}
+	else
+	{
+		m_BytesSinceKeyframe += frame.m_Size;
+	}
+	m_FrameOpen = false;
+	m_ForceKeyframe = false;
+
+	for (auto& channel_info : m_Channels)
+	{
+		if (channel_info.m_Dirty)
+		{
+			std::memcpy(m_LastFrameState.get() + channel_info.m_Offset, m_CurrentFrameState.get() + channel_info.m_Offset, channel_info.m_Size);
+			channel_info.m_Dirty = false;
+		}
+	}
+
+	m_CurrentFrame = frame_index;
+	m_CurrentFrameModified = false;
+}
+
+uint8_t* Recorder::AllocateFrameData(size_t a_Size)
+{
+	if (m_Journal)
+	{
+		// Leave room for the frame's entry in the block's frame table
+		const auto get_free_space = [](const Buffer& a_Buffer)
+		{
+			const size_t used = sizeof(JournalBlockHeader) + (GetJournalBlockHeader(a_Buffer.m_Data).m_FrameCount + 1) * sizeof(JournalFrameEntry) + a_Buffer.m_Used;
+			return used < a_Buffer.m_Size ? a_Buffer.m_Size - used : 0;
+		};
+
+		if (m_Buffers.empty() || get_free_space(m_Buffers.back()) < a_Size)
+		{
+			AllocateNewBuffer(sizeof(JournalBlockHeader) + sizeof(JournalFrameEntry) + a_Size);
+		}
+
+		auto& buffer = m_Buffers.back();
+		buffer.m_Used += a_Size;
+
+		return buffer.m_Data + buffer.m_Size - buffer.m_Used;
+	}
+
+	if (m_Buffers.empty() || m_Buffers.back().m_Size - m_Buffers.back().m_Used < a_Size)
+	{
+		AllocateNewBuffer(a_Size);
+	}
+
+	auto& buffer = m_Buffers.back();
+	uint8_t* const data = buffer.m_Data + buffer.m_Used;
+	buffer.m_Used += a_Size;
+
+	return data;
+}
+
+void Recorder::AllocateNewBuffer(size_t a_MinimumSize)
 {
 	Buffer buffer = {};
-	buffer.m_Size = m_Description.GetBlockSize();
-	buffer.m_Data = std::make_unique<uint8_t[]>(buffer.m_Size);
+	buffer.m_Size = std::max(m_Description.GetBlockSize(), a_MinimumSize);
+
+	if (m_Journal)
+	{
+		// Blocks are appended to the end of the file, which always ends on a block boundary
+		buffer.m_Size = (buffer.m_Size + MappedFile::Alignment - 1) & ~(MappedFile::Alignment - 1);
+		if (buffer.m_Size > std::numeric_limits<uint32_t>::max())
+		{
+			throw Exception("Recorder journal blocks are limited to 4 gb");
+		}
+
+		const uint64_t offset = m_Journal->GetSize();
+		m_Journal->Resize(offset + buffer.m_Size);
+		buffer.m_Data = static_cast<uint8_t*>(m_Journal->Map(offset, buffer.m_Size));
+
+		auto& header = GetJournalBlockHeader(buffer.m_Data);
+		header.m_FrameCount = 0;
+		header.m_Size = buffer.m_Size;
+		header.m_Magic = JournalBlockMagic;
+
+		m_Buffers.emplace_back(std::move(buffer));
+		return;
+	}
+
+	// Make room by forgetting the oldest history, reusing its memory when it's large enough
+	const size_t budget = m_Description.GetMemoryBudget();
+	while (budget != 0 && !m_Buffers.empty() && GetMemoryUsage() + buffer.m_Size > budget)
+	{
+		Buffer oldest = DropOldestBuffer();
+		if (!buffer.m_Memory && oldest.m_Size >= buffer.m_Size)
+		{
+			buffer.m_Memory = std::move(oldest.m_Memory);
+			buffer.m_Size = oldest.m_Size;
+		}
+	}
+
+	if (!buffer.m_Memory)
+	{
+		// Frames are written before they are read, no need to clear the memory
+		buffer.m_Memory.reset(new uint8_t[buffer.m_Size]);
+	}
 
+	buffer.m_Data = buffer.m_Memory.get();
 	m_Buffers.emplace_back(std::move(buffer));
+}
+
+Recorder::Buffer Recorder::DropOldestBuffer()
+{
+	Buffer buffer = std::move(m_Buffers.front());
+	m_Buffers.erase(m_Buffers.begin());
+
+	// Drop every frame stored in the buffer, then every delta left without a keyframe to start from
+	while (!m_Frames.empty() && (m_Frames.front().m_Buffer == m_FirstBuffer || !m_Frames.front().m_Keyframe))
+	{
+		if (m_Frames.front().m_Keyframe)
+		{
+			m_Keyframes.pop_front();
+		}
+
+		m_Frames.pop_front();
+		++m_FirstFrame;
+	}
+
+	++m_FirstBuffer;
+	buffer.m_Used = 0;
+
+	return buffer;
+}
+
+size_t Recorder::FindKeyframe(size_t a_Frame) const noexcept
+{
+	// The oldest stored frame is always a keyframe, so there is one at or before any stored frame
+	return *(std::upper_bound(m_Keyframes.begin(), m_Keyframes.end(), a_Frame) - 1);
+}
+
+const Recorder::Frame& Recorder::GetFrame(size_t a_Frame) const noexcept
+{
+	return m_Frames[a_Frame - m_FirstFrame];
+}
+
+void Recorder::ApplyFrame(size_t a_Frame) noexcept
+{
+	const auto& frame = GetFrame(a_Frame);
+
+	if (frame.m_Keyframe)
+	{
+		std::memcpy(m_CurrentFrameState.get(), frame.m_Data, m_FrameSize);
+		return;
+	}
+
+	const uint8_t* data = frame.m_Data;
+	const uint8_t* const end = data + frame.m_Size;
+	while (data != end)
+	{
+		size_t channel;
+		size_t size;
+		data = ReadVLQ(data, channel);
+		data = ReadVLQ(data, size);
+
+		ApplyDelta(data, size, m_CurrentFrameState.get() + m_Channels[channel].m_Offset);
+		data += size;
+	}
+}
+
+void Recorder::ReplayFrame(size_t a_Frame)
+{
+	ApplyFrame(a_Frame);
+
+	if (m_Journaled && m_Replayer != nullptr)
+	{
+		m_Replayer->ReplayFrame(*this, a_Frame);
+	}
+}
+
+void Recorder::WriteJournalHeader()
+{
+	m_Journal->Resize(JournalHeaderSize);
+	void* const header = m_Journal->Map(0, JournalHeaderSize);
+
+	ByteWriter writer(header, JournalHeaderSize);
+	bool complete = true;
+	const auto write = [&](const void* a_Data, size_t a_Size)
+	{
+		complete &= writer.Write(a_Data, a_Size) == a_Size;
+	};
+	const auto write_string = [&](std::string_view a_String)
+	{
+		const uint32_t length = static_cast<uint32_t>(a_String.size());
+		write(&length, sizeof(length));
+		write(a_String.data(), a_String.size());
+	};
+
+	const uint64_t block_size = m_Description.GetBlockSize();
+	const uint64_t keyframe_interval = m_Description.GetKeyframeInterval();
+	const uint64_t keyframe_byte_budget = m_Description.GetKeyframeByteBudget();
+	const uint32_t channel_count = static_cast<uint32_t>(m_Description.GetChannelCount());
+	write(JournalMagic, sizeof(JournalMagic));
+	write(&JournalVersion, sizeof(JournalVersion));
+	write(&block_size, sizeof(block_size));
+	write(&keyframe_interval, sizeof(keyframe_interval));
+	write(&keyframe_byte_budget, sizeof(keyframe_byte_budget));
+	write(&channel_count, sizeof(channel_count));
+
+	for (uint32_t channel = 0; channel < channel_count; ++channel)
+	{
+		const auto& channel_description = m_Description.GetChannel(channel);
+		const uint8_t journaled = channel_description.IsJournaled() ? 1 : 0;
+		const uint32_t member_count = static_cast<uint32_t>(channel_description.GetMemberCount());
+		write_string(channel_description.GetName());
+		write(&journaled, sizeof(journaled));
+		write(&member_count, sizeof(member_count));
+
+		for (uint32_t member = 0; member < member_count; ++member)
+		{
+			const auto& member_description = channel_description.GetMember(member);
+			const uint64_t size = member_description.GetSize();
+			const uint8_t type = static_cast<uint8_t>(member_description.GetType());
+			write_string(member_description.GetName());
+			write(&size, sizeof(size));
+			write(&type, sizeof(type));
+		}
+	}
+
+	m_Journal->Unmap(header, JournalHeaderSize);
+
+	if (!complete)
+	{
+		throw Exception("Recorder description doesn't fit in a journal header");
+	}
+}
+
+void Recorder::LoadJournal()
+{
+	// Windows can't shrink a file while views of it are mapped, so the valid blocks are found from their headers alone
+	// and the torn tail is cut off before any block gets mapped
+	std::vector<uint64_t> block_sizes;
+	uint64_t end = JournalHeaderSize;
+	while (end + MappedFile::Alignment <= m_Journal->GetSize())
+	{
+		// The block's size isn't known until its header has been read
+		JournalBlockHeader header;
+		void* const peek = m_Journal->Map(end, MappedFile::Alignment);
+		std::memcpy(&header, peek, sizeof(header));
+		m_Journal->Unmap(peek, MappedFile::Alignment);
+
+		if (header.m_Magic != JournalBlockMagic || header.m_Size < MappedFile::Alignment || header.m_Size % MappedFile::Alignment != 0 || end + header.m_Size > m_Journal->GetSize())
+		{
+			break;
+		}
+
+		block_sizes.push_back(header.m_Size);
+		end += header.m_Size;
+	}
+
+	// Anything past the last valid block was being appended when the process died
+	if (end < m_Journal->GetSize())
+	{
+		m_Journal->Resize(end);
+	}
+
+	uint64_t offset = JournalHeaderSize;
+	for (const uint64_t block_size : block_sizes)
+	{
+		Buffer buffer = {};
+		buffer.m_Size = static_cast<size_t>(block_size);
+		buffer.m_Data = static_cast<uint8_t*>(m_Journal->Map(offset, buffer.m_Size));
+		const auto& header = GetJournalBlockHeader(buffer.m_Data);
+
+		// Only the frame table is read, the frame data stays on disk until a seek needs it
+		const size_t table_end = sizeof(JournalBlockHeader) + header.m_FrameCount * sizeof(JournalFrameEntry);
+		size_t data_start = buffer.m_Size;
+		for (uint32_t i = 0; i < header.m_FrameCount && table_end <= buffer.m_Size; ++i)
+		{
+			JournalFrameEntry entry;
+			std::memcpy(&entry, buffer.m_Data + sizeof(JournalBlockHeader) + i * sizeof(JournalFrameEntry), sizeof(entry));
+
+			Frame frame = {};
+			frame.m_Data = buffer.m_Data + entry.m_Offset;
+			frame.m_Size = entry.m_Size & ~JournalKeyframeBit;
+			frame.m_Buffer = m_Buffers.size();
+			frame.m_Keyframe = (entry.m_Size & JournalKeyframeBit) != 0;
+
+			if (entry.m_Offset < table_end || entry.m_Offset + frame.m_Size > buffer.m_Size || (m_Frames.empty() && !frame.m_Keyframe))
+			{
+				throw Exception("Corrupt recorder journal");
+			}
+
+			if (frame.m_Keyframe)
+			{
+				m_Keyframes.push_back(m_Frames.size());
+			}
+			m_Frames.push_back(frame);
+			data_start = std::min<size_t>(data_start, entry.m_Offset);
+		}
+
+		buffer.m_Used = buffer.m_Size - data_start;
+		m_Buffers.emplace_back(std::move(buffer));
+		offset += block_size;
+	}
+
+	// Continue from the last frame, the first frame recorded from here on is a keyframe again since the state of
+	// replayed channels can't be known until a replayer is set
+	if (!m_Frames.empty())
+	{
+		m_CurrentFrameModified = true;
+		SetCurrentFrame(m_Frames.size() - 1);
+		std::memcpy(m_LastFrameState.get(), m_CurrentFrameState.get(), m_FrameSize);
+	}
+	m_ForceKeyframe = true;
+}
+
+void Recorder::AppendJournalFrame(const Frame& a_Frame) noexcept
+{
+	auto& buffer = m_Buffers.back();
+	auto& header = GetJournalBlockHeader(buffer.m_Data);
+
+	JournalFrameEntry entry;
+	entry.m_Offset = static_cast<uint32_t>(a_Frame.m_Data - buffer.m_Data);
+	entry.m_Size = static_cast<uint32_t>(a_Frame.m_Size) | (a_Frame.m_Keyframe ? JournalKeyframeBit : 0);
+	std::memcpy(buffer.m_Data + sizeof(JournalBlockHeader) + header.m_FrameCount * sizeof(JournalFrameEntry), &entry, sizeof(entry));
+
+	// The frame count is what makes the frame part of the journal, so it has to be written last
+	std::atomic_signal_fence(std::memory_order_release);
+	++header.m_FrameCount;
 }
\ No newline at end of file
@@ -4,8 +4,11 @@
 #include <common/api.hpp>
 #include <common/bytereader.hpp>
 #include <common/bytewriter.hpp>
+#include <common/mappedfile.hpp>
 #include <common/recorderdescription.hpp>
+#include <common/recorderreplayer.hpp>
 
+#include <deque>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -13,18 +16,46 @@
 
 namespace Amber::Common
 {
+	// Per-frame history of a set of channels. A frame is stored when it is left, either by starting a new frame or by
+	// seeking. Every few frames (see RecorderDescription::GetKeyframeInterval) the whole state is stored as a keyframe,
+	// all other frames only store the channels written since the previous frame, XORed with their previous contents
+	// and run-length encoded. Because XOR is its own inverse a delta also steps from a frame back to its predecessor.
+	// With a memory budget set the oldest frames are dropped, a keyframe at a time, to stay within it.
+	//
+	// If some channels are journaled (typically the inputs), only those are stored between keyframes and the rest is
+	// regenerated on seek by the replayer, re-running at most one keyframe interval worth of frames.
+	//
+	// A recorder can also keep its blocks in a journal file instead of memory. Frames are appended to the file as they
+	// are stored, so a journal survives the process dying and can be reopened later. Reopening only reads the block
+	// headers and frame tables, frame data is paged in as seeks touch it. As in memory, a frame is only stored once it's
+	// left, and journals ignore the memory budget since the file is their storage.
 	class COMMON_API Recorder
 	{
 		public:
 		Recorder(const RecorderDescription& a_Description);
+		Recorder(const RecorderDescription& a_Description, std::string_view a_JournalPath);
+		~Recorder() noexcept;
+
+		static std::unique_ptr<Recorder> OpenJournal(std::string_view a_Path);
 
 		const RecorderDescription& GetDescription() const noexcept;
 
 		size_t GetFrameCount() const noexcept;
+		size_t GetFirstFrame() const noexcept;
+		size_t GetKeyframeCount() const noexcept;
+		size_t GetMemoryUsage() const noexcept;
 		size_t NewFrame();
 
 		size_t GetCurrentFrame() const noexcept;
-		void SetCurrentFrame(size_t a_Frame) noexcept;
+		void SetCurrentFrame(size_t a_Frame);
+
+		// Stores the open frame (or the next one, if none is open) as a keyframe. A journaled recording needs this
+		// whenever the state being recorded doesn't follow on from the previous frame, the replayer couldn't
+		// regenerate it otherwise.
+		void ForceKeyframe() noexcept;
+
+		RecorderReplayer* GetReplayer() const noexcept;
+		void SetReplayer(RecorderReplayer* a_Replayer) noexcept;
 
 		void WriteChannelData(size_t a_Channel, const void* a_Data);
 		const void* ReadChannelData(size_t a_Channel) const noexcept;
@@ -33,11 +64,15 @@ namespace Amber::Common
 		struct Frame
 		{
 			uint8_t* m_Data;
+			size_t m_Size;
+			size_t m_Buffer;
+			bool m_Keyframe;
 		};
 
 		struct Buffer
 		{
-			std::unique_ptr<uint8_t[]> m_Data;
+			std::unique_ptr<uint8_t[]> m_Memory; // Null for journal blocks, which are mapped from the file
+			uint8_t* m_Data;
 			size_t m_Size;
 			size_t m_Used;
 		};
@@ -47,27 +82,48 @@ namespace Amber::Common
 			size_t m_Offset;
 			size_t m_Size;
 			bool m_Dirty;
+			bool m_Journaled;
 		};
 
 		static constexpr size_t InvalidFrame = std::numeric_limits<size_t>::max();
 
-		//void PushData(size_t a_Channel, size_t a_Size);
-		//void RestoreFrame(size_t a_Frame);
+		void CommitFrame();
+		uint8_t* AllocateFrameData(size_t a_Size);
+		void AllocateNewBuffer(size_t a_MinimumSize);
+		Buffer DropOldestBuffer();
+
+		void WriteJournalHeader();
+		void LoadJournal();
+		void AppendJournalFrame(const Frame& a_Frame) noexcept;
 
-		void AllocateNewBuffer();
+		size_t FindKeyframe(size_t a_Frame) const noexcept;
+		const Frame& GetFrame(size_t a_Frame) const noexcept;
+		void ApplyFrame(size_t a_Frame) noexcept;
+		void ReplayFrame(size_t a_Frame);
 
 		const RecorderDescription m_Description;
 
-		std::vector<Frame> m_Frames;
+		std::deque<Frame> m_Frames;
+		std::deque<size_t> m_Keyframes; // Sorted, for binary searching the keyframe a seek has to start from
 		std::vector<Buffer> m_Buffers;
 
 		size_t m_FrameSize = 0;
+		size_t m_FirstFrame = 0;
+		size_t m_FirstBuffer = 0;
 		size_t m_CurrentFrame = 0;
+		bool m_FrameOpen = false;
+		bool m_CurrentFrameModified = false;
+		bool m_ForceKeyframe = true;
+		bool m_Journaled = false;
+		size_t m_BytesSinceKeyframe = 0;
+		RecorderReplayer* m_Replayer = nullptr;
 		std::unique_ptr<uint8_t[]> m_CurrentFrameState;
-		std::unique_ptr<uint8_t[]> m_LastFrameState;
+		std::unique_ptr<uint8_t[]> m_LastFrameState; // The last stored frame, which deltas are taken against
 
 		std::vector<ChannelInfo> m_Channels;
-		//std::unique_ptr<uint8_t[]> m_WorkingBuffer;
+		std::vector<uint8_t> m_WorkingBuffer;
+
+		std::unique_ptr<MappedFile> m_Journal;
 	};
 }
 
@@ -43,6 +43,11 @@ const RecorderMemberDescription& RecorderChannelDescription::GetMember(size_t a_
 	return m_Members[a_Index];
 }
 
+bool RecorderChannelDescription::IsJournaled() const noexcept
+{
+	return m_Journaled;
+}
+
 void RecorderChannelDescription::SetName(std::string_view a_Name)
 {
 	m_Name = a_Name;
@@ -75,4 +80,9 @@ size_t RecorderChannelDescription::AddMember(const RecorderMemberDescription& a_
 
 	// Return the index of the new channel
 	return channel_index;
+}
+
+void RecorderChannelDescription::SetJournaled(bool a_Journaled) noexcept
+{
+	m_Journaled = a_Journaled;
 }
\ No newline at end of file
@@ -19,12 +19,15 @@ namespace Amber::Common
 		size_t GetMemberCount() const noexcept;
 		std::optional<size_t> FindMember(std::string_view a_Name) const noexcept;
 		const RecorderMemberDescription& GetMember(size_t a_Index) const noexcept;
+		bool IsJournaled() const noexcept;
 
 		void SetName(std::string_view a_Name);
 		size_t AddMember(const RecorderMemberDescription& a_Description);
+		void SetJournaled(bool a_Journaled) noexcept;
 
 		private:
 		std::string m_Name;
+		bool m_Journaled = false; // Stored every frame even when the rest of the state is only stored at keyframes
 		std::vector<RecorderMemberDescription> m_Members;
 		std::map<std::string, size_t, std::less<>> m_MemberNameMap;
 	};
@@ -62,7 +62,37 @@ size_t RecorderDescription::GetBlockSize() const noexcept
 	return m_BlockSize;
 }
 
+size_t RecorderDescription::GetKeyframeInterval() const noexcept
+{
+	return m_KeyframeInterval;
+}
+
+size_t RecorderDescription::GetKeyframeByteBudget() const noexcept
+{
+	return m_KeyframeByteBudget;
+}
+
+size_t RecorderDescription::GetMemoryBudget() const noexcept
+{
+	return m_MemoryBudget;
+}
+
 void RecorderDescription::SetBlockSize(size_t a_Size) noexcept
 {
 	m_BlockSize = a_Size;
+}
+
+void RecorderDescription::SetKeyframeInterval(size_t a_Interval) noexcept
+{
+	m_KeyframeInterval = a_Interval;
+}
+
+void RecorderDescription::SetKeyframeByteBudget(size_t a_Budget) noexcept
+{
+	m_KeyframeByteBudget = a_Budget;
+}
+
+void RecorderDescription::SetMemoryBudget(size_t a_Budget) noexcept
+{
+	m_MemoryBudget = a_Budget;
 }
\ No newline at end of file
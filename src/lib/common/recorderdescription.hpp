@@ -19,13 +19,22 @@ namespace Amber::Common
 		size_t AddChannel(const RecorderChannelDescription& a_Description);
 
 		size_t GetBlockSize() const noexcept;
+		size_t GetKeyframeInterval() const noexcept;
+		size_t GetKeyframeByteBudget() const noexcept;
+		size_t GetMemoryBudget() const noexcept;
 
 		void SetBlockSize(size_t a_Size) noexcept;
+		void SetKeyframeInterval(size_t a_Interval) noexcept;
+		void SetKeyframeByteBudget(size_t a_Budget) noexcept;
+		void SetMemoryBudget(size_t a_Budget) noexcept;
 
 		private:
 		std::vector<RecorderChannelDescription> m_Channels;
 		std::map<std::string, size_t, std::less<>> m_ChannelNameMap;
-		size_t m_BlockSize = 1024 * 1024 * 1024; // 1mb
+		size_t m_BlockSize = 1024 * 1024 * 1024; // 1 gb
+		size_t m_KeyframeInterval = 300; // Every 5 seconds at 60 frames per second
+		size_t m_KeyframeByteBudget = 0; // Bytes of deltas after which a keyframe is stored early, 0 for never
+		size_t m_MemoryBudget = 0; // Unbounded
 	};
 }
 
@@ -3,6 +3,13 @@
 using namespace Amber;
 using namespace Common;
 
+RecorderMemberDescription::RecorderMemberDescription(std::string_view a_Name, RecorderMemberType::Enum a_Type, size_t a_Size):
+	m_Name(a_Name),
+	m_Size(a_Size),
+	m_Type(a_Type)
+{
+}
+
 std::string_view RecorderMemberDescription::GetName() const noexcept
 {
 	return m_Name;
@@ -16,13 +23,13 @@ size_t RecorderMemberDescription::GetSize() const noexcept
 		return 1;
 
 		case RecorderMemberType::uint16:
-		return 1;
+		return 2;
 
 		case RecorderMemberType::uint32:
-		return 1;
+		return 4;
 
 		case RecorderMemberType::uint64:
-		return 1;
+		return 8;
 
 		case RecorderMemberType::Raw:
 		return m_Size;
@@ -9,6 +9,9 @@ namespace Amber::Common
 	class COMMON_API RecorderMemberDescription
 	{
 		public:
+		RecorderMemberDescription() = default;
+		RecorderMemberDescription(std::string_view a_Name, RecorderMemberType::Enum a_Type, size_t a_Size = 0);
+
 		std::string_view GetName() const noexcept;
 		size_t GetSize() const noexcept;
 		RecorderMemberType::Enum GetType() const noexcept;
@@ -0,0 +1,6 @@
+#include <common/recorderreplayer.hpp>
+
+using namespace Amber;
+using namespace Common;
+
+RecorderReplayer::~RecorderReplayer() noexcept = default;
\ No newline at end of file
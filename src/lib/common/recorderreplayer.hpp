@@ -0,0 +1,22 @@
+#ifndef H_AMBER_COMMON_RECORDERREPLAYER
+#define H_AMBER_COMMON_RECORDERREPLAYER
+
+#include <common/api.hpp>
+
+namespace Amber::Common
+{
+	class Recorder;
+
+	// Regenerates the channels a recorder doesn't store between keyframes (every channel that isn't journaled, see
+	// RecorderChannelDescription::SetJournaled). When called the recorder holds the state of the previous frame with the
+	// journaled channels of a_Frame already applied, the replayer runs one frame from there and writes the results back.
+	class COMMON_API RecorderReplayer
+	{
+		public:
+		virtual ~RecorderReplayer() noexcept = 0;
+
+		virtual void ReplayFrame(Recorder& a_Recorder, size_t a_Frame) = 0;
+	};
+}
+
+#endif
\ No newline at end of file
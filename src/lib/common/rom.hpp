@@ -42,6 +42,11 @@ namespace Amber::Common
 		{
 		}
 
+		const uint8_t* GetReadPage(Address a_Address) const override
+		{
+			return a_Address + Memory<T>::PageSize <= m_Size ? GetData() + a_Address : nullptr;
+		}
+
 		private:
 		const size_t m_Size;
 		std::unique_ptr<uint8_t[]> m_Data;
@@ -0,0 +1,65 @@
+#ifndef H_AMBER_COMMON_SPSCQUEUE
+#define H_AMBER_COMMON_SPSCQUEUE
+
+#include <common/api.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+namespace Amber::Common
+{
+	// Bounded lock-free queue for exactly one producer thread and one consumer thread. Both indices only ever grow and
+	// are masked on access, so a full queue and an empty queue are told apart without wasting a slot.
+	template <typename T, size_t Capacity>
+	class SPSCQueue
+	{
+		public:
+		static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "SPSC queue capacity must be a power of two");
+		static_assert(std::is_trivially_copyable_v<T>, "SPSC queue elements must be trivially copyable");
+
+		// Producer side, fails when the consumer has fallen a whole capacity behind
+		bool TryPush(const T& a_Value) noexcept
+		{
+			const size_t tail = m_Tail.load(std::memory_order_relaxed);
+			if (tail - m_Head.load(std::memory_order_acquire) == Capacity)
+			{
+				return false;
+			}
+
+			m_Elements[tail & (Capacity - 1)] = a_Value;
+			m_Tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer side
+		std::optional<T> TryPop() noexcept
+		{
+			const size_t head = m_Head.load(std::memory_order_relaxed);
+			if (head == m_Tail.load(std::memory_order_acquire))
+			{
+				return std::nullopt;
+			}
+
+			const T value = m_Elements[head & (Capacity - 1)];
+			m_Head.store(head + 1, std::memory_order_release);
+			return value;
+		}
+
+		// Either side, only a snapshot when the other side is active
+		bool IsEmpty() const noexcept
+		{
+			return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_acquire);
+		}
+
+		private:
+		// Keep the indices on separate cache lines so the two threads don't keep stealing them from each other
+		alignas(64) std::atomic<size_t> m_Head = 0;
+		alignas(64) std::atomic<size_t> m_Tail = 0;
+		alignas(64) std::array<T, Capacity> m_Elements;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef H_AMBER_COMMON_TRIPLEBUFFER
+#define H_AMBER_COMMON_TRIPLEBUFFER
+
+#include <common/api.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Amber::Common
+{
+	// Lock-free mailbox handing the latest value from one writer thread to one reader thread. The writer fills its
+	// back slot and swaps it with the middle slot, the reader swaps its front slot with the middle slot when a newer
+	// value is waiting. Neither side ever waits on the other; values the reader never got around to are dropped.
+	template <typename T>
+	class TripleBuffer
+	{
+		public:
+		// Writer side
+		T& GetBack() noexcept
+		{
+			return m_Slots[m_Back];
+		}
+
+		void Publish() noexcept
+		{
+			const uint8_t middle = m_Middle.exchange(static_cast<uint8_t>(m_Back | FreshBit), std::memory_order_acq_rel);
+			m_Back = middle & SlotMask;
+		}
+
+		// Reader side, returns true and updates the front slot if something was published since the last call
+		bool Acquire() noexcept
+		{
+			if ((m_Middle.load(std::memory_order_relaxed) & FreshBit) == 0)
+			{
+				return false;
+			}
+
+			const uint8_t middle = m_Middle.exchange(m_Front, std::memory_order_acq_rel);
+			m_Front = middle & SlotMask;
+			return true;
+		}
+
+		const T& GetFront() const noexcept
+		{
+			return m_Slots[m_Front];
+		}
+
+		private:
+		static constexpr uint8_t SlotMask = 0b11;
+		static constexpr uint8_t FreshBit = 0b100;
+
+		std::array<T, 3> m_Slots = {};
+		uint8_t m_Front = 0;
+		uint8_t m_Back = 1;
+		std::atomic<uint8_t> m_Middle = 2;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -1,29 +1,39 @@
 #include <gameboy/basiccartridge.hpp>
 
 using namespace Amber;
+using namespace Common;
 using namespace Gameboy;
 
 BasicCartridge::BasicCartridge(size_t a_ROMSize, size_t a_RAMSize):
-	m_ROM(a_ROMSize),
+	m_ROM(std::make_shared<ROM16<false>>(a_ROMSize)),
 	m_RAM(a_RAMSize)
 {
+	if (a_RAMSize != 0)
+	{
+		m_RecorderMembers.emplace_back("RAM", RecorderMemberType::Raw, a_RAMSize);
+	}
 }
 
 const CartridgeHeader& BasicCartridge::GetHeader() const
 {
-	return *reinterpret_cast<const CartridgeHeader*>(m_ROM.GetData() + CartridgeHeader::HeaderAddress);
+	return *reinterpret_cast<const CartridgeHeader*>(m_ROM->GetData() + CartridgeHeader::HeaderAddress);
 }
 
 Common::ROM16<false>& BasicCartridge::GetROM() noexcept
 {
-	return m_ROM;
+	return *m_ROM;
 }
 
-Common::RAM16<false>& BasicCartridge::GetRAM() noexcept
+Common::PagedRAM16<false>& BasicCartridge::GetRAM() noexcept
 {
 	return m_RAM;
 }
 
+std::unique_ptr<Cartridge> BasicCartridge::Fork() const
+{
+	return std::make_unique<BasicCartridge>(*this);
+}
+
 uint8_t BasicCartridge::Load8(Address a_Address) const
 {
 	switch (a_Address & 0xF000)
@@ -36,7 +46,7 @@ uint8_t BasicCartridge::Load8(Address a_Address) const
 		case 0x5000:
 		case 0x6000:
 		case 0x7000:
-		return m_ROM.Load8(a_Address);
+		return m_ROM->Load8(a_Address);
 
 		case 0xA000:
 		case 0xB000:
@@ -56,4 +66,74 @@ void BasicCartridge::Store8(Address a_Address, uint8_t a_Value)
 		m_RAM.Store8(a_Address - 0xA000, a_Value);
 		break;
 	}
+}
+
+uint64_t BasicCartridge::GetPhysicalAddress(Address a_Address) const
+{
+	// ROM occupies the bottom of the physical address space, RAM follows directly after it
+	switch (a_Address & 0xF000)
+	{
+		case 0xA000:
+		case 0xB000:
+		return m_ROM->GetSize() + (a_Address - 0xA000);
+
+		default:
+		return a_Address;
+	}
+}
+
+const uint8_t* BasicCartridge::GetReadPage(Address a_Address) const
+{
+	switch (a_Address & 0xF000)
+	{
+		case 0x0000:
+		case 0x1000:
+		case 0x2000:
+		case 0x3000:
+		case 0x4000:
+		case 0x5000:
+		case 0x6000:
+		case 0x7000:
+		return m_ROM->GetReadPage(a_Address);
+
+		case 0xA000:
+		case 0xB000:
+		return m_RAM.GetReadPage(a_Address - 0xA000);
+
+		default:
+		return nullptr;
+	}
+}
+
+uint8_t* BasicCartridge::GetWritePage(Address a_Address)
+{
+	switch (a_Address & 0xF000)
+	{
+		case 0xA000:
+		case 0xB000:
+		return m_RAM.GetWritePage(a_Address - 0xA000);
+
+		default:
+		return nullptr;
+	}
+}
+
+size_t BasicCartridge::GetRecorderMemberCount() const noexcept
+{
+	return m_RecorderMembers.size();
+}
+
+const RecorderMemberDescription& BasicCartridge::GetRecorderMember(size_t a_Index) const noexcept
+{
+	return m_RecorderMembers[a_Index];
+}
+
+void BasicCartridge::SaveRecorderState(ByteWriter& a_Writer) const noexcept
+{
+	m_RAM.SaveRecorderState(a_Writer);
+}
+
+void BasicCartridge::LoadRecorderState(ByteReader& a_Reader) noexcept
+{
+	m_RAM.LoadRecorderState(a_Reader);
 }
\ No newline at end of file
@@ -4,9 +4,11 @@
 #include <gameboy/api.hpp>
 #include <gameboy/cartridge.hpp>
 
-#include <common/ram.hpp>
+#include <common/pagedram.hpp>
+#include <common/rom.hpp>
 
 #include <memory>
+#include <vector>
 
 namespace Amber::Gameboy
 {
@@ -16,15 +18,29 @@ namespace Amber::Gameboy
 		BasicCartridge(size_t a_ROMSize, size_t a_RAMSize);
 
 		const CartridgeHeader& GetHeader() const override;
+		// The ROM is shared with every fork of this cartridge
 		Common::ROM16<false>& GetROM() noexcept;
-		Common::RAM16<false>& GetRAM() noexcept;
+		Common::PagedRAM16<false>& GetRAM() noexcept;
+
+		std::unique_ptr<Cartridge> Fork() const override;
 
 		uint8_t Load8(Address a_Address) const override;
 		void Store8(Address a_Address, uint8_t a_Value) override;
 
+		uint64_t GetPhysicalAddress(Address a_Address) const override;
+		const uint8_t* GetReadPage(Address a_Address) const override;
+		uint8_t* GetWritePage(Address a_Address) override;
+
+		// Recording: the cartridge RAM followed by whatever registers the memory bank controller adds
+		size_t GetRecorderMemberCount() const noexcept override;
+		const Common::RecorderMemberDescription& GetRecorderMember(size_t a_Index) const noexcept override;
+		void SaveRecorderState(Common::ByteWriter& a_Writer) const noexcept override;
+		void LoadRecorderState(Common::ByteReader& a_Reader) noexcept override;
+
 		protected:
-		Common::ROM16<false> m_ROM;
-		Common::RAM16<false> m_RAM;
+		std::shared_ptr<Common::ROM16<false>> m_ROM;
+		Common::PagedRAM16<false> m_RAM;
+		std::vector<Common::RecorderMemberDescription> m_RecorderMembers;
 	};
 }
 
@@ -0,0 +1,434 @@
+#include <gameboy/batchrunner.hpp>
+
+#include <gameboy/basiccartridge.hpp>
+#include <gameboy/device.hpp>
+#include <gameboy/mmu.hpp>
+#include <gameboy/ppu.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+using namespace Amber;
+using namespace Gameboy;
+
+namespace
+{
+	uint64_t HashFrameBuffer(const uint8_t* a_Data, size_t a_Size) noexcept
+	{
+		uint64_t hash = 0xCBF29CE484222325;
+		for (size_t i = 0; i < a_Size; ++i)
+		{
+			hash ^= a_Data[i];
+			hash *= 0x100000001B3;
+		}
+
+		return hash;
+	}
+
+	// Only used to find candidates, a word at a time is plenty
+	uint64_t HashState(const std::vector<uint8_t>& a_State) noexcept
+	{
+		uint64_t hash = a_State.size();
+		size_t i = 0;
+		for (; i + sizeof(uint64_t) <= a_State.size(); i += sizeof(uint64_t))
+		{
+			uint64_t word;
+			std::memcpy(&word, a_State.data() + i, sizeof(word));
+			hash = (hash ^ word) * 0x100000001B3;
+		}
+		for (; i < a_State.size(); ++i)
+		{
+			hash = (hash ^ a_State[i]) * 0x100000001B3;
+		}
+
+		return hash;
+	}
+}
+
+BatchRunner::BatchRunner(size_t a_ThreadCount):
+	m_ThreadCount(a_ThreadCount != 0 ? a_ThreadCount : std::max<size_t>(std::thread::hardware_concurrency(), 1)),
+	m_Workers(std::make_unique<Worker[]>(m_ThreadCount))
+{
+}
+
+BatchRunner::~BatchRunner() noexcept = default;
+
+size_t BatchRunner::GetThreadCount() const noexcept
+{
+	return m_ThreadCount;
+}
+
+bool BatchRunner::IsLockstepEnabled() const noexcept
+{
+	return m_LockstepEnabled;
+}
+
+void BatchRunner::SetLockstepEnabled(bool a_Enabled) noexcept
+{
+	m_LockstepEnabled = a_Enabled;
+}
+
+size_t BatchRunner::AddInstance(std::unique_ptr<Device> a_Device, size_t a_FrameCount, FrameCallback a_Callback)
+{
+	auto instance = std::make_unique<Instance>();
+	instance->m_Device = std::move(a_Device);
+	instance->m_FrameCount = a_FrameCount;
+	instance->m_Callback = std::move(a_Callback);
+
+	m_Instances.push_back(std::move(instance));
+	return m_Instances.size() - 1;
+}
+
+void BatchRunner::AddMemoryRegion(uint16_t a_Address, uint16_t a_Size)
+{
+	m_MemoryRegions.emplace_back(a_Address, a_Size);
+}
+
+size_t BatchRunner::GetInstanceCount() const noexcept
+{
+	return m_Instances.size();
+}
+
+Device& BatchRunner::GetDevice(size_t a_Instance) noexcept
+{
+	return *m_Instances[a_Instance]->m_Device;
+}
+
+const BatchRunner::Result& BatchRunner::GetResult(size_t a_Instance) const noexcept
+{
+	return m_Instances[a_Instance]->m_Result;
+}
+
+void BatchRunner::Run()
+{
+	std::vector<Instance*> instances;
+	for (const auto& instance : m_Instances)
+	{
+		if (instance->m_Finished)
+		{
+			continue;
+		}
+
+		if (instance->m_Result.m_Frames >= instance->m_FrameCount)
+		{
+			Finish(*instance);
+			continue;
+		}
+
+		instances.push_back(instance.get());
+	}
+
+	std::vector<Group> groups;
+	if (m_LockstepEnabled)
+	{
+		for (Instance* instance : instances)
+		{
+			SaveLockstepState(*instance);
+		}
+		GroupInstances(instances, groups);
+	}
+	else
+	{
+		for (Instance* instance : instances)
+		{
+			groups.push_back({ instance });
+		}
+	}
+
+	// Deal the groups out round robin, stealing evens out whatever imbalance is left
+	for (size_t i = 0; i < groups.size(); ++i)
+	{
+		m_Workers[i % m_ThreadCount].m_Queue.push_back(std::move(groups[i]));
+	}
+
+	m_Remaining.store(instances.size(), std::memory_order_relaxed);
+	m_Exception = nullptr;
+
+	std::vector<std::thread> threads;
+	threads.reserve(m_ThreadCount - 1);
+	for (size_t i = 1; i < m_ThreadCount; ++i)
+	{
+		threads.emplace_back(&BatchRunner::RunWorker, this, i);
+	}
+
+	RunWorker(0);
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	if (m_Exception != nullptr)
+	{
+		std::rethrow_exception(m_Exception);
+	}
+}
+
+size_t BatchRunner::GetFramesRun() const noexcept
+{
+	return m_FramesRun.load(std::memory_order_relaxed);
+}
+
+size_t BatchRunner::GetFramesShared() const noexcept
+{
+	return m_FramesShared.load(std::memory_order_relaxed);
+}
+
+void BatchRunner::RunWorker(size_t a_Worker)
+{
+	Group group;
+	while (m_Remaining.load(std::memory_order_acquire) != 0)
+	{
+		if (!PopGroup(a_Worker, group))
+		{
+			// Every remaining instance is being run by another worker right now
+			std::this_thread::yield();
+			continue;
+		}
+
+		RunFrame(a_Worker, group);
+	}
+}
+
+bool BatchRunner::PopGroup(size_t a_Worker, Group& a_Group)
+{
+	// The worker's own queue is used as a stack, so a group keeps running on the same core while it can
+	{
+		Worker& worker = m_Workers[a_Worker];
+		std::lock_guard lock(worker.m_Mutex);
+		if (!worker.m_Queue.empty())
+		{
+			a_Group = std::move(worker.m_Queue.back());
+			worker.m_Queue.pop_back();
+			return true;
+		}
+	}
+
+	for (size_t i = 1; i < m_ThreadCount; ++i)
+	{
+		Worker& victim = m_Workers[(a_Worker + i) % m_ThreadCount];
+		std::lock_guard lock(victim.m_Mutex);
+		if (!victim.m_Queue.empty())
+		{
+			a_Group = std::move(victim.m_Queue.front());
+			victim.m_Queue.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void BatchRunner::PushGroup(size_t a_Worker, Group&& a_Group)
+{
+	Worker& worker = m_Workers[a_Worker];
+	std::lock_guard lock(worker.m_Mutex);
+	worker.m_Queue.push_back(std::move(a_Group));
+}
+
+void BatchRunner::RunFrame(size_t a_Worker, Group& a_Group)
+{
+	Instance& leader = *a_Group.front();
+	Device& device = *leader.m_Device;
+
+	// A frame's worth of cycles, ending between two instructions
+	try
+	{
+		device.Run(PPU::FrameCycles / 4);
+		while (!device.Tick())
+		{
+		}
+	}
+	catch (...)
+	{
+		SetException(std::current_exception());
+		for (Instance* instance : a_Group)
+		{
+			Finish(*instance);
+		}
+		m_Remaining.fetch_sub(a_Group.size(), std::memory_order_release);
+		return;
+	}
+
+	m_FramesRun.fetch_add(1, std::memory_order_relaxed);
+
+	// The serial output isn't part of the state, so the rest of the group copies it separately
+	MMU& mmu = device.GetMMU();
+	const auto& serial_output = mmu.GetSerialOutput();
+	if (a_Group.size() > 1)
+	{
+		device.SaveState(leader.m_State);
+		for (size_t i = 1; i < a_Group.size(); ++i)
+		{
+			Instance& follower = *a_Group[i];
+			follower.m_Device->LoadState(leader.m_State.data(), leader.m_State.size());
+			follower.m_Result.m_SerialOutput.insert(follower.m_Result.m_SerialOutput.end(), serial_output.begin(), serial_output.end());
+		}
+
+		m_FramesShared.fetch_add(a_Group.size() - 1, std::memory_order_relaxed);
+	}
+	leader.m_Result.m_SerialOutput.insert(leader.m_Result.m_SerialOutput.end(), serial_output.begin(), serial_output.end());
+	mmu.ClearSerialOutput();
+
+	const auto end = std::remove_if(a_Group.begin(), a_Group.end(), [this](Instance* a_Instance)
+	{
+		if (EndFrame(*a_Instance))
+		{
+			return false;
+		}
+
+		Finish(*a_Instance);
+		m_Remaining.fetch_sub(1, std::memory_order_release);
+		return true;
+	});
+	a_Group.erase(end, a_Group.end());
+
+	if (a_Group.size() > 1)
+	{
+		SplitGroup(a_Worker, a_Group);
+	}
+
+	if (!a_Group.empty())
+	{
+		PushGroup(a_Worker, std::move(a_Group));
+	}
+}
+
+bool BatchRunner::EndFrame(Instance& a_Instance)
+{
+	const size_t frame = ++a_Instance.m_Result.m_Frames;
+	if (frame >= a_Instance.m_FrameCount)
+	{
+		return false;
+	}
+
+	if (a_Instance.m_Callback == nullptr)
+	{
+		return true;
+	}
+
+	try
+	{
+		return a_Instance.m_Callback(*a_Instance.m_Device, frame);
+	}
+	catch (...)
+	{
+		SetException(std::current_exception());
+		return false;
+	}
+}
+
+void BatchRunner::Finish(Instance& a_Instance)
+{
+	Device& device = *a_Instance.m_Device;
+	device.Synchronize();
+
+	Result& result = a_Instance.m_Result;
+	result.m_FrameBufferHash = HashFrameBuffer(device.GetPPU().GetFrameBuffer(), PPU::FrameBufferSize);
+
+	MMU& mmu = device.GetMMU();
+	result.m_MemoryRegions.resize(m_MemoryRegions.size());
+	for (size_t i = 0; i < m_MemoryRegions.size(); ++i)
+	{
+		const auto [address, size] = m_MemoryRegions[i];
+		auto& region = result.m_MemoryRegions[i];
+		region.resize(size);
+		for (size_t j = 0; j < size; ++j)
+		{
+			region[j] = mmu.Load8(static_cast<uint16_t>(address + j));
+		}
+	}
+
+	a_Instance.m_Finished = true;
+	a_Instance.m_State = {};
+}
+
+void BatchRunner::SplitGroup(size_t a_Worker, Group& a_Group)
+{
+	for (Instance* instance : a_Group)
+	{
+		SaveLockstepState(*instance);
+	}
+
+	// Whatever still matches the first instance stays in the group, the rest regroup among themselves
+	const Instance* const leader = a_Group.front();
+	const auto end = std::stable_partition(a_Group.begin(), a_Group.end(), [leader](const Instance* a_Instance)
+	{
+		return a_Instance == leader || a_Instance->m_State == leader->m_State;
+	});
+
+	if (end == a_Group.end())
+	{
+		return;
+	}
+
+	std::vector<Group> groups;
+	GroupInstances(std::vector<Instance*>(end, a_Group.end()), groups);
+	a_Group.erase(end, a_Group.end());
+
+	for (auto& group : groups)
+	{
+		PushGroup(a_Worker, std::move(group));
+	}
+}
+
+void BatchRunner::SaveLockstepState(Instance& a_Instance)
+{
+	Device& device = *a_Instance.m_Device;
+	device.SaveState(a_Instance.m_State);
+
+	// Neither the ROM nor the boot ROM is part of the state. Forks share their ROM, so its address identifies it.
+	MMU& mmu = device.GetMMU();
+	const void* rom = mmu.GetCartridge();
+	if (auto cartridge = dynamic_cast<BasicCartridge*>(mmu.GetCartridge()))
+	{
+		rom = &cartridge->GetROM();
+	}
+
+	const auto* const rom_bytes = reinterpret_cast<const uint8_t*>(&rom);
+	a_Instance.m_State.insert(a_Instance.m_State.end(), rom_bytes, rom_bytes + sizeof(rom));
+
+	if (const auto* boot_rom = mmu.GetBootROM())
+	{
+		for (uint16_t i = 0; i < 0x100; ++i)
+		{
+			a_Instance.m_State.push_back(boot_rom->Load8(i));
+		}
+	}
+}
+
+void BatchRunner::GroupInstances(const std::vector<Instance*>& a_Instances, std::vector<Group>& a_Groups)
+{
+	// Groups by hash first, instances with the same hash still have to match the group exactly
+	std::unordered_multimap<uint64_t, size_t> hashed_groups;
+	for (Instance* instance : a_Instances)
+	{
+		const uint64_t hash = HashState(instance->m_State);
+		const auto [begin, end] = hashed_groups.equal_range(hash);
+		const auto match = std::find_if(begin, end, [&](const auto& a_Entry)
+		{
+			return a_Groups[a_Entry.second].front()->m_State == instance->m_State;
+		});
+
+		if (match != end)
+		{
+			a_Groups[match->second].push_back(instance);
+		}
+		else
+		{
+			hashed_groups.emplace(hash, a_Groups.size());
+			a_Groups.push_back({ instance });
+		}
+	}
+}
+
+void BatchRunner::SetException(std::exception_ptr a_Exception)
+{
+	std::lock_guard lock(m_ExceptionMutex);
+	if (m_Exception == nullptr)
+	{
+		m_Exception = a_Exception;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#ifndef H_AMBER_GAMEBOY_BATCHRUNNER
+#define H_AMBER_GAMEBOY_BATCHRUNNER
+
+#include <gameboy/api.hpp>
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Amber::Gameboy
+{
+	class Device;
+
+	// Runs many independent devices at once. Every worker thread owns a queue of instances and runs one frame of
+	// its most recent instance at a time, idle workers steal the oldest instance from another worker's queue. The
+	// instances never touch each other, so the only state the workers share is their queues.
+	//
+	// In lockstep mode, instances running the same cartridge ROM in exactly the same state form a group that only
+	// runs its first instance, the others take over its state after every frame. An instance leaves its group for
+	// good as soon as it diverges, typically once its callback presses different buttons. Groups that stay
+	// together, like instances going through the boot ROM and menus, cost about as much as a single instance.
+	class GAMEBOY_API BatchRunner
+	{
+		public:
+		// Collected from every instance once it finishes
+		struct Result
+		{
+			size_t m_Frames = 0;
+			uint64_t m_FrameBufferHash = 0; // FNV-1a of PPU::GetFrameBuffer
+			std::vector<std::vector<uint8_t>> m_MemoryRegions; // In the order they were added
+			std::vector<uint8_t> m_SerialOutput;
+		};
+
+		// Called on the worker running the instance after every frame, returning false finishes the instance early
+		using FrameCallback = std::function<bool(Device& a_Device, size_t a_Frame)>;
+
+		// No thread count means one thread per hardware thread, the thread calling Run is one of them
+		explicit BatchRunner(size_t a_ThreadCount = 0);
+		~BatchRunner() noexcept;
+
+		size_t GetThreadCount() const noexcept;
+
+		bool IsLockstepEnabled() const noexcept;
+		void SetLockstepEnabled(bool a_Enabled) noexcept;
+
+		// The memories attached to a device have to outlive the runner, unless the device is a fork which owns them
+		size_t AddInstance(std::unique_ptr<Device> a_Device, size_t a_FrameCount, FrameCallback a_Callback = nullptr);
+		void AddMemoryRegion(uint16_t a_Address, uint16_t a_Size);
+
+		size_t GetInstanceCount() const noexcept;
+		Device& GetDevice(size_t a_Instance) noexcept;
+		const Result& GetResult(size_t a_Instance) const noexcept;
+
+		// Runs every unfinished instance to completion. The first exception thrown by an instance finishes it and is
+		// rethrown once the others are done.
+		void Run();
+
+		// Frames run by the first instance of a group, frames the others took over instead
+		size_t GetFramesRun() const noexcept;
+		size_t GetFramesShared() const noexcept;
+
+		private:
+		struct Instance
+		{
+			std::unique_ptr<Device> m_Device;
+			size_t m_FrameCount = 0;
+			FrameCallback m_Callback;
+			Result m_Result;
+			bool m_Finished = false;
+
+			// Lockstep: the save state followed by what identifies the ROM, compared to find identical instances
+			std::vector<uint8_t> m_State;
+		};
+
+		using Group = std::vector<Instance*>;
+
+		struct alignas(64) Worker
+		{
+			std::mutex m_Mutex;
+			std::deque<Group> m_Queue;
+		};
+
+		void RunWorker(size_t a_Worker);
+		bool PopGroup(size_t a_Worker, Group& a_Group);
+		void PushGroup(size_t a_Worker, Group&& a_Group);
+		void RunFrame(size_t a_Worker, Group& a_Group);
+		bool EndFrame(Instance& a_Instance);
+		void Finish(Instance& a_Instance);
+		void SplitGroup(size_t a_Worker, Group& a_Group);
+		void SaveLockstepState(Instance& a_Instance);
+		static void GroupInstances(const std::vector<Instance*>& a_Instances, std::vector<Group>& a_Groups);
+		void SetException(std::exception_ptr a_Exception);
+
+		const size_t m_ThreadCount;
+		bool m_LockstepEnabled = false;
+		std::vector<std::unique_ptr<Instance>> m_Instances;
+		std::vector<std::pair<uint16_t, uint16_t>> m_MemoryRegions;
+
+		std::unique_ptr<Worker[]> m_Workers;
+		std::atomic<size_t> m_Remaining = 0;
+		std::atomic<size_t> m_FramesRun = 0;
+		std::atomic<size_t> m_FramesShared = 0;
+		std::mutex m_ExceptionMutex;
+		std::exception_ptr m_Exception;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -5,10 +5,13 @@
 #include <gameboy/cartridgeheader.hpp>
 
 #include <common/memory.hpp>
+#include <common/recordable.hpp>
+
+#include <memory>
 
 namespace Amber::Gameboy
 {
-	class GAMEBOY_API Cartridge : public Common::MemoryHelper<uint16_t, false>
+	class GAMEBOY_API Cartridge : public Common::MemoryHelper<uint16_t, false>, public Common::Recordable
 	{
 		public:
 		static constexpr size_t ROMBankSize = 0x4000;
@@ -17,6 +20,9 @@ namespace Amber::Gameboy
 		virtual ~Cartridge() noexcept = 0;
 
 		virtual const CartridgeHeader& GetHeader() const = 0;
+
+		// An independent cartridge in the same state, sharing the ROM and any RAM pages neither of them has written to
+		virtual std::unique_ptr<Cartridge> Fork() const = 0;
 	};
 }
 
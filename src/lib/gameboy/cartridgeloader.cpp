@@ -21,10 +21,15 @@ std::unique_ptr<BasicCartridge> CartridgeLoader::LoadCartridge(std::istream& a_S
 	a_Source.read(reinterpret_cast<char*>(&header), sizeof(header));
 
 	auto cartridge = CreateCartridge(header);
+	if (cartridge == nullptr)
+	{
+		return nullptr;
+	}
+
 	auto& rom = cartridge->GetROM();
 
 	a_Source.seekg(0, std::ios_base::end);
-	const size_t rom_size = std::max<size_t>(a_Source.tellg(), rom.GetSize());
+	const size_t rom_size = std::min<size_t>(a_Source.tellg(), rom.GetSize());
 
 	a_Source.seekg(0, std::ios_base::beg);
 	a_Source.read(reinterpret_cast<char*>(rom.GetData()), rom_size);
@@ -2,739 +2,913 @@
 
 #include <common/instructionbuilder.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 
 using namespace Amber;
 using namespace Common;
 using namespace Gameboy;
 
+namespace
+{
+	// Upper bound on the number of instructions decoded into a single block
+	constexpr size_t MaxBlockInstructions = 64;
+
+	// Block entries before a trace is compiled, and the most cycles a trace may run ahead of the rest of the device
+	constexpr uint32_t TraceThreshold = 8;
+	constexpr size_t MaxTraceCycles = 16;
+
+	// DIV bit whose falling edge increments TIMA, per TAC input clock
+	constexpr uint16_t TIMAClockMasks[4] = { 0b1'0000'0000, 0b1000, 0b10'0000, 0b1000'0000 };
+
+	bool GetTIMABitState(uint16_t a_DIV, uint8_t a_TAC) noexcept
+	{
+		return (a_TAC & 0b100) && (a_DIV & TIMAClockMasks[a_TAC & 0b11]) != 0;
+	}
+
+	// Memory a polling loop may spin on: only the CPU writes WRAM and HRAM, and LY only changes when a line starts
+	bool IsPollableAddress(uint16_t a_Address) noexcept
+	{
+		return a_Address == 0xFF44 || (a_Address >= 0xC000 && a_Address < 0xE000) || (a_Address >= 0xFF80 && a_Address < 0xFFFF);
+	}
+
+	bool EndsBlock(Opcode::Enum a_Opcode) noexcept
+	{
+		switch (a_Opcode)
+		{
+			case Opcode::JP_nn:
+			case Opcode::JP_NZ_nn:
+			case Opcode::JP_Z_nn:
+			case Opcode::JP_NC_nn:
+			case Opcode::JP_C_nn:
+			case Opcode::JP_HL:
+			case Opcode::JR_n:
+			case Opcode::JR_NZ_n:
+			case Opcode::JR_Z_n:
+			case Opcode::JR_NC_n:
+			case Opcode::JR_C_n:
+			case Opcode::CALL_nn:
+			case Opcode::CALL_NZ_nn:
+			case Opcode::CALL_Z_nn:
+			case Opcode::CALL_NC_nn:
+			case Opcode::CALL_C_nn:
+			case Opcode::RET:
+			case Opcode::RET_NZ:
+			case Opcode::RET_Z:
+			case Opcode::RET_NC:
+			case Opcode::RET_C:
+			case Opcode::RETI:
+			case Opcode::RST_00:
+			case Opcode::RST_08:
+			case Opcode::RST_10:
+			case Opcode::RST_18:
+			case Opcode::RST_20:
+			case Opcode::RST_28:
+			case Opcode::RST_30:
+			case Opcode::RST_38:
+			case Opcode::HALT:
+			case Opcode::STOP:
+			return true;
+
+			default:
+			return !Opcode::GetSize(a_Opcode).has_value();
+		}
+	}
+
+	// Instructions that only access registers (and their own operands) and never change the op queue
+	bool IsTraceInstruction(Opcode::Enum a_Opcode, ExtendedOpcode::Enum a_ExtendedOpcode) noexcept
+	{
+		const uint8_t opcode = a_Opcode;
+		const uint8_t register_operand = opcode & 0b0000'0111;
+		const uint8_t register_destination = (opcode >> 3) & 0b0000'0111;
+		constexpr uint8_t OperandHL = 0b110;
+
+		if (a_Opcode == Opcode::EXT)
+		{
+			return (a_ExtendedOpcode & 0b0000'0111) != OperandHL;
+		}
+
+		// LD r,r and ALU A,r (this also excludes HALT)
+		if (opcode >= 0x40 && opcode < 0xC0)
+		{
+			return register_operand != OperandHL && (opcode >= 0x80 || register_destination != OperandHL);
+		}
+
+		// ALU A,n
+		if ((opcode & 0b1100'0111) == 0b1100'0110)
+		{
+			return true;
+		}
+
+		if (opcode >= 0x40)
+		{
+			return false;
+		}
+
+		switch (register_operand)
+		{
+			// INC r, DEC r, LD r,n
+			case 0b100:
+			case 0b101:
+			case 0b110:
+			return register_destination != OperandHL;
+
+			// LD rr,nn and ADD HL,rr
+			case 0b001:
+			// INC rr and DEC rr
+			case 0b011:
+			return true;
+
+			// RLCA, RRCA, RLA, RRA, DAA, CPL, SCF, CCF
+			case 0b111:
+			return true;
+
+			default:
+			return a_Opcode == Opcode::NOP;
+		}
+	}
+
+	const RecorderMemberDescription RecorderMembers[] =
+	{
+		{ "AF", RecorderMemberType::uint16 },
+		{ "BC", RecorderMemberType::uint16 },
+		{ "DE", RecorderMemberType::uint16 },
+		{ "HL", RecorderMemberType::uint16 },
+		{ "SP", RecorderMemberType::uint16 },
+		{ "PC", RecorderMemberType::uint16 },
+		{ "XY", RecorderMemberType::uint16 },
+		{ "ZW", RecorderMemberType::uint16 },
+		{ "InterruptMasterEnable", RecorderMemberType::uint8 },
+		{ "InterruptEnable", RecorderMemberType::uint8 },
+		{ "InterruptRequests", RecorderMemberType::uint8 },
+		{ "Halted", RecorderMemberType::uint8 },
+		{ "DeferredOp", RecorderMemberType::uint8 },
+		{ "DIV", RecorderMemberType::uint16 },
+		{ "TIMA", RecorderMemberType::uint8 },
+		{ "TMA", RecorderMemberType::uint8 },
+		{ "TAC", RecorderMemberType::uint8 },
+		{ "LastTIMABitState", RecorderMemberType::uint8 },
+		{ "TIMAOverflow", RecorderMemberType::uint8 },
+		{ "DMAAddress", RecorderMemberType::uint8 },
+		{ "DMACounter", RecorderMemberType::uint8 },
+		{ "DMAActive", RecorderMemberType::uint8 },
+	};
+}
+
 CPU::CPU(Memory16& a_Memory):
 	CPUHelper(a_Memory),
-	m_Memory(a_Memory)
-{
-	InstructionBuilder<Opcode::Enum, MicroOp, &CPU::Break> instruction_builder;
-	InstructionBuilder<ExtendedOpcode::Enum, MicroOp, &CPU::Break> extended_instruction_builder;
-	
-	for (size_t i = 0; i < 256; ++i)
-	{
-		const auto opcode = static_cast<Opcode::Enum>(i);
-		const auto extended_opcode = static_cast<ExtendedOpcode::Enum>(i);
-
-		instruction_builder.Begin(opcode, &CPU::NotImplemented);
-		extended_instruction_builder.Begin(extended_opcode, &CPU::NotImplemented);
-	}
-
-	// Misc instructions
-	instruction_builder.Begin(Opcode::NOP);
-	instruction_builder.Begin(Opcode::DI, &CPU::DelayOp<&CPU::DisableInterrupts, 1>);
-	instruction_builder.Begin(Opcode::EI, &CPU::DelayOp<&CPU::EnableInterrupts, 1>);
-	instruction_builder.Begin(Opcode::HALT, &CPU::DelayOp<&CPU::Halt, 1>);
-	instruction_builder.Begin(Opcode::EXT, &CPU::DecodeExtendedInstruction);
-
-	// 8-bit load register to register
-	instruction_builder.Begin(Opcode::LD_A_A, &CPU::LoadOp_r8_r8<RegisterA, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_A_B, &CPU::LoadOp_r8_r8<RegisterA, RegisterB>);
-	instruction_builder.Begin(Opcode::LD_A_C, &CPU::LoadOp_r8_r8<RegisterA, RegisterC>);
-	instruction_builder.Begin(Opcode::LD_A_D, &CPU::LoadOp_r8_r8<RegisterA, RegisterD>);
-	instruction_builder.Begin(Opcode::LD_A_E, &CPU::LoadOp_r8_r8<RegisterA, RegisterE>);
-	instruction_builder.Begin(Opcode::LD_A_H, &CPU::LoadOp_r8_r8<RegisterA, RegisterH>);
-	instruction_builder.Begin(Opcode::LD_A_L, &CPU::LoadOp_r8_r8<RegisterA, RegisterL>);
-
-	instruction_builder.Begin(Opcode::LD_B_A, &CPU::LoadOp_r8_r8<RegisterB, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_B_B, &CPU::LoadOp_r8_r8<RegisterB, RegisterB>);
-	instruction_builder.Begin(Opcode::LD_B_C, &CPU::LoadOp_r8_r8<RegisterB, RegisterC>);
-	instruction_builder.Begin(Opcode::LD_B_D, &CPU::LoadOp_r8_r8<RegisterB, RegisterD>);
-	instruction_builder.Begin(Opcode::LD_B_E, &CPU::LoadOp_r8_r8<RegisterB, RegisterE>);
-	instruction_builder.Begin(Opcode::LD_B_H, &CPU::LoadOp_r8_r8<RegisterB, RegisterH>);
-	instruction_builder.Begin(Opcode::LD_B_L, &CPU::LoadOp_r8_r8<RegisterB, RegisterL>);
-
-	instruction_builder.Begin(Opcode::LD_C_A, &CPU::LoadOp_r8_r8<RegisterC, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_C_B, &CPU::LoadOp_r8_r8<RegisterC, RegisterB>);
-	instruction_builder.Begin(Opcode::LD_C_C, &CPU::LoadOp_r8_r8<RegisterC, RegisterC>);
-	instruction_builder.Begin(Opcode::LD_C_D, &CPU::LoadOp_r8_r8<RegisterC, RegisterD>);
-	instruction_builder.Begin(Opcode::LD_C_E, &CPU::LoadOp_r8_r8<RegisterC, RegisterE>);
-	instruction_builder.Begin(Opcode::LD_C_H, &CPU::LoadOp_r8_r8<RegisterC, RegisterH>);
-	instruction_builder.Begin(Opcode::LD_C_L, &CPU::LoadOp_r8_r8<RegisterC, RegisterL>);
-
-	instruction_builder.Begin(Opcode::LD_D_A, &CPU::LoadOp_r8_r8<RegisterD, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_D_B, &CPU::LoadOp_r8_r8<RegisterD, RegisterB>);
-	instruction_builder.Begin(Opcode::LD_D_C, &CPU::LoadOp_r8_r8<RegisterD, RegisterC>);
-	instruction_builder.Begin(Opcode::LD_D_D, &CPU::LoadOp_r8_r8<RegisterD, RegisterD>);
-	instruction_builder.Begin(Opcode::LD_D_E, &CPU::LoadOp_r8_r8<RegisterD, RegisterE>);
-	instruction_builder.Begin(Opcode::LD_D_H, &CPU::LoadOp_r8_r8<RegisterD, RegisterH>);
-	instruction_builder.Begin(Opcode::LD_D_L, &CPU::LoadOp_r8_r8<RegisterD, RegisterL>);
-
-	instruction_builder.Begin(Opcode::LD_E_A, &CPU::LoadOp_r8_r8<RegisterE, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_E_B, &CPU::LoadOp_r8_r8<RegisterE, RegisterB>);
-	instruction_builder.Begin(Opcode::LD_E_C, &CPU::LoadOp_r8_r8<RegisterE, RegisterC>);
-	instruction_builder.Begin(Opcode::LD_E_D, &CPU::LoadOp_r8_r8<RegisterE, RegisterD>);
-	instruction_builder.Begin(Opcode::LD_E_E, &CPU::LoadOp_r8_r8<RegisterE, RegisterE>);
-	instruction_builder.Begin(Opcode::LD_E_H, &CPU::LoadOp_r8_r8<RegisterE, RegisterH>);
-	instruction_builder.Begin(Opcode::LD_E_L, &CPU::LoadOp_r8_r8<RegisterE, RegisterL>);
-
-	instruction_builder.Begin(Opcode::LD_H_A, &CPU::LoadOp_r8_r8<RegisterH, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_H_B, &CPU::LoadOp_r8_r8<RegisterH, RegisterB>);
-	instruction_builder.Begin(Opcode::LD_H_C, &CPU::LoadOp_r8_r8<RegisterH, RegisterC>);
-	instruction_builder.Begin(Opcode::LD_H_D, &CPU::LoadOp_r8_r8<RegisterH, RegisterD>);
-	instruction_builder.Begin(Opcode::LD_H_E, &CPU::LoadOp_r8_r8<RegisterH, RegisterE>);
-	instruction_builder.Begin(Opcode::LD_H_H, &CPU::LoadOp_r8_r8<RegisterH, RegisterH>);
-	instruction_builder.Begin(Opcode::LD_H_L, &CPU::LoadOp_r8_r8<RegisterH, RegisterL>);
-
-	instruction_builder.Begin(Opcode::LD_L_A, &CPU::LoadOp_r8_r8<RegisterL, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_L_B, &CPU::LoadOp_r8_r8<RegisterL, RegisterB>);
-	instruction_builder.Begin(Opcode::LD_L_C, &CPU::LoadOp_r8_r8<RegisterL, RegisterC>);
-	instruction_builder.Begin(Opcode::LD_L_D, &CPU::LoadOp_r8_r8<RegisterL, RegisterD>);
-	instruction_builder.Begin(Opcode::LD_L_E, &CPU::LoadOp_r8_r8<RegisterL, RegisterE>);
-	instruction_builder.Begin(Opcode::LD_L_H, &CPU::LoadOp_r8_r8<RegisterL, RegisterH>);
-	instruction_builder.Begin(Opcode::LD_L_L, &CPU::LoadOp_r8_r8<RegisterL, RegisterL>);
-
-	// 8-bit load next byte to register
-	instruction_builder.Begin(Opcode::LD_A_n).Cycle(&CPU::LoadOp_r8_n8<RegisterA>);
-	instruction_builder.Begin(Opcode::LD_B_n).Cycle(&CPU::LoadOp_r8_n8<RegisterB>);
-	instruction_builder.Begin(Opcode::LD_C_n).Cycle(&CPU::LoadOp_r8_n8<RegisterC>);
-	instruction_builder.Begin(Opcode::LD_D_n).Cycle(&CPU::LoadOp_r8_n8<RegisterD>);
-	instruction_builder.Begin(Opcode::LD_E_n).Cycle(&CPU::LoadOp_r8_n8<RegisterE>);
-	instruction_builder.Begin(Opcode::LD_H_n).Cycle(&CPU::LoadOp_r8_n8<RegisterH>);
-	instruction_builder.Begin(Opcode::LD_L_n).Cycle(&CPU::LoadOp_r8_n8<RegisterL>);
-
-	// 8-bit load byte at address to register
-	instruction_builder.Begin(Opcode::LD_A_aBC).Cycle(&CPU::LoadOp_r8_ar<RegisterA, RegisterBC>);
-	instruction_builder.Begin(Opcode::LD_A_aDE).Cycle(&CPU::LoadOp_r8_ar<RegisterA, RegisterDE>);
-	instruction_builder.Begin(Opcode::LD_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterA, RegisterHL>);
-	instruction_builder.Begin(Opcode::LD_B_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterB, RegisterHL>);
-	instruction_builder.Begin(Opcode::LD_C_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterC, RegisterHL>);
-	instruction_builder.Begin(Opcode::LD_D_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterD, RegisterHL>);
-	instruction_builder.Begin(Opcode::LD_E_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterE, RegisterHL>);
-	instruction_builder.Begin(Opcode::LD_H_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterH, RegisterHL>);
-	instruction_builder.Begin(Opcode::LD_L_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterL, RegisterHL>);
-
-	// 8-bit load misc to register
-	instruction_builder.Begin(Opcode::LD_A_ann).Cycle(&CPU::LoadOp_r8_n8<RegisterY>).Cycle(&CPU::LoadOp_r8_n8<RegisterX>).Cycle(&CPU::LoadOp_r8_ar<RegisterA, RegisterXY>);
-	instruction_builder.Begin(Opcode::LD_A_aFFC).Cycle(&CPU::LoadOp_r16_FFr8<RegisterXY, RegisterC>, &CPU::LoadOp_r8_ar<RegisterA, RegisterXY>);
-	instruction_builder.Begin(Opcode::LD_A_aFFn).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::LoadOp_r16_FFr8<RegisterXY, RegisterX>).Cycle(&CPU::LoadOp_r8_ar<RegisterA, RegisterXY>);
-
-	// 8 bit load register to address
-	instruction_builder.Begin(Opcode::LD_aBC_A).Cycle(&CPU::LoadOp_ar_r8<RegisterBC, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_aDE_A).Cycle(&CPU::LoadOp_ar_r8<RegisterDE, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_aHL_A).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_aHL_B).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterB>);
-	instruction_builder.Begin(Opcode::LD_aHL_C).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterC>);
-	instruction_builder.Begin(Opcode::LD_aHL_D).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterD>);
-	instruction_builder.Begin(Opcode::LD_aHL_E).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterE>);
-	instruction_builder.Begin(Opcode::LD_aHL_H).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterH>);
-	instruction_builder.Begin(Opcode::LD_aHL_L).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterL>);
-
-	// 8 bit load next byte to address
-	instruction_builder.Begin(Opcode::LD_aHL_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	// 8-bit load misc to address
-	instruction_builder.Begin(Opcode::LD_ann_A).Cycle(&CPU::LoadOp_r8_n8<RegisterY>).Cycle(&CPU::LoadOp_r8_n8<RegisterX>).Cycle(&CPU::LoadOp_ar_r8<RegisterXY, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_aFFC_A).Cycle(&CPU::LoadOp_r16_FFr8<RegisterXY, RegisterC>, &CPU::LoadOp_ar_r8<RegisterXY, RegisterA>);
-	instruction_builder.Begin(Opcode::LD_aFFn_A).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::LoadOp_r16_FFr8<RegisterXY, RegisterX>).Cycle(&CPU::LoadOp_ar_r8<RegisterXY, RegisterA>);
-
-	// 8-bit load and increment/decrement
-	instruction_builder.Begin(Opcode::LDI_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterA, RegisterHL>, &CPU::UnaryOp_r16<RegisterHL, &CPU::Increment16>);
-	instruction_builder.Begin(Opcode::LDD_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterA, RegisterHL>, &CPU::UnaryOp_r16<RegisterHL, &CPU::Decrement16>);
-	instruction_builder.Begin(Opcode::LDI_aHL_A).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterA>, &CPU::UnaryOp_r16<RegisterHL, &CPU::Increment16>);
-	instruction_builder.Begin(Opcode::LDD_aHL_A).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterA>, &CPU::UnaryOp_r16<RegisterHL, &CPU::Decrement16>);
-
-	// 16-bit loads
-	instruction_builder.Begin(Opcode::LD_BC_nn).Cycle(&CPU::LoadOp_r8_n8<RegisterC>).Cycle(&CPU::LoadOp_r8_n8<RegisterB>);
-	instruction_builder.Begin(Opcode::LD_DE_nn).Cycle(&CPU::LoadOp_r8_n8<RegisterE>).Cycle(&CPU::LoadOp_r8_n8<RegisterD>);
-	instruction_builder.Begin(Opcode::LD_HL_nn).Cycle(&CPU::LoadOp_r8_n8<RegisterL>).Cycle(&CPU::LoadOp_r8_n8<RegisterH>);
-	instruction_builder.Begin(Opcode::LD_HL_SPn).Cycle(&CPU::LoadOp_r8_n8<RegisterX>).Cycle(&CPU::LoadOp_r16_r16r8<RegisterHL, RegisterSP, RegisterX>);
-	instruction_builder.Begin(Opcode::LD_SP_nn).Cycle(&CPU::LoadOp_r8_n8<RegisterSP_P>).Cycle(&CPU::LoadOp_r8_n8<RegisterSP_S>);
-	instruction_builder.Begin(Opcode::LD_SP_HL).Cycle(&CPU::LoadOp_r16_r16< RegisterSP, RegisterHL>);
-	instruction_builder.Begin(Opcode::LD_ann_SP).Cycle(&CPU::LoadOp_r8_n8<RegisterY>).Cycle(&CPU::LoadOp_r8_n8<RegisterX>).Cycle(&CPU::LoadOp_ar_r8<RegisterXY, RegisterSP_P>, &CPU::UnaryOp_r16<RegisterXY, &CPU::Increment16>).Cycle(&CPU::LoadOp_ar_r8<RegisterXY, RegisterSP_S>);
-
-	// 8-bit add instructions
-	instruction_builder.Begin(Opcode::ADD_A_A, &CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Add8<false>>);
-	instruction_builder.Begin(Opcode::ADD_A_B, &CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Add8<false>>);
-	instruction_builder.Begin(Opcode::ADD_A_C, &CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Add8<false>>);
-	instruction_builder.Begin(Opcode::ADD_A_D, &CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Add8<false>>);
-	instruction_builder.Begin(Opcode::ADD_A_E, &CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Add8<false>>);
-	instruction_builder.Begin(Opcode::ADD_A_H, &CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Add8<false>>);
-	instruction_builder.Begin(Opcode::ADD_A_L, &CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Add8<false>>);
-	instruction_builder.Begin(Opcode::ADD_A_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Add8<false>>);
-	instruction_builder.Begin(Opcode::ADD_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Add8<false>>);
-
-	// 16-bit add instructions
-	instruction_builder.Begin(Opcode::ADD_HL_BC).Cycle(&CPU::BinaryOp_r16_r16<RegisterHL, RegisterBC, &CPU::Add16>);
-	instruction_builder.Begin(Opcode::ADD_HL_DE).Cycle(&CPU::BinaryOp_r16_r16<RegisterHL, RegisterDE, &CPU::Add16>);
-	instruction_builder.Begin(Opcode::ADD_HL_HL).Cycle(&CPU::BinaryOp_r16_r16<RegisterHL, RegisterHL, &CPU::Add16>);
-	instruction_builder.Begin(Opcode::ADD_HL_SP).Cycle(&CPU::BinaryOp_r16_r16<RegisterHL, RegisterSP, &CPU::Add16>);
-	instruction_builder.Begin(Opcode::ADD_SP_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>).Cycle().Cycle(&CPU::AddOp_r16_r8<RegisterSP, RegisterX>);
-
-	// 8-bit subtract instructions
-	instruction_builder.Begin(Opcode::SUB_A_A, &CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Subtract8<false>>);
-	instruction_builder.Begin(Opcode::SUB_A_B, &CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Subtract8<false>>);
-	instruction_builder.Begin(Opcode::SUB_A_C, &CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Subtract8<false>>);
-	instruction_builder.Begin(Opcode::SUB_A_D, &CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Subtract8<false>>);
-	instruction_builder.Begin(Opcode::SUB_A_E, &CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Subtract8<false>>);
-	instruction_builder.Begin(Opcode::SUB_A_H, &CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Subtract8<false>>);
-	instruction_builder.Begin(Opcode::SUB_A_L, &CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Subtract8<false>>);
-	instruction_builder.Begin(Opcode::SUB_A_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<false>>);
-	instruction_builder.Begin(Opcode::SUB_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<false>>);
-
-	// 8-bit add + carry instructions
-	instruction_builder.Begin(Opcode::ADC_A_A, &CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Add8<true>>);
-	instruction_builder.Begin(Opcode::ADC_A_B, &CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Add8<true>>);
-	instruction_builder.Begin(Opcode::ADC_A_C, &CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Add8<true>>);
-	instruction_builder.Begin(Opcode::ADC_A_D, &CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Add8<true>>);
-	instruction_builder.Begin(Opcode::ADC_A_E, &CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Add8<true>>);
-	instruction_builder.Begin(Opcode::ADC_A_H, &CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Add8<true>>);
-	instruction_builder.Begin(Opcode::ADC_A_L, &CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Add8<true>>);
-	instruction_builder.Begin(Opcode::ADC_A_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Add8<true>>);
-	instruction_builder.Begin(Opcode::ADC_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Add8<true>>);
-
-	// 8-bit subtract + carry instructions
-	instruction_builder.Begin(Opcode::SBC_A_A, &CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Subtract8<true>>);
-	instruction_builder.Begin(Opcode::SBC_A_B, &CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Subtract8<true>>);
-	instruction_builder.Begin(Opcode::SBC_A_C, &CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Subtract8<true>>);
-	instruction_builder.Begin(Opcode::SBC_A_D, &CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Subtract8<true>>);
-	instruction_builder.Begin(Opcode::SBC_A_E, &CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Subtract8<true>>);
-	instruction_builder.Begin(Opcode::SBC_A_H, &CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Subtract8<true>>);
-	instruction_builder.Begin(Opcode::SBC_A_L, &CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Subtract8<true>>);
-	instruction_builder.Begin(Opcode::SBC_A_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<true>>);
-	instruction_builder.Begin(Opcode::SBC_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<true>>);
-
-	// 8-bit AND instructions
-	instruction_builder.Begin(Opcode::AND_A_A, &CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::AND8>);
-	instruction_builder.Begin(Opcode::AND_A_B, &CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::AND8>);
-	instruction_builder.Begin(Opcode::AND_A_C, &CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::AND8>);
-	instruction_builder.Begin(Opcode::AND_A_D, &CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::AND8>);
-	instruction_builder.Begin(Opcode::AND_A_E, &CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::AND8>);
-	instruction_builder.Begin(Opcode::AND_A_H, &CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::AND8>);
-	instruction_builder.Begin(Opcode::AND_A_L, &CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::AND8>);
-	instruction_builder.Begin(Opcode::AND_A_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::AND8>);
-	instruction_builder.Begin(Opcode::AND_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::AND8>);
-
-	// 8-bit OR instructions
-	instruction_builder.Begin(Opcode::OR_A_A, &CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::OR8>);
-	instruction_builder.Begin(Opcode::OR_A_B, &CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::OR8>);
-	instruction_builder.Begin(Opcode::OR_A_C, &CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::OR8>);
-	instruction_builder.Begin(Opcode::OR_A_D, &CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::OR8>);
-	instruction_builder.Begin(Opcode::OR_A_E, &CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::OR8>);
-	instruction_builder.Begin(Opcode::OR_A_H, &CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::OR8>);
-	instruction_builder.Begin(Opcode::OR_A_L, &CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::OR8>);
-	instruction_builder.Begin(Opcode::OR_A_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::OR8>);
-	instruction_builder.Begin(Opcode::OR_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::OR8>);
-
-	// 8-bit XOR instructions
-	instruction_builder.Begin(Opcode::XOR_A_A, &CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::XOR8>);
-	instruction_builder.Begin(Opcode::XOR_A_B, &CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::XOR8>);
-	instruction_builder.Begin(Opcode::XOR_A_C, &CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::XOR8>);
-	instruction_builder.Begin(Opcode::XOR_A_D, &CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::XOR8>);
-	instruction_builder.Begin(Opcode::XOR_A_E, &CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::XOR8>);
-	instruction_builder.Begin(Opcode::XOR_A_H, &CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::XOR8>);
-	instruction_builder.Begin(Opcode::XOR_A_L, &CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::XOR8>);
-	instruction_builder.Begin(Opcode::XOR_A_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::XOR8>);
-	instruction_builder.Begin(Opcode::XOR_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::XOR8>);
-
-	// 8-bit compare instructions
-	instruction_builder.Begin(Opcode::CP_A_A, &CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Subtract8<false>, false>);
-	instruction_builder.Begin(Opcode::CP_A_B, &CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Subtract8<false>, false>);
-	instruction_builder.Begin(Opcode::CP_A_C, &CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Subtract8<false>, false>);
-	instruction_builder.Begin(Opcode::CP_A_D, &CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Subtract8<false>, false>);
-	instruction_builder.Begin(Opcode::CP_A_E, &CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Subtract8<false>, false>);
-	instruction_builder.Begin(Opcode::CP_A_H, &CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Subtract8<false>, false>);
-	instruction_builder.Begin(Opcode::CP_A_L, &CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Subtract8<false>, false>);
-	instruction_builder.Begin(Opcode::CP_A_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<false>, false>);
-	instruction_builder.Begin(Opcode::CP_A_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<false>, false>);
-
-	// 8-bit increment instructions
-	instruction_builder.Begin(Opcode::INC_A, &CPU::UnaryOp_r8<RegisterA, &CPU::Increment8>);
-	instruction_builder.Begin(Opcode::INC_B, &CPU::UnaryOp_r8<RegisterB, &CPU::Increment8>);
-	instruction_builder.Begin(Opcode::INC_C, &CPU::UnaryOp_r8<RegisterC, &CPU::Increment8>);
-	instruction_builder.Begin(Opcode::INC_D, &CPU::UnaryOp_r8<RegisterD, &CPU::Increment8>);
-	instruction_builder.Begin(Opcode::INC_E, &CPU::UnaryOp_r8<RegisterE, &CPU::Increment8>);
-	instruction_builder.Begin(Opcode::INC_H, &CPU::UnaryOp_r8<RegisterH, &CPU::Increment8>);
-	instruction_builder.Begin(Opcode::INC_L, &CPU::UnaryOp_r8<RegisterL, &CPU::Increment8>);
-	instruction_builder.Begin(Opcode::INC_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::UnaryOp_r8<RegisterX, &CPU::Increment8>).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	// 16-bit increment instructions
-	instruction_builder.Begin(Opcode::INC_BC).Cycle(&CPU::UnaryOp_r16<RegisterBC, &CPU::Increment16>);
-	instruction_builder.Begin(Opcode::INC_DE).Cycle(&CPU::UnaryOp_r16<RegisterDE, &CPU::Increment16>);
-	instruction_builder.Begin(Opcode::INC_HL).Cycle(&CPU::UnaryOp_r16<RegisterHL, &CPU::Increment16>);
-	instruction_builder.Begin(Opcode::INC_SP).Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>);
-
-	// 8-bit decrement instructions
-	instruction_builder.Begin(Opcode::DEC_A, &CPU::UnaryOp_r8<RegisterA, &CPU::Decrement8>);
-	instruction_builder.Begin(Opcode::DEC_B, &CPU::UnaryOp_r8<RegisterB, &CPU::Decrement8>);
-	instruction_builder.Begin(Opcode::DEC_C, &CPU::UnaryOp_r8<RegisterC, &CPU::Decrement8>);
-	instruction_builder.Begin(Opcode::DEC_D, &CPU::UnaryOp_r8<RegisterD, &CPU::Decrement8>);
-	instruction_builder.Begin(Opcode::DEC_E, &CPU::UnaryOp_r8<RegisterE, &CPU::Decrement8>);
-	instruction_builder.Begin(Opcode::DEC_H, &CPU::UnaryOp_r8<RegisterH, &CPU::Decrement8>);
-	instruction_builder.Begin(Opcode::DEC_L, &CPU::UnaryOp_r8<RegisterL, &CPU::Decrement8>);
-	instruction_builder.Begin(Opcode::DEC_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::UnaryOp_r8<RegisterX, &CPU::Decrement8>).Cycle(&CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	// 16-bit decrement instructions
-	instruction_builder.Begin(Opcode::DEC_BC).Cycle(&CPU::UnaryOp_r16<RegisterBC, &CPU::Decrement16>);
-	instruction_builder.Begin(Opcode::DEC_DE).Cycle(&CPU::UnaryOp_r16<RegisterDE, &CPU::Decrement16>);
-	instruction_builder.Begin(Opcode::DEC_HL).Cycle(&CPU::UnaryOp_r16<RegisterHL, &CPU::Decrement16>);
-	instruction_builder.Begin(Opcode::DEC_SP).Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>);
-
-	// 8-bit rotate instructions
-	instruction_builder.Begin(Opcode::RLC_A, &CPU::UnaryOp_r8<RegisterA, &CPU::RotateLeft8<true>>);
-	instruction_builder.Begin(Opcode::RL_A, &CPU::UnaryOp_r8<RegisterA, &CPU::RotateLeftThroughCarry8<true>>);
-	instruction_builder.Begin(Opcode::RRC_A, &CPU::UnaryOp_r8<RegisterA, &CPU::RotateRight8<true>>);
-	instruction_builder.Begin(Opcode::RR_A, &CPU::UnaryOp_r8<RegisterA, &CPU::RotateRightThroughCarry8<true>>);
-
-	// Absolute jump instructions
-	instruction_builder.Begin(Opcode::JP_nn).Cycle(&CPU::LoadOp_r8_n8<RegisterY>).Cycle(&CPU::LoadOp_r8_n8<RegisterX>).Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::JP_NZ_nn).Cycle(&CPU::LoadOp_r8_n8<RegisterY>).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, false>).Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::JP_Z_nn).Cycle(&CPU::LoadOp_r8_n8<RegisterY>).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, true>).Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::JP_NC_nn).Cycle(&CPU::LoadOp_r8_n8<RegisterY>).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, false>).Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::JP_C_nn).Cycle(&CPU::LoadOp_r8_n8<RegisterY>).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, true>).Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::JP_HL, &CPU::JumpOp_r<RegisterHL>);
-
-	// Relative jump instructions
-	instruction_builder.Begin(Opcode::JR_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>).Cycle(&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>);
-	instruction_builder.Begin(Opcode::JR_NZ_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, false>).Cycle(&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>);
-	instruction_builder.Begin(Opcode::JR_Z_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, true>).Cycle(&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>);
-	instruction_builder.Begin(Opcode::JR_NC_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, false>).Cycle(&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>);
-	instruction_builder.Begin(Opcode::JR_C_n).Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, true>).Cycle(&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>);
-
-	// Push instructions
-	instruction_builder.Begin(Opcode::PUSH_AF)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterA>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterF>)
-		.Cycle();
-	instruction_builder.Begin(Opcode::PUSH_BC)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterB>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterC>)
-		.Cycle();
-	instruction_builder.Begin(Opcode::PUSH_DE)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterD>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterE>)
-		.Cycle();
-	instruction_builder.Begin(Opcode::PUSH_HL)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterH>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterL>)
-		.Cycle();
-
-	// Pop instructions
-	instruction_builder.Begin(Opcode::POP_AF)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterF, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>, &CPU::MaskOp_r8<RegisterF, 0b1111'0000>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterA, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>);
-	instruction_builder.Begin(Opcode::POP_BC)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterC, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterB, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>);
-	instruction_builder.Begin(Opcode::POP_DE)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterE, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterD, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>);
-	instruction_builder.Begin(Opcode::POP_HL)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterL, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterH, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>);
-
-	// Call instructions
-	instruction_builder.Begin(Opcode::CALL_nn)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterY>)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterX>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::CALL_NZ_nn)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterY>)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, false>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::CALL_Z_nn)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterY>)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, true>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::CALL_NC_nn)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterY>)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, false>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::CALL_C_nn)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterY>)
-		.Cycle(&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, true>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-
-	// Return instructions
-	instruction_builder.Begin(Opcode::RET)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::RET_NZ)
-		.Cycle(&CPU::FlagCondition<FlagZero, false>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::RET_Z)
-		.Cycle(&CPU::FlagCondition<FlagZero, true>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::RET_NC)
-		.Cycle(&CPU::FlagCondition<FlagCarry, false>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-	instruction_builder.Begin(Opcode::RET_C)
-		.Cycle(&CPU::FlagCondition<FlagCarry, true>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>);
-
-	// Return instructions
-	instruction_builder.Begin(Opcode::RETI)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>)
-		.Cycle(&CPU::JumpOp_r<RegisterXY>, &CPU::EnableInterrupts);
-
-	// Restart instructions
-	instruction_builder.Begin(Opcode::RST_00)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp<0x0000>);
-	instruction_builder.Begin(Opcode::RST_08)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp<0x0008>);
-	instruction_builder.Begin(Opcode::RST_10)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp<0x0010>);
-	instruction_builder.Begin(Opcode::RST_18)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp<0x0018>);
-	instruction_builder.Begin(Opcode::RST_20)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp<0x0020>);
-	instruction_builder.Begin(Opcode::RST_28)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp<0x0028>);
-	instruction_builder.Begin(Opcode::RST_30)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp<0x0030>);
-	instruction_builder.Begin(Opcode::RST_38)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>)
-		.Cycle(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>)
-		.Cycle(&CPU::JumpOp<0x0038>);
-
-	// Misc instructions
-	instruction_builder.Begin(Opcode::CPL_A, &CPU::UnaryOp_r8<RegisterA, &CPU::Complement8>);
-	instruction_builder.Begin(Opcode::DA_A, &CPU::UnaryOp_r8<RegisterA, &CPU::DecimalAdjust8>);
-	instruction_builder.Begin(Opcode::CCF, &CPU::CCF);
-	instruction_builder.Begin(Opcode::SCF, &CPU::SCF);
-
-	// 8-bit rotate instructions
-	extended_instruction_builder.Begin(ExtendedOpcode::RLC_A, &CPU::UnaryOp_r8<RegisterA, &CPU::RotateLeft8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RLC_B, &CPU::UnaryOp_r8<RegisterB, &CPU::RotateLeft8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RLC_C, &CPU::UnaryOp_r8<RegisterC, &CPU::RotateLeft8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RLC_D, &CPU::UnaryOp_r8<RegisterD, &CPU::RotateLeft8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RLC_E, &CPU::UnaryOp_r8<RegisterE, &CPU::RotateLeft8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RLC_H, &CPU::UnaryOp_r8<RegisterH, &CPU::RotateLeft8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RLC_L, &CPU::UnaryOp_r8<RegisterL, &CPU::RotateLeft8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RLC_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::RotateLeft8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RL_A, &CPU::UnaryOp_r8<RegisterA, &CPU::RotateLeftThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RL_B, &CPU::UnaryOp_r8<RegisterB, &CPU::RotateLeftThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RL_C, &CPU::UnaryOp_r8<RegisterC, &CPU::RotateLeftThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RL_D, &CPU::UnaryOp_r8<RegisterD, &CPU::RotateLeftThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RL_E, &CPU::UnaryOp_r8<RegisterE, &CPU::RotateLeftThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RL_H, &CPU::UnaryOp_r8<RegisterH, &CPU::RotateLeftThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RL_L, &CPU::UnaryOp_r8<RegisterL, &CPU::RotateLeftThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RL_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::RotateLeftThroughCarry8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RRC_A, &CPU::UnaryOp_r8<RegisterA, &CPU::RotateRight8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RRC_B, &CPU::UnaryOp_r8<RegisterB, &CPU::RotateRight8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RRC_C, &CPU::UnaryOp_r8<RegisterC, &CPU::RotateRight8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RRC_D, &CPU::UnaryOp_r8<RegisterD, &CPU::RotateRight8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RRC_E, &CPU::UnaryOp_r8<RegisterE, &CPU::RotateRight8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RRC_H, &CPU::UnaryOp_r8<RegisterH, &CPU::RotateRight8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RRC_L, &CPU::UnaryOp_r8<RegisterL, &CPU::RotateRight8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RRC_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::RotateRight8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RR_A, &CPU::UnaryOp_r8<RegisterA, &CPU::RotateRightThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RR_B, &CPU::UnaryOp_r8<RegisterB, &CPU::RotateRightThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RR_C, &CPU::UnaryOp_r8<RegisterC, &CPU::RotateRightThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RR_D, &CPU::UnaryOp_r8<RegisterD, &CPU::RotateRightThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RR_E, &CPU::UnaryOp_r8<RegisterE, &CPU::RotateRightThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RR_H, &CPU::UnaryOp_r8<RegisterH, &CPU::RotateRightThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RR_L, &CPU::UnaryOp_r8<RegisterL, &CPU::RotateRightThroughCarry8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RR_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::RotateRightThroughCarry8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	// 8-bit shift instructions
-	extended_instruction_builder.Begin(ExtendedOpcode::SLA_A, &CPU::UnaryOp_r8<RegisterA, &CPU::ShiftLeft8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SLA_B, &CPU::UnaryOp_r8<RegisterB, &CPU::ShiftLeft8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SLA_C, &CPU::UnaryOp_r8<RegisterC, &CPU::ShiftLeft8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SLA_D, &CPU::UnaryOp_r8<RegisterD, &CPU::ShiftLeft8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SLA_E, &CPU::UnaryOp_r8<RegisterE, &CPU::ShiftLeft8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SLA_H, &CPU::UnaryOp_r8<RegisterH, &CPU::ShiftLeft8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SLA_L, &CPU::UnaryOp_r8<RegisterL, &CPU::ShiftLeft8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SLA_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ShiftLeft8<true>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::SRA_A, &CPU::UnaryOp_r8<RegisterA, &CPU::ShiftRight8<false>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRA_B, &CPU::UnaryOp_r8<RegisterB, &CPU::ShiftRight8<false>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRA_C, &CPU::UnaryOp_r8<RegisterC, &CPU::ShiftRight8<false>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRA_D, &CPU::UnaryOp_r8<RegisterD, &CPU::ShiftRight8<false>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRA_E, &CPU::UnaryOp_r8<RegisterE, &CPU::ShiftRight8<false>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRA_H, &CPU::UnaryOp_r8<RegisterH, &CPU::ShiftRight8<false>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRA_L, &CPU::UnaryOp_r8<RegisterL, &CPU::ShiftRight8<false>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRA_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ShiftRight8<false>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::SRL_A, &CPU::UnaryOp_r8<RegisterA, &CPU::ShiftRight8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRL_B, &CPU::UnaryOp_r8<RegisterB, &CPU::ShiftRight8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRL_C, &CPU::UnaryOp_r8<RegisterC, &CPU::ShiftRight8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRL_D, &CPU::UnaryOp_r8<RegisterD, &CPU::ShiftRight8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRL_E, &CPU::UnaryOp_r8<RegisterE, &CPU::ShiftRight8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRL_H, &CPU::UnaryOp_r8<RegisterH, &CPU::ShiftRight8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRL_L, &CPU::UnaryOp_r8<RegisterL, &CPU::ShiftRight8<true>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SRL_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ShiftRight8<true>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	// 8-bit swap instructions
-	extended_instruction_builder.Begin(ExtendedOpcode::SWAP_A, &CPU::UnaryOp_r8<RegisterA, &CPU::Swap8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SWAP_B, &CPU::UnaryOp_r8<RegisterB, &CPU::Swap8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SWAP_C, &CPU::UnaryOp_r8<RegisterC, &CPU::Swap8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SWAP_D, &CPU::UnaryOp_r8<RegisterD, &CPU::Swap8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SWAP_E, &CPU::UnaryOp_r8<RegisterE, &CPU::Swap8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SWAP_H, &CPU::UnaryOp_r8<RegisterH, &CPU::Swap8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SWAP_L, &CPU::UnaryOp_r8<RegisterL, &CPU::Swap8>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SWAP_aHL).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::Swap8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	// 8-bit test bit instructions
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_A_0, &CPU::BitTestOp_r8_b<RegisterA, 0>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_A_1, &CPU::BitTestOp_r8_b<RegisterA, 1>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_A_2, &CPU::BitTestOp_r8_b<RegisterA, 2>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_A_3, &CPU::BitTestOp_r8_b<RegisterA, 3>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_A_4, &CPU::BitTestOp_r8_b<RegisterA, 4>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_A_5, &CPU::BitTestOp_r8_b<RegisterA, 5>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_A_6, &CPU::BitTestOp_r8_b<RegisterA, 6>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_A_7, &CPU::BitTestOp_r8_b<RegisterA, 7>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_B_0, &CPU::BitTestOp_r8_b<RegisterB, 0>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_B_1, &CPU::BitTestOp_r8_b<RegisterB, 1>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_B_2, &CPU::BitTestOp_r8_b<RegisterB, 2>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_B_3, &CPU::BitTestOp_r8_b<RegisterB, 3>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_B_4, &CPU::BitTestOp_r8_b<RegisterB, 4>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_B_5, &CPU::BitTestOp_r8_b<RegisterB, 5>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_B_6, &CPU::BitTestOp_r8_b<RegisterB, 6>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_B_7, &CPU::BitTestOp_r8_b<RegisterB, 7>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_C_0, &CPU::BitTestOp_r8_b<RegisterC, 0>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_C_1, &CPU::BitTestOp_r8_b<RegisterC, 1>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_C_2, &CPU::BitTestOp_r8_b<RegisterC, 2>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_C_3, &CPU::BitTestOp_r8_b<RegisterC, 3>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_C_4, &CPU::BitTestOp_r8_b<RegisterC, 4>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_C_5, &CPU::BitTestOp_r8_b<RegisterC, 5>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_C_6, &CPU::BitTestOp_r8_b<RegisterC, 6>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_C_7, &CPU::BitTestOp_r8_b<RegisterC, 7>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_D_0, &CPU::BitTestOp_r8_b<RegisterD, 0>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_D_1, &CPU::BitTestOp_r8_b<RegisterD, 1>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_D_2, &CPU::BitTestOp_r8_b<RegisterD, 2>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_D_3, &CPU::BitTestOp_r8_b<RegisterD, 3>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_D_4, &CPU::BitTestOp_r8_b<RegisterD, 4>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_D_5, &CPU::BitTestOp_r8_b<RegisterD, 5>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_D_6, &CPU::BitTestOp_r8_b<RegisterD, 6>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_D_7, &CPU::BitTestOp_r8_b<RegisterD, 7>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_E_0, &CPU::BitTestOp_r8_b<RegisterE, 0>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_E_1, &CPU::BitTestOp_r8_b<RegisterE, 1>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_E_2, &CPU::BitTestOp_r8_b<RegisterE, 2>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_E_3, &CPU::BitTestOp_r8_b<RegisterE, 3>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_E_4, &CPU::BitTestOp_r8_b<RegisterE, 4>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_E_5, &CPU::BitTestOp_r8_b<RegisterE, 5>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_E_6, &CPU::BitTestOp_r8_b<RegisterE, 6>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_E_7, &CPU::BitTestOp_r8_b<RegisterE, 7>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_H_0, &CPU::BitTestOp_r8_b<RegisterH, 0>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_H_1, &CPU::BitTestOp_r8_b<RegisterH, 1>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_H_2, &CPU::BitTestOp_r8_b<RegisterH, 2>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_H_3, &CPU::BitTestOp_r8_b<RegisterH, 3>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_H_4, &CPU::BitTestOp_r8_b<RegisterH, 4>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_H_5, &CPU::BitTestOp_r8_b<RegisterH, 5>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_H_6, &CPU::BitTestOp_r8_b<RegisterH, 6>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_H_7, &CPU::BitTestOp_r8_b<RegisterH, 7>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_L_0, &CPU::BitTestOp_r8_b<RegisterL, 0>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_L_1, &CPU::BitTestOp_r8_b<RegisterL, 1>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_L_2, &CPU::BitTestOp_r8_b<RegisterL, 2>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_L_3, &CPU::BitTestOp_r8_b<RegisterL, 3>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_L_4, &CPU::BitTestOp_r8_b<RegisterL, 4>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_L_5, &CPU::BitTestOp_r8_b<RegisterL, 5>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_L_6, &CPU::BitTestOp_r8_b<RegisterL, 6>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_L_7, &CPU::BitTestOp_r8_b<RegisterL, 7>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_0).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 0>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_1).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 1>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_2).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 2>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_3).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 3>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_4).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 4>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_5).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 5>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_6).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 6>);
-	extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_7).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 7>);
-
-	// 8-bit reset bit instructions
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_A_0, &CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_A_1, &CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_A_2, &CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_A_3, &CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_A_4, &CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_A_5, &CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_A_6, &CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_A_7, &CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_B_0, &CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_B_1, &CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_B_2, &CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_B_3, &CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_B_4, &CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_B_5, &CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_B_6, &CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_B_7, &CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_C_0, &CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_C_1, &CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_C_2, &CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_C_3, &CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_C_4, &CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_C_5, &CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_C_6, &CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_C_7, &CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_D_0, &CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_D_1, &CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_D_2, &CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_D_3, &CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_D_4, &CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_D_5, &CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_D_6, &CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_D_7, &CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_E_0, &CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_E_1, &CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_E_2, &CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_E_3, &CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_E_4, &CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_E_5, &CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_E_6, &CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_E_7, &CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_H_0, &CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_H_1, &CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_H_2, &CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_H_3, &CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_H_4, &CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_H_5, &CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_H_6, &CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_H_7, &CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_L_0, &CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_L_1, &CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_L_2, &CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_L_3, &CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_L_4, &CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_L_5, &CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_L_6, &CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_L_7, &CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_0).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<0>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_1).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<1>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_2).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<2>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_3).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<3>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_4).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<4>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_5).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<5>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_6).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<6>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_7).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<7>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	// 8-bit set bit instructions
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_A_0, &CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_A_1, &CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_A_2, &CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_A_3, &CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_A_4, &CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_A_5, &CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_A_6, &CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_A_7, &CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_B_0, &CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_B_1, &CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_B_2, &CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_B_3, &CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_B_4, &CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_B_5, &CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_B_6, &CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_B_7, &CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_C_0, &CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_C_1, &CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_C_2, &CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_C_3, &CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_C_4, &CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_C_5, &CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_C_6, &CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_C_7, &CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_D_0, &CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_D_1, &CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_D_2, &CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_D_3, &CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_D_4, &CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_D_5, &CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_D_6, &CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_D_7, &CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_E_0, &CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_E_1, &CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_E_2, &CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_E_3, &CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_E_4, &CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_E_5, &CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_E_6, &CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_E_7, &CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_H_0, &CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_H_1, &CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_H_2, &CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_H_3, &CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_H_4, &CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_H_5, &CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_H_6, &CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_H_7, &CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_L_0, &CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<0>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_L_1, &CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<1>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_L_2, &CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<2>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_L_3, &CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<3>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_L_4, &CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<4>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_L_5, &CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<5>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_L_6, &CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<6>>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_L_7, &CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<7>>);
-
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_0).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<0>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_1).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<1>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_2).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<2>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_3).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<3>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_4).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<4>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_5).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<5>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_6).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<6>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-	extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_7).Cycle(&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>).Cycle(&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<7>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>);
-
-	// Build instruction sets
-	m_Instructions = instruction_builder.Build();
-	m_ExtendedInstructions = extended_instruction_builder.Build();
+	m_Memory(a_Memory),
+	m_MMU(dynamic_cast<MMU*>(&a_Memory))
+{
+	m_DecodeOp = &CPU::DecodeInstruction;
 
 	// Reset CPU
 	Reset();
 }
 
+const InstructionSet<Opcode::Enum, CPU::MicroOp>& CPU::GetInstructions() noexcept
+{
+	static constexpr auto instruction_builder = []
+	{
+		InstructionBuilder<Opcode::Enum, MicroOp, &CPU::Break, 256> instruction_builder;
+
+		for (size_t i = 0; i < 256; ++i)
+		{
+			instruction_builder.Begin<&CPU::NotImplemented>(static_cast<Opcode::Enum>(i));
+		}
+
+		// Misc instructions
+		instruction_builder.Begin(Opcode::NOP);
+		instruction_builder.Begin<&CPU::DelayOp<&CPU::DisableInterrupts, 1>>(Opcode::DI);
+		instruction_builder.Begin<&CPU::DelayOp<&CPU::EnableInterrupts, 1>>(Opcode::EI);
+		instruction_builder.Begin<&CPU::DelayOp<&CPU::Halt, 1>>(Opcode::HALT);
+		instruction_builder.Begin<&CPU::DecodeExtendedInstruction>(Opcode::EXT);
+
+		// 8-bit load register to register
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterA, RegisterA>>(Opcode::LD_A_A);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterA, RegisterB>>(Opcode::LD_A_B);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterA, RegisterC>>(Opcode::LD_A_C);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterA, RegisterD>>(Opcode::LD_A_D);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterA, RegisterE>>(Opcode::LD_A_E);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterA, RegisterH>>(Opcode::LD_A_H);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterA, RegisterL>>(Opcode::LD_A_L);
+
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterB, RegisterA>>(Opcode::LD_B_A);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterB, RegisterB>>(Opcode::LD_B_B);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterB, RegisterC>>(Opcode::LD_B_C);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterB, RegisterD>>(Opcode::LD_B_D);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterB, RegisterE>>(Opcode::LD_B_E);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterB, RegisterH>>(Opcode::LD_B_H);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterB, RegisterL>>(Opcode::LD_B_L);
+
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterC, RegisterA>>(Opcode::LD_C_A);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterC, RegisterB>>(Opcode::LD_C_B);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterC, RegisterC>>(Opcode::LD_C_C);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterC, RegisterD>>(Opcode::LD_C_D);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterC, RegisterE>>(Opcode::LD_C_E);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterC, RegisterH>>(Opcode::LD_C_H);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterC, RegisterL>>(Opcode::LD_C_L);
+
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterD, RegisterA>>(Opcode::LD_D_A);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterD, RegisterB>>(Opcode::LD_D_B);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterD, RegisterC>>(Opcode::LD_D_C);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterD, RegisterD>>(Opcode::LD_D_D);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterD, RegisterE>>(Opcode::LD_D_E);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterD, RegisterH>>(Opcode::LD_D_H);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterD, RegisterL>>(Opcode::LD_D_L);
+
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterE, RegisterA>>(Opcode::LD_E_A);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterE, RegisterB>>(Opcode::LD_E_B);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterE, RegisterC>>(Opcode::LD_E_C);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterE, RegisterD>>(Opcode::LD_E_D);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterE, RegisterE>>(Opcode::LD_E_E);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterE, RegisterH>>(Opcode::LD_E_H);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterE, RegisterL>>(Opcode::LD_E_L);
+
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterH, RegisterA>>(Opcode::LD_H_A);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterH, RegisterB>>(Opcode::LD_H_B);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterH, RegisterC>>(Opcode::LD_H_C);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterH, RegisterD>>(Opcode::LD_H_D);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterH, RegisterE>>(Opcode::LD_H_E);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterH, RegisterH>>(Opcode::LD_H_H);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterH, RegisterL>>(Opcode::LD_H_L);
+
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterL, RegisterA>>(Opcode::LD_L_A);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterL, RegisterB>>(Opcode::LD_L_B);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterL, RegisterC>>(Opcode::LD_L_C);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterL, RegisterD>>(Opcode::LD_L_D);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterL, RegisterE>>(Opcode::LD_L_E);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterL, RegisterH>>(Opcode::LD_L_H);
+		instruction_builder.Begin<&CPU::LoadOp_r8_r8<RegisterL, RegisterL>>(Opcode::LD_L_L);
+
+		// 8-bit load next byte to register
+		instruction_builder.Begin(Opcode::LD_A_n).Cycle<&CPU::LoadOp_r8_n8<RegisterA>>();
+		instruction_builder.Begin(Opcode::LD_B_n).Cycle<&CPU::LoadOp_r8_n8<RegisterB>>();
+		instruction_builder.Begin(Opcode::LD_C_n).Cycle<&CPU::LoadOp_r8_n8<RegisterC>>();
+		instruction_builder.Begin(Opcode::LD_D_n).Cycle<&CPU::LoadOp_r8_n8<RegisterD>>();
+		instruction_builder.Begin(Opcode::LD_E_n).Cycle<&CPU::LoadOp_r8_n8<RegisterE>>();
+		instruction_builder.Begin(Opcode::LD_H_n).Cycle<&CPU::LoadOp_r8_n8<RegisterH>>();
+		instruction_builder.Begin(Opcode::LD_L_n).Cycle<&CPU::LoadOp_r8_n8<RegisterL>>();
+
+		// 8-bit load byte at address to register
+		instruction_builder.Begin(Opcode::LD_A_aBC).Cycle<&CPU::LoadOp_r8_ar<RegisterA, RegisterBC>>();
+		instruction_builder.Begin(Opcode::LD_A_aDE).Cycle<&CPU::LoadOp_r8_ar<RegisterA, RegisterDE>>();
+		instruction_builder.Begin(Opcode::LD_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterA, RegisterHL>>();
+		instruction_builder.Begin(Opcode::LD_B_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterB, RegisterHL>>();
+		instruction_builder.Begin(Opcode::LD_C_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterC, RegisterHL>>();
+		instruction_builder.Begin(Opcode::LD_D_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterD, RegisterHL>>();
+		instruction_builder.Begin(Opcode::LD_E_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterE, RegisterHL>>();
+		instruction_builder.Begin(Opcode::LD_H_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterH, RegisterHL>>();
+		instruction_builder.Begin(Opcode::LD_L_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterL, RegisterHL>>();
+
+		// 8-bit load misc to register
+		instruction_builder.Begin(Opcode::LD_A_ann).Cycle<&CPU::LoadOp_r8_n8<RegisterY>>().Cycle<&CPU::LoadOp_r8_n8<RegisterX>>().Cycle<&CPU::LoadOp_r8_ar<RegisterA, RegisterXY>>();
+		instruction_builder.Begin(Opcode::LD_A_aFFC).Cycle<&CPU::LoadOp_r16_FFr8<RegisterXY, RegisterC>, &CPU::LoadOp_r8_ar<RegisterA, RegisterXY>>();
+		instruction_builder.Begin(Opcode::LD_A_aFFn).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::LoadOp_r16_FFr8<RegisterXY, RegisterX>>().Cycle<&CPU::LoadOp_r8_ar<RegisterA, RegisterXY>>();
+
+		// 8 bit load register to address
+		instruction_builder.Begin(Opcode::LD_aBC_A).Cycle<&CPU::LoadOp_ar_r8<RegisterBC, RegisterA>>();
+		instruction_builder.Begin(Opcode::LD_aDE_A).Cycle<&CPU::LoadOp_ar_r8<RegisterDE, RegisterA>>();
+		instruction_builder.Begin(Opcode::LD_aHL_A).Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterA>>();
+		instruction_builder.Begin(Opcode::LD_aHL_B).Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterB>>();
+		instruction_builder.Begin(Opcode::LD_aHL_C).Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterC>>();
+		instruction_builder.Begin(Opcode::LD_aHL_D).Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterD>>();
+		instruction_builder.Begin(Opcode::LD_aHL_E).Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterE>>();
+		instruction_builder.Begin(Opcode::LD_aHL_H).Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterH>>();
+		instruction_builder.Begin(Opcode::LD_aHL_L).Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterL>>();
+
+		// 8 bit load next byte to address
+		instruction_builder.Begin(Opcode::LD_aHL_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>>().Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		// 8-bit load misc to address
+		instruction_builder.Begin(Opcode::LD_ann_A).Cycle<&CPU::LoadOp_r8_n8<RegisterY>>().Cycle<&CPU::LoadOp_r8_n8<RegisterX>>().Cycle<&CPU::LoadOp_ar_r8<RegisterXY, RegisterA>>();
+		instruction_builder.Begin(Opcode::LD_aFFC_A).Cycle<&CPU::LoadOp_r16_FFr8<RegisterXY, RegisterC>, &CPU::LoadOp_ar_r8<RegisterXY, RegisterA>>();
+		instruction_builder.Begin(Opcode::LD_aFFn_A).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::LoadOp_r16_FFr8<RegisterXY, RegisterX>>().Cycle<&CPU::LoadOp_ar_r8<RegisterXY, RegisterA>>();
+
+		// 8-bit load and increment/decrement
+		instruction_builder.Begin(Opcode::LDI_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterA, RegisterHL>, &CPU::UnaryOp_r16<RegisterHL, &CPU::Increment16>>();
+		instruction_builder.Begin(Opcode::LDD_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterA, RegisterHL>, &CPU::UnaryOp_r16<RegisterHL, &CPU::Decrement16>>();
+		instruction_builder.Begin(Opcode::LDI_aHL_A).Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterA>, &CPU::UnaryOp_r16<RegisterHL, &CPU::Increment16>>();
+		instruction_builder.Begin(Opcode::LDD_aHL_A).Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterA>, &CPU::UnaryOp_r16<RegisterHL, &CPU::Decrement16>>();
+
+		// 16-bit loads
+		instruction_builder.Begin(Opcode::LD_BC_nn).Cycle<&CPU::LoadOp_r8_n8<RegisterC>>().Cycle<&CPU::LoadOp_r8_n8<RegisterB>>();
+		instruction_builder.Begin(Opcode::LD_DE_nn).Cycle<&CPU::LoadOp_r8_n8<RegisterE>>().Cycle<&CPU::LoadOp_r8_n8<RegisterD>>();
+		instruction_builder.Begin(Opcode::LD_HL_nn).Cycle<&CPU::LoadOp_r8_n8<RegisterL>>().Cycle<&CPU::LoadOp_r8_n8<RegisterH>>();
+		instruction_builder.Begin(Opcode::LD_HL_SPn).Cycle<&CPU::LoadOp_r8_n8<RegisterX>>().Cycle<&CPU::LoadOp_r16_r16r8<RegisterHL, RegisterSP, RegisterX>>();
+		instruction_builder.Begin(Opcode::LD_SP_nn).Cycle<&CPU::LoadOp_r8_n8<RegisterSP_P>>().Cycle<&CPU::LoadOp_r8_n8<RegisterSP_S>>();
+		instruction_builder.Begin(Opcode::LD_SP_HL).Cycle<&CPU::LoadOp_r16_r16< RegisterSP, RegisterHL>>();
+		instruction_builder.Begin(Opcode::LD_ann_SP).Cycle<&CPU::LoadOp_r8_n8<RegisterY>>().Cycle<&CPU::LoadOp_r8_n8<RegisterX>>().Cycle<&CPU::LoadOp_ar_r8<RegisterXY, RegisterSP_P>, &CPU::UnaryOp_r16<RegisterXY, &CPU::Increment16>>().Cycle<&CPU::LoadOp_ar_r8<RegisterXY, RegisterSP_S>>();
+
+		// 8-bit add instructions
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Add8<false>>>(Opcode::ADD_A_A);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Add8<false>>>(Opcode::ADD_A_B);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Add8<false>>>(Opcode::ADD_A_C);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Add8<false>>>(Opcode::ADD_A_D);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Add8<false>>>(Opcode::ADD_A_E);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Add8<false>>>(Opcode::ADD_A_H);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Add8<false>>>(Opcode::ADD_A_L);
+		instruction_builder.Begin(Opcode::ADD_A_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Add8<false>>>();
+		instruction_builder.Begin(Opcode::ADD_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Add8<false>>>();
+
+		// 16-bit add instructions
+		instruction_builder.Begin(Opcode::ADD_HL_BC).Cycle<&CPU::BinaryOp_r16_r16<RegisterHL, RegisterBC, &CPU::Add16>>();
+		instruction_builder.Begin(Opcode::ADD_HL_DE).Cycle<&CPU::BinaryOp_r16_r16<RegisterHL, RegisterDE, &CPU::Add16>>();
+		instruction_builder.Begin(Opcode::ADD_HL_HL).Cycle<&CPU::BinaryOp_r16_r16<RegisterHL, RegisterHL, &CPU::Add16>>();
+		instruction_builder.Begin(Opcode::ADD_HL_SP).Cycle<&CPU::BinaryOp_r16_r16<RegisterHL, RegisterSP, &CPU::Add16>>();
+		instruction_builder.Begin(Opcode::ADD_SP_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>>().Cycle().Cycle<&CPU::AddOp_r16_r8<RegisterSP, RegisterX>>();
+
+		// 8-bit subtract instructions
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Subtract8<false>>>(Opcode::SUB_A_A);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Subtract8<false>>>(Opcode::SUB_A_B);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Subtract8<false>>>(Opcode::SUB_A_C);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Subtract8<false>>>(Opcode::SUB_A_D);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Subtract8<false>>>(Opcode::SUB_A_E);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Subtract8<false>>>(Opcode::SUB_A_H);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Subtract8<false>>>(Opcode::SUB_A_L);
+		instruction_builder.Begin(Opcode::SUB_A_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<false>>>();
+		instruction_builder.Begin(Opcode::SUB_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<false>>>();
+
+		// 8-bit add + carry instructions
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Add8<true>>>(Opcode::ADC_A_A);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Add8<true>>>(Opcode::ADC_A_B);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Add8<true>>>(Opcode::ADC_A_C);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Add8<true>>>(Opcode::ADC_A_D);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Add8<true>>>(Opcode::ADC_A_E);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Add8<true>>>(Opcode::ADC_A_H);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Add8<true>>>(Opcode::ADC_A_L);
+		instruction_builder.Begin(Opcode::ADC_A_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Add8<true>>>();
+		instruction_builder.Begin(Opcode::ADC_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Add8<true>>>();
+
+		// 8-bit subtract + carry instructions
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Subtract8<true>>>(Opcode::SBC_A_A);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Subtract8<true>>>(Opcode::SBC_A_B);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Subtract8<true>>>(Opcode::SBC_A_C);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Subtract8<true>>>(Opcode::SBC_A_D);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Subtract8<true>>>(Opcode::SBC_A_E);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Subtract8<true>>>(Opcode::SBC_A_H);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Subtract8<true>>>(Opcode::SBC_A_L);
+		instruction_builder.Begin(Opcode::SBC_A_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<true>>>();
+		instruction_builder.Begin(Opcode::SBC_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<true>>>();
+
+		// 8-bit AND instructions
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::AND8>>(Opcode::AND_A_A);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::AND8>>(Opcode::AND_A_B);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::AND8>>(Opcode::AND_A_C);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::AND8>>(Opcode::AND_A_D);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::AND8>>(Opcode::AND_A_E);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::AND8>>(Opcode::AND_A_H);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::AND8>>(Opcode::AND_A_L);
+		instruction_builder.Begin(Opcode::AND_A_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::AND8>>();
+		instruction_builder.Begin(Opcode::AND_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::AND8>>();
+
+		// 8-bit OR instructions
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::OR8>>(Opcode::OR_A_A);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::OR8>>(Opcode::OR_A_B);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::OR8>>(Opcode::OR_A_C);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::OR8>>(Opcode::OR_A_D);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::OR8>>(Opcode::OR_A_E);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::OR8>>(Opcode::OR_A_H);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::OR8>>(Opcode::OR_A_L);
+		instruction_builder.Begin(Opcode::OR_A_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::OR8>>();
+		instruction_builder.Begin(Opcode::OR_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::OR8>>();
+
+		// 8-bit XOR instructions
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::XOR8>>(Opcode::XOR_A_A);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::XOR8>>(Opcode::XOR_A_B);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::XOR8>>(Opcode::XOR_A_C);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::XOR8>>(Opcode::XOR_A_D);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::XOR8>>(Opcode::XOR_A_E);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::XOR8>>(Opcode::XOR_A_H);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::XOR8>>(Opcode::XOR_A_L);
+		instruction_builder.Begin(Opcode::XOR_A_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::XOR8>>();
+		instruction_builder.Begin(Opcode::XOR_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::XOR8>>();
+
+		// 8-bit compare instructions
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterA, &CPU::Subtract8<false>, false>>(Opcode::CP_A_A);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterB, &CPU::Subtract8<false>, false>>(Opcode::CP_A_B);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterC, &CPU::Subtract8<false>, false>>(Opcode::CP_A_C);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterD, &CPU::Subtract8<false>, false>>(Opcode::CP_A_D);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterE, &CPU::Subtract8<false>, false>>(Opcode::CP_A_E);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterH, &CPU::Subtract8<false>, false>>(Opcode::CP_A_H);
+		instruction_builder.Begin<&CPU::BinaryOp_r8_r8<RegisterA, RegisterL, &CPU::Subtract8<false>, false>>(Opcode::CP_A_L);
+		instruction_builder.Begin(Opcode::CP_A_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<false>, false>>();
+		instruction_builder.Begin(Opcode::CP_A_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BinaryOp_r8_r8<RegisterA, RegisterX, &CPU::Subtract8<false>, false>>();
+
+		// 8-bit increment instructions
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::Increment8>>(Opcode::INC_A);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::Increment8>>(Opcode::INC_B);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::Increment8>>(Opcode::INC_C);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::Increment8>>(Opcode::INC_D);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::Increment8>>(Opcode::INC_E);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::Increment8>>(Opcode::INC_H);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::Increment8>>(Opcode::INC_L);
+		instruction_builder.Begin(Opcode::INC_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::UnaryOp_r8<RegisterX, &CPU::Increment8>>().Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		// 16-bit increment instructions
+		instruction_builder.Begin(Opcode::INC_BC).Cycle<&CPU::UnaryOp_r16<RegisterBC, &CPU::Increment16>>();
+		instruction_builder.Begin(Opcode::INC_DE).Cycle<&CPU::UnaryOp_r16<RegisterDE, &CPU::Increment16>>();
+		instruction_builder.Begin(Opcode::INC_HL).Cycle<&CPU::UnaryOp_r16<RegisterHL, &CPU::Increment16>>();
+		instruction_builder.Begin(Opcode::INC_SP).Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>();
+
+		// 8-bit decrement instructions
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::Decrement8>>(Opcode::DEC_A);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::Decrement8>>(Opcode::DEC_B);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::Decrement8>>(Opcode::DEC_C);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::Decrement8>>(Opcode::DEC_D);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::Decrement8>>(Opcode::DEC_E);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::Decrement8>>(Opcode::DEC_H);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::Decrement8>>(Opcode::DEC_L);
+		instruction_builder.Begin(Opcode::DEC_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::UnaryOp_r8<RegisterX, &CPU::Decrement8>>().Cycle<&CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		// 16-bit decrement instructions
+		instruction_builder.Begin(Opcode::DEC_BC).Cycle<&CPU::UnaryOp_r16<RegisterBC, &CPU::Decrement16>>();
+		instruction_builder.Begin(Opcode::DEC_DE).Cycle<&CPU::UnaryOp_r16<RegisterDE, &CPU::Decrement16>>();
+		instruction_builder.Begin(Opcode::DEC_HL).Cycle<&CPU::UnaryOp_r16<RegisterHL, &CPU::Decrement16>>();
+		instruction_builder.Begin(Opcode::DEC_SP).Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>>();
+
+		// 8-bit rotate instructions
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::RotateLeft8<true>>>(Opcode::RLC_A);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::RotateLeftThroughCarry8<true>>>(Opcode::RL_A);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::RotateRight8<true>>>(Opcode::RRC_A);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::RotateRightThroughCarry8<true>>>(Opcode::RR_A);
+
+		// Absolute jump instructions
+		instruction_builder.Begin(Opcode::JP_nn).Cycle<&CPU::LoadOp_r8_n8<RegisterY>>().Cycle<&CPU::LoadOp_r8_n8<RegisterX>>().Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::JP_NZ_nn).Cycle<&CPU::LoadOp_r8_n8<RegisterY>>().Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, false>>().Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::JP_Z_nn).Cycle<&CPU::LoadOp_r8_n8<RegisterY>>().Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, true>>().Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::JP_NC_nn).Cycle<&CPU::LoadOp_r8_n8<RegisterY>>().Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, false>>().Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::JP_C_nn).Cycle<&CPU::LoadOp_r8_n8<RegisterY>>().Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, true>>().Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin<&CPU::JumpOp_r<RegisterHL>>(Opcode::JP_HL);
+
+		// Relative jump instructions
+		instruction_builder.Begin(Opcode::JR_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>>().Cycle<&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>>();
+		instruction_builder.Begin(Opcode::JR_NZ_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, false>>().Cycle<&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>>();
+		instruction_builder.Begin(Opcode::JR_Z_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, true>>().Cycle<&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>>();
+		instruction_builder.Begin(Opcode::JR_NC_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, false>>().Cycle<&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>>();
+		instruction_builder.Begin(Opcode::JR_C_n).Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, true>>().Cycle<&CPU::JumpOp_r16_r8<RegisterPC, RegisterX>>();
+
+		// Push instructions
+		instruction_builder.Begin(Opcode::PUSH_AF)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterA>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterF>>()
+			.Cycle();
+		instruction_builder.Begin(Opcode::PUSH_BC)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterB>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterC>>()
+			.Cycle();
+		instruction_builder.Begin(Opcode::PUSH_DE)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterD>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterE>>()
+			.Cycle();
+		instruction_builder.Begin(Opcode::PUSH_HL)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterH>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterL>>()
+			.Cycle();
+
+		// Pop instructions
+		instruction_builder.Begin(Opcode::POP_AF)
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterF, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>, &CPU::MaskOp_r8<RegisterF, 0b1111'0000>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterA, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>();
+		instruction_builder.Begin(Opcode::POP_BC)
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterC, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterB, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>();
+		instruction_builder.Begin(Opcode::POP_DE)
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterE, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterD, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>();
+		instruction_builder.Begin(Opcode::POP_HL)
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterL, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterH, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>();
+
+		// Call instructions
+		instruction_builder.Begin(Opcode::CALL_nn)
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterY>>()
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterX>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::CALL_NZ_nn)
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterY>>()
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, false>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::CALL_Z_nn)
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterY>>()
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagZero, true>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::CALL_NC_nn)
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterY>>()
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, false>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::CALL_C_nn)
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterY>>()
+			.Cycle<&CPU::LoadOp_r8_n8<RegisterX>, &CPU::FlagCondition<FlagCarry, true>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+
+		// Return instructions
+		instruction_builder.Begin(Opcode::RET)
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::RET_NZ)
+			.Cycle<&CPU::FlagCondition<FlagZero, false>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::RET_Z)
+			.Cycle<&CPU::FlagCondition<FlagZero, true>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::RET_NC)
+			.Cycle<&CPU::FlagCondition<FlagCarry, false>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+		instruction_builder.Begin(Opcode::RET_C)
+			.Cycle<&CPU::FlagCondition<FlagCarry, true>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>>();
+
+		// Return instructions
+		instruction_builder.Begin(Opcode::RETI)
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterY, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterSP>, &CPU::UnaryOp_r16<RegisterSP, &CPU::Increment16>>()
+			.Cycle<&CPU::JumpOp_r<RegisterXY>, &CPU::EnableInterrupts>();
+
+		// Restart instructions
+		instruction_builder.Begin(Opcode::RST_00)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp<0x0000>>();
+		instruction_builder.Begin(Opcode::RST_08)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp<0x0008>>();
+		instruction_builder.Begin(Opcode::RST_10)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp<0x0010>>();
+		instruction_builder.Begin(Opcode::RST_18)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp<0x0018>>();
+		instruction_builder.Begin(Opcode::RST_20)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp<0x0020>>();
+		instruction_builder.Begin(Opcode::RST_28)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp<0x0028>>();
+		instruction_builder.Begin(Opcode::RST_30)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp<0x0030>>();
+		instruction_builder.Begin(Opcode::RST_38)
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>>()
+			.Cycle<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>>()
+			.Cycle<&CPU::JumpOp<0x0038>>();
+
+		// Misc instructions
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::Complement8>>(Opcode::CPL_A);
+		instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::DecimalAdjust8>>(Opcode::DA_A);
+		instruction_builder.Begin<&CPU::CCF>(Opcode::CCF);
+		instruction_builder.Begin<&CPU::SCF>(Opcode::SCF);
+
+		return instruction_builder;
+	}();
+
+	static constexpr auto instruction_table = instruction_builder.Build<instruction_builder.GetOpCount()>();
+	static constexpr auto instructions = instruction_table.GetInstructionSet();
+	return instructions;
+}
+
+const InstructionSet<ExtendedOpcode::Enum, CPU::MicroOp>& CPU::GetExtendedInstructions() noexcept
+{
+	static constexpr auto extended_instruction_builder = []
+	{
+		InstructionBuilder<ExtendedOpcode::Enum, MicroOp, &CPU::Break, 256> extended_instruction_builder;
+
+		for (size_t i = 0; i < 256; ++i)
+		{
+			extended_instruction_builder.Begin<&CPU::NotImplemented>(static_cast<ExtendedOpcode::Enum>(i));
+		}
+
+		// 8-bit rotate instructions
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::RotateLeft8>>(ExtendedOpcode::RLC_A);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::RotateLeft8>>(ExtendedOpcode::RLC_B);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::RotateLeft8>>(ExtendedOpcode::RLC_C);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::RotateLeft8>>(ExtendedOpcode::RLC_D);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::RotateLeft8>>(ExtendedOpcode::RLC_E);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::RotateLeft8>>(ExtendedOpcode::RLC_H);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::RotateLeft8>>(ExtendedOpcode::RLC_L);
+		extended_instruction_builder.Begin(ExtendedOpcode::RLC_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::RotateLeft8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::RotateLeftThroughCarry8>>(ExtendedOpcode::RL_A);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::RotateLeftThroughCarry8>>(ExtendedOpcode::RL_B);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::RotateLeftThroughCarry8>>(ExtendedOpcode::RL_C);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::RotateLeftThroughCarry8>>(ExtendedOpcode::RL_D);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::RotateLeftThroughCarry8>>(ExtendedOpcode::RL_E);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::RotateLeftThroughCarry8>>(ExtendedOpcode::RL_H);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::RotateLeftThroughCarry8>>(ExtendedOpcode::RL_L);
+		extended_instruction_builder.Begin(ExtendedOpcode::RL_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::RotateLeftThroughCarry8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::RotateRight8>>(ExtendedOpcode::RRC_A);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::RotateRight8>>(ExtendedOpcode::RRC_B);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::RotateRight8>>(ExtendedOpcode::RRC_C);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::RotateRight8>>(ExtendedOpcode::RRC_D);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::RotateRight8>>(ExtendedOpcode::RRC_E);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::RotateRight8>>(ExtendedOpcode::RRC_H);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::RotateRight8>>(ExtendedOpcode::RRC_L);
+		extended_instruction_builder.Begin(ExtendedOpcode::RRC_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::RotateRight8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::RotateRightThroughCarry8>>(ExtendedOpcode::RR_A);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::RotateRightThroughCarry8>>(ExtendedOpcode::RR_B);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::RotateRightThroughCarry8>>(ExtendedOpcode::RR_C);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::RotateRightThroughCarry8>>(ExtendedOpcode::RR_D);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::RotateRightThroughCarry8>>(ExtendedOpcode::RR_E);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::RotateRightThroughCarry8>>(ExtendedOpcode::RR_H);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::RotateRightThroughCarry8>>(ExtendedOpcode::RR_L);
+		extended_instruction_builder.Begin(ExtendedOpcode::RR_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::RotateRightThroughCarry8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		// 8-bit shift instructions
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ShiftLeft8<true>>>(ExtendedOpcode::SLA_A);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ShiftLeft8<true>>>(ExtendedOpcode::SLA_B);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ShiftLeft8<true>>>(ExtendedOpcode::SLA_C);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ShiftLeft8<true>>>(ExtendedOpcode::SLA_D);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ShiftLeft8<true>>>(ExtendedOpcode::SLA_E);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ShiftLeft8<true>>>(ExtendedOpcode::SLA_H);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ShiftLeft8<true>>>(ExtendedOpcode::SLA_L);
+		extended_instruction_builder.Begin(ExtendedOpcode::SLA_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ShiftLeft8<true>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ShiftRight8<false>>>(ExtendedOpcode::SRA_A);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ShiftRight8<false>>>(ExtendedOpcode::SRA_B);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ShiftRight8<false>>>(ExtendedOpcode::SRA_C);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ShiftRight8<false>>>(ExtendedOpcode::SRA_D);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ShiftRight8<false>>>(ExtendedOpcode::SRA_E);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ShiftRight8<false>>>(ExtendedOpcode::SRA_H);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ShiftRight8<false>>>(ExtendedOpcode::SRA_L);
+		extended_instruction_builder.Begin(ExtendedOpcode::SRA_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ShiftRight8<false>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ShiftRight8<true>>>(ExtendedOpcode::SRL_A);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ShiftRight8<true>>>(ExtendedOpcode::SRL_B);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ShiftRight8<true>>>(ExtendedOpcode::SRL_C);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ShiftRight8<true>>>(ExtendedOpcode::SRL_D);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ShiftRight8<true>>>(ExtendedOpcode::SRL_E);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ShiftRight8<true>>>(ExtendedOpcode::SRL_H);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ShiftRight8<true>>>(ExtendedOpcode::SRL_L);
+		extended_instruction_builder.Begin(ExtendedOpcode::SRL_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ShiftRight8<true>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		// 8-bit swap instructions
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::Swap8>>(ExtendedOpcode::SWAP_A);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::Swap8>>(ExtendedOpcode::SWAP_B);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::Swap8>>(ExtendedOpcode::SWAP_C);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::Swap8>>(ExtendedOpcode::SWAP_D);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::Swap8>>(ExtendedOpcode::SWAP_E);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::Swap8>>(ExtendedOpcode::SWAP_H);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::Swap8>>(ExtendedOpcode::SWAP_L);
+		extended_instruction_builder.Begin(ExtendedOpcode::SWAP_aHL).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::Swap8>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		// 8-bit test bit instructions
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterA, 0>>(ExtendedOpcode::BIT_A_0);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterA, 1>>(ExtendedOpcode::BIT_A_1);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterA, 2>>(ExtendedOpcode::BIT_A_2);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterA, 3>>(ExtendedOpcode::BIT_A_3);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterA, 4>>(ExtendedOpcode::BIT_A_4);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterA, 5>>(ExtendedOpcode::BIT_A_5);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterA, 6>>(ExtendedOpcode::BIT_A_6);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterA, 7>>(ExtendedOpcode::BIT_A_7);
+
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterB, 0>>(ExtendedOpcode::BIT_B_0);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterB, 1>>(ExtendedOpcode::BIT_B_1);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterB, 2>>(ExtendedOpcode::BIT_B_2);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterB, 3>>(ExtendedOpcode::BIT_B_3);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterB, 4>>(ExtendedOpcode::BIT_B_4);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterB, 5>>(ExtendedOpcode::BIT_B_5);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterB, 6>>(ExtendedOpcode::BIT_B_6);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterB, 7>>(ExtendedOpcode::BIT_B_7);
+
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterC, 0>>(ExtendedOpcode::BIT_C_0);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterC, 1>>(ExtendedOpcode::BIT_C_1);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterC, 2>>(ExtendedOpcode::BIT_C_2);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterC, 3>>(ExtendedOpcode::BIT_C_3);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterC, 4>>(ExtendedOpcode::BIT_C_4);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterC, 5>>(ExtendedOpcode::BIT_C_5);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterC, 6>>(ExtendedOpcode::BIT_C_6);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterC, 7>>(ExtendedOpcode::BIT_C_7);
+
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterD, 0>>(ExtendedOpcode::BIT_D_0);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterD, 1>>(ExtendedOpcode::BIT_D_1);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterD, 2>>(ExtendedOpcode::BIT_D_2);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterD, 3>>(ExtendedOpcode::BIT_D_3);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterD, 4>>(ExtendedOpcode::BIT_D_4);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterD, 5>>(ExtendedOpcode::BIT_D_5);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterD, 6>>(ExtendedOpcode::BIT_D_6);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterD, 7>>(ExtendedOpcode::BIT_D_7);
+
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterE, 0>>(ExtendedOpcode::BIT_E_0);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterE, 1>>(ExtendedOpcode::BIT_E_1);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterE, 2>>(ExtendedOpcode::BIT_E_2);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterE, 3>>(ExtendedOpcode::BIT_E_3);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterE, 4>>(ExtendedOpcode::BIT_E_4);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterE, 5>>(ExtendedOpcode::BIT_E_5);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterE, 6>>(ExtendedOpcode::BIT_E_6);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterE, 7>>(ExtendedOpcode::BIT_E_7);
+
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterH, 0>>(ExtendedOpcode::BIT_H_0);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterH, 1>>(ExtendedOpcode::BIT_H_1);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterH, 2>>(ExtendedOpcode::BIT_H_2);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterH, 3>>(ExtendedOpcode::BIT_H_3);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterH, 4>>(ExtendedOpcode::BIT_H_4);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterH, 5>>(ExtendedOpcode::BIT_H_5);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterH, 6>>(ExtendedOpcode::BIT_H_6);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterH, 7>>(ExtendedOpcode::BIT_H_7);
+
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterL, 0>>(ExtendedOpcode::BIT_L_0);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterL, 1>>(ExtendedOpcode::BIT_L_1);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterL, 2>>(ExtendedOpcode::BIT_L_2);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterL, 3>>(ExtendedOpcode::BIT_L_3);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterL, 4>>(ExtendedOpcode::BIT_L_4);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterL, 5>>(ExtendedOpcode::BIT_L_5);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterL, 6>>(ExtendedOpcode::BIT_L_6);
+		extended_instruction_builder.Begin<&CPU::BitTestOp_r8_b<RegisterL, 7>>(ExtendedOpcode::BIT_L_7);
+
+		extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_0).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 0>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_1).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 1>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_2).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 2>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_3).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 3>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_4).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 4>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_5).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 5>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_6).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 6>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::BIT_aHL_7).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>, &CPU::BitTestOp_r8_b<RegisterX, 7>>();
+
+		// 8-bit reset bit instructions
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<0>>>(ExtendedOpcode::RES_A_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<1>>>(ExtendedOpcode::RES_A_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<2>>>(ExtendedOpcode::RES_A_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<3>>>(ExtendedOpcode::RES_A_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<4>>>(ExtendedOpcode::RES_A_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<5>>>(ExtendedOpcode::RES_A_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<6>>>(ExtendedOpcode::RES_A_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::ResetBit8<7>>>(ExtendedOpcode::RES_A_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<0>>>(ExtendedOpcode::RES_B_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<1>>>(ExtendedOpcode::RES_B_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<2>>>(ExtendedOpcode::RES_B_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<3>>>(ExtendedOpcode::RES_B_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<4>>>(ExtendedOpcode::RES_B_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<5>>>(ExtendedOpcode::RES_B_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<6>>>(ExtendedOpcode::RES_B_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::ResetBit8<7>>>(ExtendedOpcode::RES_B_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<0>>>(ExtendedOpcode::RES_C_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<1>>>(ExtendedOpcode::RES_C_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<2>>>(ExtendedOpcode::RES_C_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<3>>>(ExtendedOpcode::RES_C_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<4>>>(ExtendedOpcode::RES_C_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<5>>>(ExtendedOpcode::RES_C_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<6>>>(ExtendedOpcode::RES_C_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::ResetBit8<7>>>(ExtendedOpcode::RES_C_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<0>>>(ExtendedOpcode::RES_D_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<1>>>(ExtendedOpcode::RES_D_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<2>>>(ExtendedOpcode::RES_D_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<3>>>(ExtendedOpcode::RES_D_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<4>>>(ExtendedOpcode::RES_D_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<5>>>(ExtendedOpcode::RES_D_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<6>>>(ExtendedOpcode::RES_D_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::ResetBit8<7>>>(ExtendedOpcode::RES_D_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<0>>>(ExtendedOpcode::RES_E_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<1>>>(ExtendedOpcode::RES_E_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<2>>>(ExtendedOpcode::RES_E_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<3>>>(ExtendedOpcode::RES_E_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<4>>>(ExtendedOpcode::RES_E_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<5>>>(ExtendedOpcode::RES_E_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<6>>>(ExtendedOpcode::RES_E_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::ResetBit8<7>>>(ExtendedOpcode::RES_E_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<0>>>(ExtendedOpcode::RES_H_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<1>>>(ExtendedOpcode::RES_H_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<2>>>(ExtendedOpcode::RES_H_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<3>>>(ExtendedOpcode::RES_H_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<4>>>(ExtendedOpcode::RES_H_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<5>>>(ExtendedOpcode::RES_H_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<6>>>(ExtendedOpcode::RES_H_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::ResetBit8<7>>>(ExtendedOpcode::RES_H_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<0>>>(ExtendedOpcode::RES_L_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<1>>>(ExtendedOpcode::RES_L_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<2>>>(ExtendedOpcode::RES_L_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<3>>>(ExtendedOpcode::RES_L_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<4>>>(ExtendedOpcode::RES_L_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<5>>>(ExtendedOpcode::RES_L_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<6>>>(ExtendedOpcode::RES_L_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::ResetBit8<7>>>(ExtendedOpcode::RES_L_7);
+
+		extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_0).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<0>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_1).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<1>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_2).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<2>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_3).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<3>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_4).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<4>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_5).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<5>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_6).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<6>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::RES_aHL_7).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::ResetBit8<7>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		// 8-bit set bit instructions
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<0>>>(ExtendedOpcode::SET_A_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<1>>>(ExtendedOpcode::SET_A_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<2>>>(ExtendedOpcode::SET_A_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<3>>>(ExtendedOpcode::SET_A_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<4>>>(ExtendedOpcode::SET_A_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<5>>>(ExtendedOpcode::SET_A_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<6>>>(ExtendedOpcode::SET_A_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterA, &CPU::SetBit8<7>>>(ExtendedOpcode::SET_A_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<0>>>(ExtendedOpcode::SET_B_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<1>>>(ExtendedOpcode::SET_B_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<2>>>(ExtendedOpcode::SET_B_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<3>>>(ExtendedOpcode::SET_B_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<4>>>(ExtendedOpcode::SET_B_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<5>>>(ExtendedOpcode::SET_B_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<6>>>(ExtendedOpcode::SET_B_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterB, &CPU::SetBit8<7>>>(ExtendedOpcode::SET_B_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<0>>>(ExtendedOpcode::SET_C_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<1>>>(ExtendedOpcode::SET_C_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<2>>>(ExtendedOpcode::SET_C_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<3>>>(ExtendedOpcode::SET_C_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<4>>>(ExtendedOpcode::SET_C_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<5>>>(ExtendedOpcode::SET_C_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<6>>>(ExtendedOpcode::SET_C_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterC, &CPU::SetBit8<7>>>(ExtendedOpcode::SET_C_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<0>>>(ExtendedOpcode::SET_D_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<1>>>(ExtendedOpcode::SET_D_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<2>>>(ExtendedOpcode::SET_D_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<3>>>(ExtendedOpcode::SET_D_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<4>>>(ExtendedOpcode::SET_D_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<5>>>(ExtendedOpcode::SET_D_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<6>>>(ExtendedOpcode::SET_D_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterD, &CPU::SetBit8<7>>>(ExtendedOpcode::SET_D_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<0>>>(ExtendedOpcode::SET_E_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<1>>>(ExtendedOpcode::SET_E_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<2>>>(ExtendedOpcode::SET_E_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<3>>>(ExtendedOpcode::SET_E_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<4>>>(ExtendedOpcode::SET_E_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<5>>>(ExtendedOpcode::SET_E_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<6>>>(ExtendedOpcode::SET_E_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterE, &CPU::SetBit8<7>>>(ExtendedOpcode::SET_E_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<0>>>(ExtendedOpcode::SET_H_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<1>>>(ExtendedOpcode::SET_H_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<2>>>(ExtendedOpcode::SET_H_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<3>>>(ExtendedOpcode::SET_H_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<4>>>(ExtendedOpcode::SET_H_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<5>>>(ExtendedOpcode::SET_H_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<6>>>(ExtendedOpcode::SET_H_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterH, &CPU::SetBit8<7>>>(ExtendedOpcode::SET_H_7);
+
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<0>>>(ExtendedOpcode::SET_L_0);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<1>>>(ExtendedOpcode::SET_L_1);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<2>>>(ExtendedOpcode::SET_L_2);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<3>>>(ExtendedOpcode::SET_L_3);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<4>>>(ExtendedOpcode::SET_L_4);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<5>>>(ExtendedOpcode::SET_L_5);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<6>>>(ExtendedOpcode::SET_L_6);
+		extended_instruction_builder.Begin<&CPU::UnaryOp_r8<RegisterL, &CPU::SetBit8<7>>>(ExtendedOpcode::SET_L_7);
+
+		extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_0).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<0>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_1).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<1>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_2).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<2>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_3).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<3>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_4).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<4>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_5).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<5>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_6).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<6>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+		extended_instruction_builder.Begin(ExtendedOpcode::SET_aHL_7).Cycle<&CPU::LoadOp_r8_ar<RegisterX, RegisterHL>>().Cycle<&CPU::UnaryOp_r8<RegisterX, &CPU::SetBit8<7>>, &CPU::LoadOp_ar_r8<RegisterHL, RegisterX>>();
+
+		return extended_instruction_builder;
+	}();
+
+	static constexpr auto extended_instruction_table = extended_instruction_builder.Build<extended_instruction_builder.GetOpCount()>();
+	static constexpr auto extended_instructions = extended_instruction_table.GetInstructionSet();
+	return extended_instructions;
+}
+
 Memory16& CPU::GetMemory() const noexcept
 {
 	return m_Memory;
@@ -777,7 +951,7 @@ void CPU::SetInterruptEnable(uint8_t a_Interrupts) noexcept
 	if (m_InterruptEnable != a_Interrupts)
 	{
 		m_InterruptEnable = a_Interrupts;
-		InsertOpAfterInstruction(&CPU::ProcessInterrupts);
+		QueueOp(&CPU::ProcessInterrupts);
 	}
 }
 
@@ -786,7 +960,7 @@ void CPU::SetInterruptRequests(uint8_t a_Interrupts) noexcept
 	if (m_InterruptRequests != a_Interrupts)
 	{
 		m_InterruptRequests = a_Interrupts;
-		InsertOpAfterInstruction(&CPU::ProcessInterrupts);
+		QueueOp(&CPU::ProcessInterrupts);
 	}
 
 	if (a_Interrupts != 0)
@@ -802,12 +976,12 @@ void CPU::RequestInterrupts(uint8_t a_Interrupts) noexcept
 
 uint8_t CPU::GetDIV() const noexcept
 {
-	return static_cast<uint8_t>(m_DIV >> 8);
+	return static_cast<uint8_t>(GetTimerState().m_DIV >> 8);
 }
 
 uint8_t CPU::GetTIMA() const noexcept
 {
-	return m_TIMA;
+	return GetTimerState().m_TIMA;
 }
 
 uint8_t CPU::GetTMA() const noexcept
@@ -822,29 +996,36 @@ uint8_t CPU::GetTAC() const noexcept
 
 void CPU::SetDIV(uint8_t a_Value) noexcept
 {
-	m_DIV = 0;
+	UpdateTimer();
+	m_Timer.m_DIV = 0;
+	ScheduleTimer();
 }
 
 void CPU::SetTIMA(uint8_t a_Value) noexcept
 {
-	m_TIMA = a_Value;
+	UpdateTimer();
+	m_Timer.m_TIMA = a_Value;
+	ScheduleTimer();
 }
 
 void CPU::SetTMA(uint8_t a_Value) noexcept
 {
+	// TMA is only read on the cycle that reloads TIMA, which is always ticked
 	m_TMA = a_Value;
 }
 
 void CPU::SetTAC(uint8_t a_Value) noexcept
 {
+	UpdateTimer();
 	m_TAC = a_Value & 0b111;
+	ScheduleTimer();
 }
 
 void CPU::StartDMA(uint8_t a_Address)
 {
 	m_DMAAddress = a_Address;
 	m_DMACounter = 0;
-	PushOp(&CPU::ProcessDMA);
+	m_DMAActive = true;
 }
 
 bool CPU::Tick()
@@ -853,37 +1034,23 @@ bool CPU::Tick()
 	m_OpBreak = false;
 	while (!m_OpBreak)
 	{
-		const MicroOp op = PopOp();
+		const MicroOp op = NextOp();
 		CallOp(op);
 	}
 
-	// Update timers
-	m_DIV += 4;
-
-	bool tima_bit_state = false;
-	if (m_TAC & 0b100)
+	// Copy one byte per cycle while a DMA is running
+	if (m_DMAActive)
 	{
-		constexpr uint16_t div_mask[4] = { 0b1'0000'0000, 0b1000, 0b10'0000, 0b1000'0000 };
-		tima_bit_state = (m_DIV & div_mask[m_TAC & 0b11]) != 0;
+		ProcessDMA();
 	}
 
-	if (m_TIMAOverflow)
+	// Update timers, they only need this cycle if it's one they can't compute later on
+	if (++m_Cycle == m_TimerEventCycle)
 	{
-		m_TIMAOverflow = false;
-		m_TIMA = m_TMA;
-		RequestInterrupts(InterruptTimer);
+		UpdateTimer();
+		ScheduleTimer();
 	}
 
-	if (m_LastTIMABitState && !tima_bit_state)
-	{
-		++m_TIMA;
-		if (m_TIMA == 0)
-		{
-			m_TIMAOverflow = true;
-		}
-	}
-	m_LastTIMABitState = tima_bit_state;
-
 	// Return whether or not this cycle was the last cycle of an instruction
 	return IsInstructionDone();
 }
@@ -892,7 +1059,7 @@ void CPU::Reset()
 {
 	// Reset ops
 	ClearOps();
-	PushOp(&CPU::DecodeInstruction);
+	m_Block = nullptr;
 
 	// Reset program counter
 	StoreRegister16(RegisterPC, 0);
@@ -904,16 +1071,246 @@ void CPU::Reset()
 	m_Halted = false;
 
 	// Reset timers
-	m_DIV = 0;
-	m_TIMA = 0;
+	m_Timer = {};
 	m_TMA = 0;
 	m_TAC = 0;
-	m_LastTIMABitState = false;
-	m_TIMAOverflow = false;
+	m_TimerCycle = m_Cycle;
+	ScheduleTimer();
 
 	// Reset DMA
 	m_DMAAddress = 0;
 	m_DMACounter = 0;
+	m_DMAActive = false;
+}
+
+size_t CPU::GetIdleCycles(size_t a_MaxCycles)
+{
+	// A DMA copies a byte every cycle
+	if (m_DMAActive)
+	{
+		return 0;
+	}
+
+	// Halted, only an interrupt request wakes the CPU up
+	if (m_Halted)
+	{
+		return std::min(a_MaxCycles, GetTimerIdleCycles());
+	}
+
+	if (!IsDecodeNext() || (m_InterruptMasterEnable && (m_InterruptEnable & m_InterruptRequests & 0x1F) != 0))
+	{
+		return 0;
+	}
+
+	// Only skip whole iterations, so the loop is back at its head afterwards
+	const size_t loop_cycles = GetIdleLoopCycles();
+	if (loop_cycles == 0)
+	{
+		return 0;
+	}
+
+	const size_t cycles = std::min(a_MaxCycles, GetTimerIdleCycles());
+	return cycles - cycles % loop_cycles;
+}
+
+void CPU::Skip(size_t a_Cycles) noexcept
+{
+	// The timer catches up by itself, GetIdleCycles made sure this stays clear of its next event
+	m_Cycle += a_Cycles;
+
+	#ifdef _DEBUG
+	assert(m_Cycle < m_TimerEventCycle);
+	#endif
+}
+
+bool CPU::IsBlockCacheEnabled() const noexcept
+{
+	return m_BlockCache != nullptr;
+}
+
+void CPU::SetBlockCacheEnabled(bool a_Enabled)
+{
+	if (a_Enabled == IsBlockCacheEnabled())
+	{
+		return;
+	}
+
+	// The new decode op takes over at the next instruction boundary
+	if (a_Enabled)
+	{
+		m_BlockCache = std::make_unique<BlockCache>();
+		m_DecodeOp = &CPU::DecodeCachedInstruction;
+	}
+	else
+	{
+		m_BlockCache = nullptr;
+		m_JIT = nullptr;
+		m_DecodeOp = &CPU::DecodeInstruction;
+	}
+
+	m_Block = nullptr;
+}
+
+void CPU::InvalidateBlocks()
+{
+	if (m_BlockCache != nullptr)
+	{
+		m_BlockCache->Clear();
+	}
+
+	if (m_JIT != nullptr)
+	{
+		m_JIT->Clear();
+	}
+}
+
+void CPU::InvalidateBlocks(uint16_t a_Address)
+{
+	if (m_BlockCache == nullptr)
+	{
+		return;
+	}
+
+	if (a_Address < 0x8000 || a_Address == 0xFF50)
+	{
+		// Bank switch or boot ROM unmap; blocks stay valid under their physical address, but the current one may not
+		m_BlockCache->NewGeneration();
+	}
+	else if (a_Address >= 0xC000 && a_Address < 0xFE00)
+	{
+		// Echo RAM aliases WRAM
+		m_BlockCache->Invalidate(a_Address >= 0xE000 ? a_Address - 0x2000 : a_Address);
+	}
+	else if (a_Address >= 0xFF80 && a_Address < 0xFFFF)
+	{
+		m_BlockCache->Invalidate(a_Address);
+	}
+}
+
+bool CPU::IsJITEnabled() const noexcept
+{
+	return m_JIT != nullptr;
+}
+
+void CPU::SetJITEnabled(bool a_Enabled)
+{
+	// Traces are built from cached blocks, so the JIT always runs on top of the block cache
+	if (a_Enabled && JIT::IsSupported())
+	{
+		SetBlockCacheEnabled(true);
+		if (m_JIT == nullptr)
+		{
+			m_JIT = std::make_unique<JIT>();
+		}
+	}
+	else
+	{
+		m_JIT = nullptr;
+	}
+}
+
+size_t CPU::GetRecorderMemberCount() const noexcept
+{
+	return std::size(RecorderMembers);
+}
+
+const RecorderMemberDescription& CPU::GetRecorderMember(size_t a_Index) const noexcept
+{
+	return RecorderMembers[a_Index];
+}
+
+const std::array<CPU::MicroOp, 4>& CPU::GetDeferrableOps() noexcept
+{
+	static const std::array<MicroOp, 4> ops =
+	{
+		nullptr,
+		&CPU::DelayOp<&CPU::DisableInterrupts, 0>,
+		&CPU::DelayOp<&CPU::EnableInterrupts, 0>,
+		&CPU::DelayOp<&CPU::Halt, 0>,
+	};
+
+	return ops;
+}
+
+void CPU::SaveRecorderState(ByteWriter& a_Writer) const noexcept
+{
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		a_Writer.Write(LoadRegister16(i));
+	}
+
+	a_Writer.Write(m_InterruptMasterEnable);
+	a_Writer.Write(m_InterruptEnable);
+	a_Writer.Write(m_InterruptRequests);
+	a_Writer.Write(m_Halted);
+
+	// EI, DI and HALT only take effect during the next instruction
+	const auto& deferrable_ops = GetDeferrableOps();
+	const auto deferred_op = std::find(deferrable_ops.begin(), deferrable_ops.end(), GetDeferredOp());
+	a_Writer.Write(static_cast<uint8_t>(deferred_op != deferrable_ops.end() ? deferred_op - deferrable_ops.begin() : 0));
+
+	const TimerState timer = GetTimerState();
+	a_Writer.Write(timer.m_DIV);
+	a_Writer.Write(timer.m_TIMA);
+	a_Writer.Write(m_TMA);
+	a_Writer.Write(m_TAC);
+	a_Writer.Write(timer.m_LastTIMABitState);
+	a_Writer.Write(timer.m_TIMAOverflow);
+
+	a_Writer.Write(m_DMAAddress);
+	a_Writer.Write(m_DMACounter);
+	a_Writer.Write(m_DMAActive);
+}
+
+void CPU::LoadRecorderState(ByteReader& a_Reader) noexcept
+{
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		uint16_t value = 0;
+		a_Reader.Read(value);
+		StoreRegister16(i, value);
+	}
+
+	a_Reader.Read(m_InterruptMasterEnable);
+	a_Reader.Read(m_InterruptEnable);
+	a_Reader.Read(m_InterruptRequests);
+	a_Reader.Read(m_Halted);
+
+	uint8_t deferred_op = 0;
+	a_Reader.Read(deferred_op);
+
+	a_Reader.Read(m_Timer.m_DIV);
+	a_Reader.Read(m_Timer.m_TIMA);
+	a_Reader.Read(m_TMA);
+	a_Reader.Read(m_TAC);
+	a_Reader.Read(m_Timer.m_LastTIMABitState);
+	a_Reader.Read(m_Timer.m_TIMAOverflow);
+	m_TimerCycle = m_Cycle;
+	ScheduleTimer();
+
+	a_Reader.Read(m_DMAAddress);
+	a_Reader.Read(m_DMACounter);
+	a_Reader.Read(m_DMAActive);
+
+	// Rebuild the ops as they look between two instructions
+	ClearOps();
+	const auto& deferrable_ops = GetDeferrableOps();
+	if (deferred_op != 0 && deferred_op < deferrable_ops.size())
+	{
+		DeferOp(deferrable_ops[deferred_op]);
+	}
+
+	if (m_Halted)
+	{
+		QueueOp(&CPU::CheckHalt);
+	}
+
+	// An interrupt can still be due from the last instruction, e.g. a RETI with another one requested
+	if (m_InterruptMasterEnable && (m_InterruptEnable & m_InterruptRequests & 0x1F) != 0)
+	{
+		QueueOp(&CPU::ProcessInterrupts);
+	}
+	m_Block = nullptr;
 }
 
 template <bool Carry>
@@ -1220,7 +1617,7 @@ uint8_t CPU::DecimalAdjust8(uint8_t a_Value) noexcept
 void CPU::NotImplemented()
 {
 	const uint16_t pc = LoadRegister16(RegisterPC);
-	if (m_Memory.Load8(pc - 2) == Opcode::EXT)
+	if (LoadMemory<uint8_t>(pc - 2) == Opcode::EXT)
 	{
 		StoreRegister16(RegisterPC, pc - 2_u16);
 	}
@@ -1234,22 +1631,61 @@ void CPU::DecodeInstruction()
 {
 	// Decode instruction
 	const auto opcode = static_cast<Opcode::Enum>(ReadNext8());
-	const size_t instruction_size = m_Instructions->GetInstructionSize(opcode);
-	const MicroOp* const ops = m_Instructions->GetInstructionOps(opcode);
+	const size_t instruction_size = GetInstructions().GetInstructionSize(opcode);
+	const MicroOp* const ops = GetInstructions().GetInstructionOps(opcode);
 
 	PushInstruction(ops, instruction_size);
-	PushOp(&CPU::DecodeInstruction);
 }
 
 void CPU::DecodeExtendedInstruction()
 {
 	const auto opcode = static_cast<ExtendedOpcode::Enum>(ReadNext8());
-	const size_t instruction_size = m_ExtendedInstructions->GetInstructionSize(opcode);
-	const MicroOp* const ops = m_ExtendedInstructions->GetInstructionOps(opcode);
+	const size_t instruction_size = GetExtendedInstructions().GetInstructionSize(opcode);
+	const MicroOp* const ops = GetExtendedInstructions().GetInstructionOps(opcode);
 
 	ExtendInstruction(ops, instruction_size);
 }
 
+void CPU::DecodeCachedInstruction()
+{
+	if (m_BlockCache == nullptr)
+	{
+		DecodeInstruction();
+		return;
+	}
+
+	// Keep walking the current block as long as execution falls through to its next instruction
+	const uint16_t pc = LoadRegister16(RegisterPC);
+	if (m_Block == nullptr || m_BlockGeneration != m_BlockCache->GetGeneration() || m_BlockAddress != pc || m_BlockIndex == m_Block->m_Instructions.size())
+	{
+		m_Block = FindBlock(pc);
+		m_BlockIndex = 0;
+		m_BlockGeneration = m_BlockCache->GetGeneration();
+
+		if (m_Block == nullptr)
+		{
+			DecodeInstruction();
+			return;
+		}
+
+		if (m_JIT != nullptr && RunTrace(*m_Block))
+		{
+			return;
+		}
+	}
+
+	// Skip the opcode bytes; operands are still read by the ops themselves
+	const auto& instruction = m_Block->m_Instructions[m_BlockIndex++];
+	m_BlockAddress = pc + instruction.m_Length;
+	StoreRegister16(RegisterPC, pc + instruction.m_Size);
+
+	PushInstruction(instruction.m_Ops, instruction.m_OpCount);
+	if (instruction.m_ExtendedOps != nullptr)
+	{
+		ExtendInstruction(instruction.m_ExtendedOps, instruction.m_ExtendedOpCount);
+	}
+}
+
 void CPU::Break()
 {
 	m_OpBreak = true;
@@ -1273,25 +1709,31 @@ void CPU::DisableInterrupts()
 void CPU::EnableInterrupts()
 {
 	m_InterruptMasterEnable = true;
-	ProcessInterrupts();
+	QueueOp(&CPU::ProcessInterrupts);
 }
 
 void CPU::ProcessInterrupts()
 {
+	// Wait 2 cycles, push PC on the stack and jump to the interrupt handler in XY
+	static const MicroOp dispatch_ops[] =
+	{
+		&CPU::Break,
+		&CPU::Break,
+		&CPU::ConcatOp<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>, &CPU::Break>,
+		&CPU::ConcatOp<&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>, &CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>, &CPU::Break>,
+		&CPU::ConcatOp<&CPU::JumpOp_r<RegisterXY>, &CPU::Break>,
+	};
+
 	if (!m_InterruptMasterEnable)
 	{
 		return;
 	}
 
+	// Only the highest priority interrupt is dispatched, the others stay requested until interrupts are enabled again
 	for (uint8_t i = 0; i < 5; ++i)
 	{
 		const uint8_t interrupt_mask = 1 << i;
-		if ((m_InterruptEnable & interrupt_mask) == 0)
-		{
-			continue;
-		}
-
-		if ((m_InterruptRequests & interrupt_mask) == 0)
+		if ((m_InterruptEnable & m_InterruptRequests & interrupt_mask) == 0)
 		{
 			continue;
 		}
@@ -1300,26 +1742,10 @@ void CPU::ProcessInterrupts()
 		m_InterruptMasterEnable = false;
 		m_InterruptRequests ^= interrupt_mask;
 
-		// Set done to front
-		ResetInstruction();
-
-		// Wait 2 cycles
-		ExtendInstruction(&CPU::Break);
-		ExtendInstruction(&CPU::Break);
-
-		// Push PC on the stack
-		ExtendInstruction(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>);
-		ExtendInstruction(&CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_P>);
-		ExtendInstruction(&CPU::Break);
-
-		ExtendInstruction(&CPU::UnaryOp_r16<RegisterSP, &CPU::Decrement16>);
-		ExtendInstruction(&CPU::LoadOp_ar_r8<RegisterSP, RegisterPC_C>);
-		ExtendInstruction(&CPU::Break);
-
-		// Jump to interrupt handler
+		// Queued ops only run between instructions, so the dispatch becomes the current instruction
 		StoreRegister16(RegisterXY, 0x40 + i * 8);
-		ExtendInstruction(&CPU::JumpOp_r<RegisterXY>);
-		ExtendInstruction(&CPU::Break);
+		InsertInstruction(dispatch_ops, std::size(dispatch_ops));
+		return;
 	}
 }
 
@@ -1331,10 +1757,9 @@ void CPU::Halt()
 
 void CPU::CheckHalt()
 {
-	ResetInstruction();
 	if (m_Halted)
 	{
-		InsertOpBeforeInstruction(&CPU::CheckHalt);
+		QueueOpFirst(&CPU::CheckHalt);
 		Break();
 	}
 }
@@ -1350,13 +1775,471 @@ void CPU::ProcessDMA()
 	const uint16_t source_address = (static_cast<uint16_t>(m_DMAAddress) << 8) | m_DMACounter;
 	const uint16_t destination_address = 0xFE00 | m_DMACounter;
 
-	m_Memory.Store8(destination_address, m_Memory.Load8(source_address));
+	StoreMemory<uint8_t>(destination_address, LoadMemory<uint8_t>(source_address));
 
 	++m_DMACounter;
-	if (m_DMACounter != 0xA0)
+	if (m_DMACounter == 0xA0)
+	{
+		m_DMAActive = false;
+	}
+}
+
+CPU::TimerState CPU::GetTimerState() const noexcept
+{
+	TimerState timer = m_Timer;
+	AdvanceTimer(timer, m_Cycle - m_TimerCycle);
+	return timer;
+}
+
+bool CPU::IsTimerRegular(const TimerState& a_Timer) const noexcept
+{
+	// Right after an overflow, or a write to DIV or TAC that flipped the DIV bit TIMA counts, the next cycle doesn't
+	// follow the regular schedule
+	return !a_Timer.m_TIMAOverflow && a_Timer.m_LastTIMABitState == GetTIMABitState(a_Timer.m_DIV, m_TAC);
+}
+
+uint64_t CPU::GetTimerOverflowCycles(const TimerState& a_Timer) const noexcept
+{
+	// Cycles up to and including the one with the falling edge that overflows TIMA, only valid for a running timer on
+	// its regular schedule
+	const uint64_t period = (TIMAClockMasks[m_TAC & 0b11] * 2u) / 4;
+	const uint64_t next_edge = period - ((a_Timer.m_DIV / 4) & (period - 1));
+	return next_edge + (0xFF - a_Timer.m_TIMA) * period;
+}
+
+bool CPU::StepTimer(TimerState& a_Timer) const noexcept
+{
+	a_Timer.m_DIV += 4;
+	const bool tima_bit_state = GetTIMABitState(a_Timer.m_DIV, m_TAC);
+
+	bool reloaded = false;
+	if (a_Timer.m_TIMAOverflow)
+	{
+		a_Timer.m_TIMAOverflow = false;
+		a_Timer.m_TIMA = m_TMA;
+		reloaded = true;
+	}
+
+	if (a_Timer.m_LastTIMABitState && !tima_bit_state)
+	{
+		++a_Timer.m_TIMA;
+		if (a_Timer.m_TIMA == 0)
+		{
+			a_Timer.m_TIMAOverflow = true;
+		}
+	}
+	a_Timer.m_LastTIMABitState = tima_bit_state;
+
+	return reloaded;
+}
+
+bool CPU::AdvanceTimer(TimerState& a_Timer, uint64_t a_Cycles) const noexcept
+{
+	// Same as stepping a_Cycles times, returns whether TIMA was reloaded on the way
+	bool reloaded = false;
+	while (a_Cycles != 0)
+	{
+		if (!IsTimerRegular(a_Timer))
+		{
+			reloaded |= StepTimer(a_Timer);
+			--a_Cycles;
+			continue;
+		}
+
+		if (!(m_TAC & 0b100))
+		{
+			a_Timer.m_DIV += static_cast<uint16_t>(a_Cycles * 4);
+			break;
+		}
+
+		// TIMA counts the falling edges of the DIV bit, which happen whenever DIV passes a multiple of twice the bit.
+		// Count them in one go up to the edge that overflows TIMA, and step through that one.
+		const uint16_t mask = TIMAClockMasks[m_TAC & 0b11];
+		const uint64_t period = mask * 2u;
+		const uint64_t cycles = std::min(a_Cycles, GetTimerOverflowCycles(a_Timer) - 1);
+		a_Timer.m_TIMA += static_cast<uint8_t>(((a_Timer.m_DIV & (period - 1)) + cycles * 4) / period);
+		a_Timer.m_DIV += static_cast<uint16_t>(cycles * 4);
+		a_Timer.m_LastTIMABitState = (a_Timer.m_DIV & mask) != 0;
+		a_Cycles -= cycles;
+
+		if (a_Cycles != 0)
+		{
+			StepTimer(a_Timer);
+			--a_Cycles;
+		}
+	}
+
+	return reloaded;
+}
+
+void CPU::UpdateTimer() noexcept
+{
+	const bool reloaded = AdvanceTimer(m_Timer, m_Cycle - m_TimerCycle);
+	m_TimerCycle = m_Cycle;
+
+	if (reloaded)
+	{
+		RequestInterrupts(InterruptTimer);
+	}
+}
+
+void CPU::ScheduleTimer() noexcept
+{
+	if (!IsTimerRegular(m_Timer))
+	{
+		m_TimerEventCycle = m_TimerCycle + 1;
+	}
+	else if (!(m_TAC & 0b100))
+	{
+		m_TimerEventCycle = std::numeric_limits<uint64_t>::max();
+	}
+	else
+	{
+		// The cycle after the overflow reloads TIMA
+		m_TimerEventCycle = m_TimerCycle + GetTimerOverflowCycles(m_Timer) + 1;
+	}
+}
+
+size_t CPU::GetTimerIdleCycles() const noexcept
+{
+	// Stop short of a TIMA overflow as well, it's ticked along with the reload after it
+	const uint64_t cycles = m_TimerEventCycle - m_Cycle;
+	if (cycles < 2)
+	{
+		return 0;
+	}
+
+	return static_cast<size_t>(std::min<uint64_t>(cycles - 2, std::numeric_limits<size_t>::max()));
+}
+
+size_t CPU::GetIdleLoopCycles()
+{
+	// Recognizes a loop that loads a value into A, optionally tests it, and jumps back as long as that leaves A and the
+	// flags as they were before:
+	//
+	//   LD A,(FF00+n) | LD A,(nn)
+	//   CP A,n | AND A,n | AND A,A | OR A,A (optional)
+	//   JR cc,head | JP cc,head
+	//
+	// as well as a jump to itself. Returns the cycles per iteration, or 0 if this isn't such a loop.
+	const uint16_t head = LoadRegister16(RegisterPC);
+	if (head >= 0x8000 && !IsPollableAddress(head))
+	{
+		return 0;
+	}
+
+	uint16_t address = head;
+	uint16_t polled = 0;
+	size_t cycles = 0;
+	switch (LoadMemory<uint8_t>(address))
+	{
+		case Opcode::JR_n:
+		return LoadMemory<uint8_t>(address + 1) == 0xFE ? 3 : 0;
+
+		case Opcode::JP_nn:
+		return LoadMemory<uint16_t>(address + 1) == head ? 4 : 0;
+
+		case Opcode::LD_A_aFFn:
+		polled = 0xFF00 | LoadMemory<uint8_t>(address + 1);
+		address += 2;
+		cycles = 3;
+		break;
+
+		case Opcode::LD_A_ann:
+		polled = LoadMemory<uint16_t>(address + 1);
+		address += 3;
+		cycles = 4;
+		break;
+
+		default:
+		return 0;
+	}
+
+	if (!IsPollableAddress(polled))
+	{
+		return 0;
+	}
+
+	// Run an iteration on the registers with the ALU ops themselves, then put them back
+	const uint16_t af = LoadRegister16(RegisterAF);
+	uint8_t value = LoadMemory<uint8_t>(polled);
+	switch (LoadMemory<uint8_t>(address))
+	{
+		case Opcode::CP_A_n:
+		Subtract8<false>(value, LoadMemory<uint8_t>(address + 1));
+		address += 2;
+		cycles += 2;
+		break;
+
+		case Opcode::AND_A_n:
+		value = AND8(value, LoadMemory<uint8_t>(address + 1));
+		address += 2;
+		cycles += 2;
+		break;
+
+		case Opcode::AND_A_A:
+		value = AND8(value, value);
+		address += 1;
+		cycles += 1;
+		break;
+
+		case Opcode::OR_A_A:
+		value = OR8(value, value);
+		address += 1;
+		cycles += 1;
+		break;
+	}
+	StoreRegister8(RegisterA, value);
+
+	// The conditional jumps encode the flag in bit 4 (zero or carry) and the expected state in bit 3
+	const uint8_t jump = LoadMemory<uint8_t>(address);
+	const bool taken = LoadFlag((jump & 0x10) ? FlagCarry : FlagZero) == ((jump & 0x08) != 0);
+	bool loops = false;
+	switch (jump)
+	{
+		case Opcode::JR_NZ_n:
+		case Opcode::JR_Z_n:
+		case Opcode::JR_NC_n:
+		case Opcode::JR_C_n:
+		loops = static_cast<uint16_t>(address + 2 + static_cast<int8_t>(LoadMemory<uint8_t>(address + 1))) == head;
+		cycles += 3;
+		break;
+
+		case Opcode::JP_NZ_nn:
+		case Opcode::JP_Z_nn:
+		case Opcode::JP_NC_nn:
+		case Opcode::JP_C_nn:
+		loops = LoadMemory<uint16_t>(address + 1) == head;
+		cycles += 4;
+		break;
+	}
+
+	const bool idle = loops && taken && LoadRegister16(RegisterAF) == af;
+	StoreRegister16(RegisterAF, af);
+
+	return idle ? cycles : 0;
+}
+
+const CPU::BlockCache::Block* CPU::FindBlock(uint16_t a_Address)
+{
+	// Only ROM, WRAM and HRAM are cached, blocks never cross into a differently mapped region
+	uint32_t limit = 0;
+	bool watch = false;
+	if (a_Address < 0x0100)
+	{
+		limit = 0x0100;
+	}
+	else if (a_Address < 0x4000)
+	{
+		limit = 0x4000;
+	}
+	else if (a_Address < 0x8000)
+	{
+		limit = 0x8000;
+	}
+	else if (a_Address >= 0xC000 && a_Address < 0xE000)
+	{
+		limit = 0xE000;
+		watch = true;
+	}
+	else if (a_Address >= 0xFF80 && a_Address < 0xFFFF)
+	{
+		limit = 0xFFFF;
+		watch = true;
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	const uint64_t key = m_Memory.GetPhysicalAddress(a_Address);
+	if (const auto block = m_BlockCache->Find(key); block != nullptr)
+	{
+		return block;
+	}
+
+	return CompileBlock(key, a_Address, limit, watch);
+}
+
+const CPU::BlockCache::Block* CPU::CompileBlock(uint64_t a_Key, uint16_t a_Address, uint32_t a_Limit, bool a_Watch)
+{
+	BlockCache::Block block;
+	block.m_Address = a_Address;
+
+	uint32_t address = a_Address;
+	while (block.m_Instructions.size() < MaxBlockInstructions)
+	{
+		const auto opcode = static_cast<Opcode::Enum>(LoadMemory<uint8_t>(static_cast<uint16_t>(address)));
+		const uint32_t length = Opcode::GetSize(opcode).value_or(1) + (opcode == Opcode::EXT ? 1 : 0);
+		if (address + length > a_Limit)
+		{
+			break;
+		}
+
+		BlockCache::Instruction instruction;
+		instruction.m_Ops = GetInstructions().GetInstructionOps(opcode);
+		instruction.m_OpCount = static_cast<uint8_t>(GetInstructions().GetInstructionSize(opcode));
+		instruction.m_ExtendedOps = nullptr;
+		instruction.m_ExtendedOpCount = 0;
+		instruction.m_Length = static_cast<uint8_t>(length);
+		instruction.m_Size = 1;
+
+		if (opcode == Opcode::EXT)
+		{
+			// The prefix cycle decodes the extended instruction, which already happened here, so only its break is left
+			static const MicroOp prefix_ops[] = { &CPU::Break };
+			const auto extended_opcode = static_cast<ExtendedOpcode::Enum>(LoadMemory<uint8_t>(static_cast<uint16_t>(address + 1)));
+			#ifdef _DEBUG
+			assert(instruction.m_OpCount == std::size(prefix_ops));
+			#endif
+
+			instruction.m_Ops = prefix_ops;
+			instruction.m_ExtendedOps = GetExtendedInstructions().GetInstructionOps(extended_opcode);
+			instruction.m_ExtendedOpCount = static_cast<uint8_t>(GetExtendedInstructions().GetInstructionSize(extended_opcode));
+			instruction.m_Size = 2;
+		}
+
+		block.m_Instructions.push_back(instruction);
+
+		address += length;
+		if (EndsBlock(opcode))
+		{
+			break;
+		}
+	}
+
+	if (block.m_Instructions.empty())
+	{
+		return nullptr;
+	}
+
+	block.m_Length = static_cast<uint16_t>(address - a_Address);
+	return m_BlockCache->Insert(a_Key, std::move(block), a_Watch);
+}
+
+bool CPU::RunTrace(const BlockCache::Block& a_Block)
+{
+	// Self-modifying code and anything that could observe the trace running early stays on the interpreter
+	if (a_Block.m_Address >= 0x8000 || m_DMAActive)
+	{
+		return false;
+	}
+
+	if (m_InterruptMasterEnable && (m_InterruptEnable & m_InterruptRequests & 0x1F) != 0)
+	{
+		return false;
+	}
+
+	auto& trace = m_JIT->GetTrace(a_Block.m_Key);
+	if (!trace.m_Compiled)
+	{
+		if (++trace.m_Hits < TraceThreshold)
+		{
+			return false;
+		}
+
+		CompileTrace(a_Block, trace);
+	}
+
+	if (trace.m_Function == nullptr)
+	{
+		return false;
+	}
+
+	// Run the whole trace now and idle for the remaining cycles, the device catches up at the end of the trace. The
+	// trace's ops end in breaks, clearing the last one makes the current tick its first cycle like the interpreter.
+	trace.m_Function(this);
+	m_OpBreak = false;
+
+	m_BlockIndex = trace.m_InstructionCount;
+	m_BlockAddress = trace.m_EndAddress;
+
+	static const auto breaks = []
+	{
+		std::array<MicroOp, MaxTraceCycles> ops;
+		ops.fill(&CPU::Break);
+		return ops;
+	}();
+	PushInstruction(breaks.data(), trace.m_Cycles);
+
+	return true;
+}
+
+void CPU::CompileTrace(const BlockCache::Block& a_Block, JIT::Trace& a_Trace)
+{
+	a_Trace.m_Compiled = true;
+
+	const auto program_counter = reinterpret_cast<const uint8_t*>(&m_Registers[RegisterPC]) - reinterpret_cast<const uint8_t*>(this);
+
+	m_JIT->Begin();
+
+	uint16_t address = a_Block.m_Address;
+	size_t instruction_count = 0;
+	size_t cycles = 0;
+	for (const auto& instruction : a_Block.m_Instructions)
 	{
-		PushOp(&CPU::ProcessDMA);
+		const auto opcode = static_cast<Opcode::Enum>(LoadMemory<uint8_t>(address));
+		const auto extended_opcode = static_cast<ExtendedOpcode::Enum>(LoadMemory<uint8_t>(address + 1));
+		if (!IsTraceInstruction(opcode, extended_opcode))
+		{
+			break;
+		}
+
+		const std::pair<const MicroOp*, size_t> spans[] =
+		{
+			{ instruction.m_Ops, instruction.m_OpCount },
+			{ instruction.m_ExtendedOps, instruction.m_ExtendedOpCount },
+		};
+
+		// Every op is a whole cycle ending in a break
+		constexpr MicroOp not_implemented = &CPU::ConcatOp<&CPU::NotImplemented, &CPU::Break>;
+		size_t instruction_cycles = 0;
+		bool implemented = true;
+		for (const auto& [ops, op_count] : spans)
+		{
+			instruction_cycles += op_count;
+			implemented &= std::count(ops, ops + op_count, not_implemented) == 0;
+		}
+
+		if (cycles + instruction_cycles > MaxTraceCycles || !implemented)
+		{
+			break;
+		}
+
+		// Operands are read through the program counter
+		if (instruction.m_Length != instruction.m_Size)
+		{
+			m_JIT->EmitStore16(program_counter, address + instruction.m_Size);
+		}
+
+		for (const auto& [ops, op_count] : spans)
+		{
+			for (size_t i = 0; i < op_count; ++i)
+			{
+				if (ops[i] != &CPU::Break)
+				{
+					m_JIT->EmitCall(ops[i]);
+				}
+			}
+		}
+
+		address += instruction.m_Length;
+		cycles += instruction_cycles;
+		++instruction_count;
 	}
+
+	// Single instructions are not worth leaving the interpreter for
+	if (instruction_count < 2)
+	{
+		return;
+	}
+
+	m_JIT->EmitStore16(program_counter, address);
+
+	a_Trace.m_Function = m_JIT->End();
+	a_Trace.m_EndAddress = address;
+	a_Trace.m_InstructionCount = static_cast<uint8_t>(instruction_count);
+	a_Trace.m_Cycles = static_cast<uint8_t>(cycles);
 }
 
 template <uint8_t Destination, uint8_t Source>
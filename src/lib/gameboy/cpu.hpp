@@ -3,18 +3,23 @@
 
 #include <gameboy/api.hpp>
 #include <gameboy/extendedopcode.hpp>
+#include <gameboy/jit.hpp>
+#include <gameboy/mmu.hpp>
 #include <gameboy/opcode.hpp>
 
+#include <common/blockcache.hpp>
 #include <common/cpuhelper.hpp>
 #include <common/instructionset.hpp>
 #include <common/memory.hpp>
+#include <common/recordable.hpp>
 #include <common/register.hpp>
 
+#include <array>
 #include <functional>
 
 namespace Amber::Gameboy
 {
-	class GAMEBOY_API CPU : public Common::CPUHelper<CPU, uint16_t, 8, 5>
+	class GAMEBOY_API CPU : public Common::CPUHelper<CPU, uint16_t, 8, 5>, public Common::Recordable
 	{
 		public:
 		static constexpr uint8_t RegisterAF = 0;
@@ -57,9 +62,48 @@ namespace Amber::Gameboy
 		// Constructors
 		CPU(Common::Memory16& a_Memory);
 
-		// Memory
+		// Memory: accesses go straight to the MMU's inline loads and stores when it's the CPU's memory
 		Common::Memory16& GetMemory() const noexcept;
 
+		template <typename T>
+		T LoadMemory(uint16_t a_Address) const
+		{
+			static_assert(std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t>);
+
+			if (m_MMU == nullptr)
+			{
+				return m_Memory.Load<T>(a_Address);
+			}
+
+			if constexpr (std::is_same_v<T, uint8_t>)
+			{
+				return m_MMU->Load8(a_Address);
+			}
+			else
+			{
+				return m_MMU->Load16(a_Address);
+			}
+		}
+
+		template <typename T>
+		void StoreMemory(uint16_t a_Address, T a_Value)
+		{
+			static_assert(std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t>);
+
+			if (m_MMU == nullptr)
+			{
+				m_Memory.Store<T>(a_Address, a_Value);
+			}
+			else if constexpr (std::is_same_v<T, uint8_t>)
+			{
+				m_MMU->Store8(a_Address, a_Value);
+			}
+			else
+			{
+				m_MMU->Store16(a_Address, a_Value);
+			}
+		}
+
 		// Registers
 		bool LoadFlag(uint8_t a_Flag) const noexcept;
 		void StoreFlag(uint8_t a_Flag, bool a_Value) noexcept;
@@ -91,7 +135,41 @@ namespace Amber::Gameboy
 		bool Tick();
 		void Reset();
 
+		// Idle skipping: between instructions, the number of cycles (at most a_MaxCycles) the CPU would spend halted or
+		// spinning in a polling loop with only its timer changing, as long as nothing else requests an interrupt or
+		// changes the polled value meanwhile. Skipping them has the same effect as ticking as often.
+		size_t GetIdleCycles(size_t a_MaxCycles);
+		void Skip(size_t a_Cycles) noexcept;
+
+		// Block cache
+		bool IsBlockCacheEnabled() const noexcept;
+		void SetBlockCacheEnabled(bool a_Enabled);
+		void InvalidateBlocks();
+		void InvalidateBlocks(uint16_t a_Address);
+
+		// JIT
+		bool IsJITEnabled() const noexcept;
+		void SetJITEnabled(bool a_Enabled);
+
+		// Recording: the state is saved between instructions, loading it resumes execution by decoding the next one.
+		// Cached blocks are not part of the state, invalidate them once the memory has been loaded as well.
+		size_t GetRecorderMemberCount() const noexcept override;
+		const Common::RecorderMemberDescription& GetRecorderMember(size_t a_Index) const noexcept override;
+		void SaveRecorderState(Common::ByteWriter& a_Writer) const noexcept override;
+		void LoadRecorderState(Common::ByteReader& a_Reader) noexcept override;
+
 		private:
+		using BlockCache = Common::BlockCache<uint16_t, MicroOp>;
+
+		// Timer registers as of a given cycle, DIV counts T-cycles
+		struct TimerState
+		{
+			uint16_t m_DIV = 0;
+			uint8_t m_TIMA = 0;
+			bool m_LastTIMABitState = false;
+			bool m_TIMAOverflow = false;
+		};
+
 		// Math ops
 		template <bool Carry> uint8_t Add8(uint8_t a_Left, uint8_t a_Right) noexcept;
 		template <bool Carry> uint8_t Subtract8(uint8_t a_Left, uint8_t a_Right) noexcept;
@@ -116,10 +194,18 @@ namespace Amber::Gameboy
 		template <bool Flags = true> uint16_t SignedAdd16(uint16_t a_Left, uint8_t a_Right) noexcept;
 		uint8_t DecimalAdjust8(uint8_t a_Value) noexcept;
 
+		// Instructions: the tables are generated at compile time and shared by every CPU
+		static const Common::InstructionSet<Opcode::Enum, MicroOp>& GetInstructions() noexcept;
+		static const Common::InstructionSet<ExtendedOpcode::Enum, MicroOp>& GetExtendedInstructions() noexcept;
+
+		// Recording: ops an instruction can defer to the next one, recorded by their index (0 being none)
+		static const std::array<MicroOp, 4>& GetDeferrableOps() noexcept;
+
 		// Base ops
 		void NotImplemented();
 		void DecodeInstruction();
 		void DecodeExtendedInstruction();
+		void DecodeCachedInstruction();
 		void Break();
 		template <uint8_t Flag, bool Set> void FlagCondition();
 		void DisableInterrupts();
@@ -130,6 +216,27 @@ namespace Amber::Gameboy
 		template <uint8_t Destination, uint8_t Mask> void MaskOp_r8();
 		void ProcessDMA();
 
+		// Timer
+		TimerState GetTimerState() const noexcept;
+		bool IsTimerRegular(const TimerState& a_Timer) const noexcept;
+		uint64_t GetTimerOverflowCycles(const TimerState& a_Timer) const noexcept;
+		bool StepTimer(TimerState& a_Timer) const noexcept;
+		bool AdvanceTimer(TimerState& a_Timer, uint64_t a_Cycles) const noexcept;
+		void UpdateTimer() noexcept;
+		void ScheduleTimer() noexcept;
+
+		// Idle skipping
+		size_t GetTimerIdleCycles() const noexcept;
+		size_t GetIdleLoopCycles();
+
+		// Block cache
+		const BlockCache::Block* FindBlock(uint16_t a_Address);
+		const BlockCache::Block* CompileBlock(uint64_t a_Key, uint16_t a_Address, uint32_t a_Limit, bool a_Watch);
+
+		// JIT
+		bool RunTrace(const BlockCache::Block& a_Block);
+		void CompileTrace(const BlockCache::Block& a_Block, JIT::Trace& a_Trace);
+
 		// 16-bit load ops
 		template <uint8_t Destination, uint8_t Source> void LoadOp_r16_x16r8(uint16_t a_Base);
 		template <uint8_t Destination, uint8_t Source> void LoadOp_r16_FFr8();
@@ -151,31 +258,41 @@ namespace Amber::Gameboy
 
 		// Memory
 		Common::Memory16& m_Memory;
-
-		// Instructions
-		std::unique_ptr<Common::InstructionSet<Opcode::Enum, MicroOp>> m_Instructions;
-		std::unique_ptr<Common::InstructionSet<ExtendedOpcode::Enum, MicroOp>> m_ExtendedInstructions;
+		MMU* const m_MMU;
 
 		// Opcode queue
 		bool m_OpBreak = false;
 
+		// Block cache
+		std::unique_ptr<BlockCache> m_BlockCache;
+		const BlockCache::Block* m_Block = nullptr;
+		size_t m_BlockIndex = 0;
+		uint16_t m_BlockAddress = 0;
+		uint64_t m_BlockGeneration = 0;
+
+		// JIT
+		std::unique_ptr<JIT> m_JIT;
+
 		// Interrupts
 		bool m_InterruptMasterEnable = false;
 		uint8_t m_InterruptEnable = 0;
 		uint8_t m_InterruptRequests = 0;
 		bool m_Halted = false;
 
-		// Timer
-		uint16_t m_DIV = 0;
-		uint8_t m_TIMA = 0;
+		// Timer: the registers are only stored as of m_TimerCycle and computed from there when accessed. Tick only
+		// updates them on m_TimerEventCycle, the cycle a TIMA overflow gets reloaded and its interrupt requested, or
+		// the one right after a write that may have produced a falling edge off the regular schedule.
+		uint64_t m_Cycle = 0;
+		uint64_t m_TimerCycle = 0;
+		uint64_t m_TimerEventCycle = 0;
+		TimerState m_Timer;
 		uint8_t m_TMA = 0;
 		uint8_t m_TAC = 0;
-		bool m_LastTIMABitState = false;
-		bool m_TIMAOverflow = false;
 
 		// DMA
 		uint8_t m_DMAAddress = 0;
 		uint8_t m_DMACounter = 0;
+		bool m_DMAActive = false;
 	};
 }
 
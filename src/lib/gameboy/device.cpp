@@ -1,13 +1,40 @@
 #include <gameboy/device.hpp>
 
+#include <gameboy/cartridge.hpp>
 #include <gameboy/cpu.hpp>
 #include <gameboy/joypad.hpp>
 #include <gameboy/mmu.hpp>
 #include <gameboy/ppu.hpp>
 
+#include <common/bytereader.hpp>
+#include <common/bytewriter.hpp>
+#include <common/exception.hpp>
+#include <common/pagedram.hpp>
+#include <common/ram.hpp>
+
+#include <algorithm>
+#include <cstring>
+
 using namespace Amber;
+using namespace Common;
 using namespace Gameboy;
 
+namespace
+{
+	const char SaveStateMagic[8] = { 'A', 'M', 'B', 'R', 'S', 'A', 'V', 'E' };
+
+	size_t GetVLQSize(size_t a_Quantity) noexcept
+	{
+		size_t size = 1;
+		while (a_Quantity >>= 7)
+		{
+			++size;
+		}
+
+		return size;
+	}
+}
+
 Device::Device(const DeviceDescription& a_Description):
 	m_Description(a_Description)
 {
@@ -54,9 +81,16 @@ Joypad& Device::GetJoypad() noexcept
 
 bool Device::Tick()
 {
-	for (size_t i = 0; i < 4; ++i)
+	if (m_SchedulerEnabled)
 	{
-		m_PPU->Tick();
+		m_PPU->Advance(4);
+	}
+	else
+	{
+		for (size_t i = 0; i < 4; ++i)
+		{
+			m_PPU->Tick();
+		}
 	}
 
 	const bool done = m_CPU->Tick();
@@ -64,9 +98,346 @@ bool Device::Tick()
 	return done;
 }
 
+void Device::Run(uint64_t a_Cycles)
+{
+	uint64_t cycles = 0;
+	while (cycles < a_Cycles)
+	{
+		++cycles;
+		if (!Tick())
+		{
+			continue;
+		}
+
+		// Nothing can wake the CPU until the PPU requests an interrupt or changes LY, which it does on the tick that
+		// reaches its deadline
+		const size_t ppu_dots = m_PPU->GetIdleDots();
+		if (ppu_dots <= 4)
+		{
+			continue;
+		}
+
+		const size_t idle_cycles = m_CPU->GetIdleCycles(static_cast<size_t>(std::min<uint64_t>(a_Cycles - cycles, (ppu_dots - 1) / 4)));
+		if (idle_cycles == 0)
+		{
+			continue;
+		}
+
+		m_PPU->Advance(idle_cycles * 4);
+		if (!m_SchedulerEnabled)
+		{
+			m_PPU->Synchronize();
+		}
+		m_CPU->Skip(idle_cycles);
+		cycles += idle_cycles;
+	}
+}
+
 void Device::Reset()
 {
 	m_CPU->Reset();
 	m_PPU->Reset();
 	m_MMU->Reset();
+}
+
+bool Device::IsSchedulerEnabled() const noexcept
+{
+	return m_SchedulerEnabled;
+}
+
+void Device::SetSchedulerEnabled(bool a_Enabled)
+{
+	if (!a_Enabled)
+	{
+		Synchronize();
+	}
+
+	m_SchedulerEnabled = a_Enabled;
+}
+
+void Device::Synchronize()
+{
+	m_PPU->Synchronize();
+	m_PPU->FlushLine();
+}
+
+void Device::AddRecorderChannels(RecorderDescription& a_Description, bool a_JournalInput) const
+{
+	for (const auto& [name, recordable] : GetRecordables())
+	{
+		a_Description.AddChannel(recordable->GetRecorderChannelDescription(name));
+	}
+
+	if (a_JournalInput)
+	{
+		RecorderChannelDescription channel_description;
+		channel_description.SetName(InputChannelName);
+		channel_description.AddMember({ "Buttons", RecorderMemberType::uint8 });
+		channel_description.SetJournaled(true);
+		a_Description.AddChannel(channel_description);
+	}
+}
+
+void Device::Record(Recorder& a_Recorder)
+{
+	Synchronize();
+
+	for (const auto& [name, recordable] : GetRecordables())
+	{
+		const auto channel = FindRecorderChannel(a_Recorder, name, *recordable);
+		if (!channel.has_value())
+		{
+			continue;
+		}
+
+		m_RecorderBuffer.resize(recordable->GetRecorderStateSize());
+		ByteWriter writer(m_RecorderBuffer.data(), m_RecorderBuffer.size());
+		recordable->SaveRecorderState(writer);
+
+		a_Recorder.WriteChannelData(*channel, m_RecorderBuffer.data());
+	}
+
+	// Buttons only change between frames, so the ones held now are the ones the frame ran with
+	if (const auto channel = FindInputChannel(a_Recorder))
+	{
+		const uint8_t buttons = m_Joypad->GetButtonState(0xFF);
+		a_Recorder.WriteChannelData(*channel, &buttons);
+	}
+}
+
+void Device::Restore(const Recorder& a_Recorder)
+{
+	for (const auto& [name, recordable] : GetRecordables())
+	{
+		const auto channel = FindRecorderChannel(a_Recorder, name, *recordable);
+		if (!channel.has_value())
+		{
+			continue;
+		}
+
+		ByteReader reader(a_Recorder.ReadChannelData(*channel), recordable->GetRecorderStateSize());
+		recordable->LoadRecorderState(reader);
+	}
+
+	// Any memory may have changed underneath the cached blocks and the MMU's page pointers
+	m_CPU->InvalidateBlocks();
+	m_MMU->UpdatePages();
+}
+
+void Device::SaveState(std::vector<uint8_t>& a_State)
+{
+	Synchronize();
+
+	const auto recordables = GetRecordables();
+
+	// Size the state up front, resizing a state that was saved before doesn't reallocate
+	size_t size = sizeof(SaveStateMagic) + GetVLQSize(SaveStateVersion) + GetVLQSize(recordables.size());
+	for (const auto& [name, recordable] : recordables)
+	{
+		const size_t state_size = recordable->GetRecorderStateSize();
+		size += GetVLQSize(name.size()) + name.size() + GetVLQSize(state_size) + state_size;
+	}
+
+	a_State.resize(size);
+	ByteWriter writer(a_State.data(), a_State.size());
+	writer.Write(SaveStateMagic, sizeof(SaveStateMagic));
+	writer.WriteVLQ(SaveStateVersion);
+	writer.WriteVLQ(recordables.size());
+	for (const auto& [name, recordable] : recordables)
+	{
+		writer.WriteVLQ(name.size());
+		writer.Write(name.data(), name.size());
+		writer.WriteVLQ(recordable->GetRecorderStateSize());
+		recordable->SaveRecorderState(writer);
+	}
+}
+
+void Device::LoadState(const void* a_State, size_t a_Size)
+{
+	ByteReader reader(a_State, a_Size);
+
+	char magic[sizeof(SaveStateMagic)];
+	uint32_t version = 0;
+	if (reader.Read(magic, sizeof(magic)) != sizeof(magic) || std::memcmp(magic, SaveStateMagic, sizeof(magic)) != 0)
+	{
+		throw Exception("Not a save state");
+	}
+
+	if (reader.ReadVLQ(version) == 0 || version != SaveStateVersion)
+	{
+		throw Exception("Unsupported save state version");
+	}
+
+	const auto recordables = GetRecordables();
+	size_t section_count = 0;
+	if (reader.ReadVLQ(section_count) == 0 || section_count != recordables.size())
+	{
+		throw Exception("Save state doesn't match the device");
+	}
+
+	// Validate every section before loading any, so a bad state leaves the device as it was
+	const auto* const state = static_cast<const uint8_t*>(a_State);
+	std::vector<size_t> offsets(recordables.size());
+	for (size_t i = 0; i < section_count; ++i)
+	{
+		size_t name_size = 0;
+		size_t state_size = 0;
+		if (reader.ReadVLQ(name_size) == 0 || name_size > a_Size - reader.GetPosition())
+		{
+			throw Exception("Save state is truncated");
+		}
+
+		const std::string_view name(reinterpret_cast<const char*>(state + reader.GetPosition()), name_size);
+		reader.SetPosition(reader.GetPosition() + name_size);
+		if (reader.ReadVLQ(state_size) == 0 || state_size > a_Size - reader.GetPosition())
+		{
+			throw Exception("Save state is truncated");
+		}
+
+		const auto& [expected_name, recordable] = recordables[i];
+		if (name != expected_name || state_size != recordable->GetRecorderStateSize())
+		{
+			throw Exception("Save state doesn't match the device");
+		}
+
+		offsets[i] = reader.GetPosition();
+		reader.SetPosition(reader.GetPosition() + state_size);
+	}
+
+	for (size_t i = 0; i < recordables.size(); ++i)
+	{
+		Recordable* const recordable = recordables[i].second;
+		ByteReader section(state + offsets[i], recordable->GetRecorderStateSize());
+		recordable->LoadRecorderState(section);
+	}
+
+	// Any memory may have changed underneath the cached blocks and the MMU's page pointers
+	m_CPU->InvalidateBlocks();
+	m_MMU->UpdatePages();
+}
+
+std::unique_ptr<Device> Device::Fork()
+{
+	auto fork = std::make_unique<Device>(m_Description);
+	fork->SetSchedulerEnabled(m_SchedulerEnabled);
+	fork->m_CPU->SetBlockCacheEnabled(m_CPU->IsBlockCacheEnabled());
+	fork->m_CPU->SetJITEnabled(m_CPU->IsJITEnabled());
+	fork->m_PPU->SetScanlineRendererEnabled(m_PPU->IsScanlineRendererEnabled());
+
+	// Plain VRAM and WRAM are moved into paged RAM on the first fork, so every fork after it shares their pages too
+	if (auto vram = PageMemory(m_MMU->GetVRAM()))
+	{
+		m_MMU->SetVRAM(vram);
+	}
+	if (auto wram = PageMemory(m_MMU->GetWRAM()))
+	{
+		m_MMU->SetWRAM(wram);
+	}
+
+	fork->m_MMU->SetBootROM(fork->ForkMemory(m_MMU->GetBootROM()));
+	fork->m_MMU->SetCartridge(fork->ForkMemory(m_MMU->GetCartridge()));
+	fork->m_MMU->SetVRAM(fork->ForkMemory(m_MMU->GetVRAM()));
+	fork->m_MMU->SetWRAM(fork->ForkMemory(m_MMU->GetWRAM()));
+
+	// Pages this device could write to directly are shared with the fork now
+	m_MMU->UpdatePages();
+
+	// The memories already match, loading them again leaves their pages shared
+	SaveState(m_RecorderBuffer);
+	fork->LoadState(m_RecorderBuffer.data(), m_RecorderBuffer.size());
+
+	return fork;
+}
+
+std::vector<std::pair<std::string_view, Recordable*>> Device::GetRecordables() const
+{
+	std::vector<std::pair<std::string_view, Recordable*>> recordables =
+	{
+		{ "CPU", m_CPU.get() },
+		{ "PPU", m_PPU.get() },
+		{ "MMU", m_MMU.get() },
+		{ "Joypad", m_Joypad.get() },
+	};
+
+	const std::pair<std::string_view, Memory16*> memories[] =
+	{
+		{ "Cartridge", m_MMU->GetCartridge() },
+		{ "VRAM", m_MMU->GetVRAM() },
+		{ "WRAM", m_MMU->GetWRAM() },
+	};
+
+	for (const auto& [name, memory] : memories)
+	{
+		if (auto recordable = dynamic_cast<Recordable*>(memory))
+		{
+			recordables.emplace_back(name, recordable);
+		}
+	}
+
+	return recordables;
+}
+
+std::optional<size_t> Device::FindRecorderChannel(const Recorder& a_Recorder, std::string_view a_Name, const Recordable& a_Recordable) const
+{
+	const auto& description = a_Recorder.GetDescription();
+	const auto channel = description.FindChannel(a_Name);
+	if (channel.has_value() && description.GetChannel(*channel).GetSize() != a_Recordable.GetRecorderStateSize())
+	{
+		throw Exception("Recorder channel doesn't match the device");
+	}
+
+	return channel;
+}
+
+std::optional<size_t> Device::FindInputChannel(const Recorder& a_Recorder) const
+{
+	const auto& description = a_Recorder.GetDescription();
+	const auto channel = description.FindChannel(InputChannelName);
+	if (channel.has_value() && description.GetChannel(*channel).GetSize() != sizeof(uint8_t))
+	{
+		throw Exception("Recorder channel doesn't match the device");
+	}
+
+	return channel;
+}
+
+Memory16* Device::PageMemory(Memory16* a_Memory)
+{
+	const auto ram = dynamic_cast<RAM16<false>*>(a_Memory);
+	if (ram == nullptr)
+	{
+		return nullptr;
+	}
+
+	m_ForkedMemories.push_back(std::make_unique<PagedRAM16<false>>(ram->GetData(), ram->GetSize()));
+	return m_ForkedMemories.back().get();
+}
+
+Memory16* Device::ForkMemory(Memory16* a_Memory)
+{
+	if (a_Memory == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::unique_ptr<Memory16> fork;
+	if (auto cartridge = dynamic_cast<Cartridge*>(a_Memory))
+	{
+		fork = cartridge->Fork();
+	}
+	else if (auto paged = dynamic_cast<PagedRAM16<false>*>(a_Memory))
+	{
+		fork = std::make_unique<PagedRAM16<false>>(*paged);
+	}
+	else if (auto ram = dynamic_cast<RAM16<false>*>(a_Memory))
+	{
+		fork = std::make_unique<PagedRAM16<false>>(ram->GetData(), ram->GetSize());
+	}
+	else
+	{
+		throw Exception("Memory can't be forked");
+	}
+
+	m_ForkedMemories.push_back(std::move(fork));
+	return m_ForkedMemories.back().get();
 }
\ No newline at end of file
@@ -4,7 +4,16 @@
 #include <gameboy/api.hpp>
 #include <gameboy/devicedescription.hpp>
 
+#include <common/memory.hpp>
+#include <common/recordable.hpp>
+#include <common/recorder.hpp>
+#include <common/recorderdescription.hpp>
+
 #include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace Amber::Gameboy
 {
@@ -29,8 +38,62 @@ namespace Amber::Gameboy
 		bool Tick();
 		void Reset();
 
+		// Runs for a_Cycles ticks, the same as calling Tick that often but faster: whenever the CPU is halted or
+		// spinning in a loop that polls LY or RAM, it jumps straight to the first cycle that could wake it up
+		void Run(uint64_t a_Cycles);
+
+		// Scheduling: the PPU trails the CPU and is only caught up when the CPU touches it or an interrupt is due,
+		// call Synchronize before inspecting the PPU from outside (this also draws a deferred line up to now)
+		bool IsSchedulerEnabled() const noexcept;
+		void SetSchedulerEnabled(bool a_Enabled);
+		void Synchronize();
+
+		// Recording: every component gets a channel named after it, as does every recordable memory attached to the
+		// MMU ("Cartridge", "VRAM" and "WRAM"). Recording and restoring skip channels the recorder doesn't have, so
+		// a recorder can also hold just part of the device.
+		//
+		// Journaling the input adds a journaled "Input" channel with the buttons held during the frame. A recorder
+		// then only stores the input between keyframes, and a DeviceReplayer re-runs the device to regenerate the
+		// rest on seek.
+		static constexpr std::string_view InputChannelName = "Input";
+
+		void AddRecorderChannels(Common::RecorderDescription& a_Description, bool a_JournalInput = false) const;
+		void Record(Common::Recorder& a_Recorder);
+		void Restore(const Common::Recorder& a_Recorder);
+		std::optional<size_t> FindInputChannel(const Common::Recorder& a_Recorder) const;
+
+		// Save states hold one section per recorder channel, laid out as:
+		//
+		//   magic          "AMBRSAVE"
+		//   version        VLQ
+		//   section count  VLQ
+		//   per section:   VLQ name length, name, VLQ state size, state
+		//
+		// A section's state is the component's recorder state as is, so loading checks every section against the
+		// device up front and then hands each one to its component's LoadRecorderState. Plain RAM copies its section in
+		// one go and paged RAM only the pages that differ, the other components read theirs field by field. A state
+		// saved by a different version or for a differently configured device is rejected without touching the device.
+		static constexpr uint32_t SaveStateVersion = 3;
+
+		void SaveState(std::vector<uint8_t>& a_State);
+		void LoadState(const void* a_State, size_t a_Size);
+
+		// Forking: creates an independent device in the same state that owns its memories. The fork shares the
+		// cartridge ROM, and the 4 kb pages of cartridge RAM, VRAM and WRAM with this device until one of them writes
+		// to a page. VRAM and WRAM attached as plain RAM are copied into paged RAM owned by this device on its first
+		// fork and attached in their place, read them through the MMU from then on.
+		std::unique_ptr<Device> Fork();
+
 		private:
+		std::vector<std::pair<std::string_view, Common::Recordable*>> GetRecordables() const;
+		std::optional<size_t> FindRecorderChannel(const Common::Recorder& a_Recorder, std::string_view a_Name, const Common::Recordable& a_Recordable) const;
+		Common::Memory16* PageMemory(Common::Memory16* a_Memory);
+		Common::Memory16* ForkMemory(Common::Memory16* a_Memory);
+
 		const DeviceDescription m_Description;
+		bool m_SchedulerEnabled = false;
+		std::vector<uint8_t> m_RecorderBuffer;
+		std::vector<std::unique_ptr<Common::Memory16>> m_ForkedMemories;
 
 		std::unique_ptr<MMU> m_MMU;
 		std::unique_ptr<CPU> m_CPU;
@@ -0,0 +1,70 @@
+#include <gameboy/devicereplayer.hpp>
+
+#include <gameboy/device.hpp>
+#include <gameboy/joypad.hpp>
+#include <gameboy/ppu.hpp>
+
+#include <common/exception.hpp>
+#include <common/recorder.hpp>
+
+using namespace Amber;
+using namespace Gameboy;
+
+DeviceReplayer::DeviceReplayer(Device& a_Device):
+	m_Device(a_Device)
+{
+	m_Device.GetPPU().AddObserver(*this);
+}
+
+DeviceReplayer::~DeviceReplayer() noexcept
+{
+	m_Device.GetPPU().RemoveObserver(*this);
+}
+
+void DeviceReplayer::RunFrame()
+{
+	m_EnteredVBlank = false;
+	do
+	{
+		while (!m_Device.Tick())
+		{
+		}
+	}
+	while (!m_EnteredVBlank);
+}
+
+void DeviceReplayer::ReplayFrame(Common::Recorder& a_Recorder, size_t a_Frame)
+{
+	const auto input_channel = m_Device.FindInputChannel(a_Recorder);
+	if (!input_channel.has_value())
+	{
+		throw Exception("Recorder doesn't journal the device's input");
+	}
+
+	// Everything but the input channel still holds the previous frame
+	m_Device.Restore(a_Recorder);
+
+	// Change the buttons the same way the client does between frames, which also raises the joypad interrupt
+	auto& joypad = m_Device.GetJoypad();
+	const uint8_t buttons = *static_cast<const uint8_t*>(a_Recorder.ReadChannelData(*input_channel));
+	const uint8_t held = joypad.GetButtonState(0xFF);
+	if (const uint8_t released = held & ~buttons; released != 0)
+	{
+		joypad.SetButtonState(released, false);
+	}
+	if (const uint8_t pressed = buttons & ~held; pressed != 0)
+	{
+		joypad.SetButtonState(pressed, true);
+	}
+
+	RunFrame();
+	m_Device.Record(a_Recorder);
+}
+
+void DeviceReplayer::OnLCDModeChange(LCDMode::Enum a_From, LCDMode::Enum a_To)
+{
+	if (a_To == LCDMode::VBlank)
+	{
+		m_EnteredVBlank = true;
+	}
+}
\ No newline at end of file
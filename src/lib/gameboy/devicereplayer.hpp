@@ -0,0 +1,40 @@
+#ifndef H_AMBER_GAMEBOY_DEVICEREPLAYER
+#define H_AMBER_GAMEBOY_DEVICEREPLAYER
+
+#include <gameboy/api.hpp>
+#include <gameboy/ppuobserver.hpp>
+
+#include <common/recorderreplayer.hpp>
+
+namespace Amber::Gameboy
+{
+	class Device;
+
+	// Regenerates a device's frames for a recorder that journals its input (see Device::AddRecorderChannels). A frame
+	// is replayed by restoring the previous one, applying the buttons recorded for it and running up to the first
+	// instruction boundary after the PPU enters VBlank, which is where Debugger::Run ends a frame.
+	//
+	// This only reproduces frames that ran from their predecessor exactly like that. Anything else that changes the
+	// device between two recorded frames (stepping, resetting, seeking) has to force a keyframe, see
+	// Common::Recorder::ForceKeyframe.
+	class GAMEBOY_API DeviceReplayer : public Common::RecorderReplayer, PPUObserver
+	{
+		public:
+		DeviceReplayer(Device& a_Device);
+		~DeviceReplayer() noexcept override;
+
+		// Runs the device up to the first instruction boundary after entering VBlank, for recording the same frames
+		// without a debugger
+		void RunFrame();
+
+		void ReplayFrame(Common::Recorder& a_Recorder, size_t a_Frame) override;
+
+		void OnLCDModeChange(LCDMode::Enum a_From, LCDMode::Enum a_To) override;
+
+		private:
+		Device& m_Device;
+		bool m_EnteredVBlank = false;
+	};
+}
+
+#endif
\ No newline at end of file
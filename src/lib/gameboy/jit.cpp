@@ -0,0 +1,238 @@
+#include <gameboy/jit.hpp>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define AMBER_GAMEBOY_JIT_X64
+#endif
+
+using namespace Amber;
+using namespace Gameboy;
+
+namespace
+{
+	constexpr size_t PageSize = 0x10000;
+
+	// Register holding the object pointer for the duration of a trace
+	constexpr uint8_t RBX = 3;
+
+	// First integer argument register
+	#if defined(_WIN32)
+	constexpr uint8_t ArgumentRegister = 1; // RCX
+	constexpr uint8_t ShadowSpace = 32;
+	#else
+	constexpr uint8_t ArgumentRegister = 7; // RDI
+	constexpr uint8_t ShadowSpace = 0;
+	#endif
+
+	// Code pages are never writable and executable at the same time, they start out writable and are flipped to
+	// executable once code has been copied in
+	void* AllocateExecutable(size_t a_Size)
+	{
+		#if defined(_WIN32)
+		return VirtualAlloc(nullptr, a_Size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+		#else
+		void* const memory = mmap(nullptr, a_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		return memory != MAP_FAILED ? memory : nullptr;
+		#endif
+	}
+
+	bool ProtectExecutable(void* a_Memory, size_t a_Size, bool a_Executable)
+	{
+		#if defined(_WIN32)
+		DWORD old_protection;
+		return VirtualProtect(a_Memory, a_Size, a_Executable ? PAGE_EXECUTE_READ : PAGE_READWRITE, &old_protection) != 0;
+		#else
+		return mprotect(a_Memory, a_Size, a_Executable ? (PROT_READ | PROT_EXEC) : (PROT_READ | PROT_WRITE)) == 0;
+		#endif
+	}
+
+	void FreeExecutable(void* a_Memory, size_t a_Size)
+	{
+		#if defined(_WIN32)
+		VirtualFree(a_Memory, 0, MEM_RELEASE);
+		#else
+		munmap(a_Memory, a_Size);
+		#endif
+	}
+}
+
+struct JIT::Page
+{
+	Page(void* a_Memory):
+		m_Memory(static_cast<uint8_t*>(a_Memory))
+	{
+	}
+
+	~Page() noexcept
+	{
+		FreeExecutable(m_Memory, PageSize);
+	}
+
+	uint8_t* m_Memory;
+	size_t m_Used = 0;
+};
+
+JIT::JIT() = default;
+
+JIT::~JIT() noexcept = default;
+
+bool JIT::IsSupported() noexcept
+{
+	#if defined(AMBER_GAMEBOY_JIT_X64)
+	return true;
+	#else
+	return false;
+	#endif
+}
+
+JIT::Trace& JIT::GetTrace(uint64_t a_Key)
+{
+	return m_Traces[a_Key];
+}
+
+void JIT::Clear()
+{
+	m_Traces.clear();
+	m_Pages.clear();
+}
+
+void JIT::Begin()
+{
+	m_Code.clear();
+	m_Failed = !IsSupported();
+
+	// push rbx
+	Emit8(0x53);
+
+	// sub rsp, ShadowSpace
+	if constexpr (ShadowSpace != 0)
+	{
+		Emit8(0x48); Emit8(0x83); Emit8(0xEC); Emit8(ShadowSpace);
+	}
+
+	// mov rbx, <argument>
+	Emit8(0x48); Emit8(0x89); Emit8(0xC0 | (ArgumentRegister << 3) | RBX);
+}
+
+JIT::Function JIT::End()
+{
+	// add rsp, ShadowSpace
+	if constexpr (ShadowSpace != 0)
+	{
+		Emit8(0x48); Emit8(0x83); Emit8(0xC4); Emit8(ShadowSpace);
+	}
+
+	// pop rbx; ret
+	Emit8(0x5B);
+	Emit8(0xC3);
+
+	if (m_Failed || m_Code.size() > PageSize)
+	{
+		return nullptr;
+	}
+
+	// Copy the code into executable memory, a page that already holds traces is made writable again for the copy
+	if (m_Pages.empty() || m_Pages.back()->m_Used + m_Code.size() > PageSize)
+	{
+		void* const memory = AllocateExecutable(PageSize);
+		if (memory == nullptr)
+		{
+			return nullptr;
+		}
+
+		m_Pages.push_back(std::make_unique<Page>(memory));
+	}
+	else if (!ProtectExecutable(m_Pages.back()->m_Memory, PageSize, false))
+	{
+		return nullptr;
+	}
+
+	auto& page = *m_Pages.back();
+	uint8_t* const code = page.m_Memory + page.m_Used;
+	std::copy(m_Code.begin(), m_Code.end(), code);
+	page.m_Used += (m_Code.size() + 15) & ~size_t(15);
+
+	if (!ProtectExecutable(page.m_Memory, PageSize, true))
+	{
+		return nullptr;
+	}
+
+	return reinterpret_cast<Function>(code);
+}
+
+bool JIT::EmitCall(const void* a_Function, ptrdiff_t a_Adjustment)
+{
+	if (a_Adjustment < std::numeric_limits<int32_t>::min() || a_Adjustment > std::numeric_limits<int32_t>::max())
+	{
+		m_Failed = true;
+		return false;
+	}
+
+	if (a_Adjustment == 0)
+	{
+		// mov <argument>, rbx
+		Emit8(0x48); Emit8(0x89); Emit8(0xC0 | (RBX << 3) | ArgumentRegister);
+	}
+	else
+	{
+		// lea <argument>, [rbx + adjustment]
+		Emit8(0x48); Emit8(0x8D); Emit8(0x80 | (ArgumentRegister << 3) | RBX);
+		Emit32(static_cast<uint32_t>(a_Adjustment));
+	}
+
+	// mov rax, function; call rax
+	Emit8(0x48); Emit8(0xB8);
+	Emit64(reinterpret_cast<uintptr_t>(a_Function));
+	Emit8(0xFF); Emit8(0xD0);
+
+	return !m_Failed;
+}
+
+bool JIT::EmitStore16(ptrdiff_t a_Offset, uint16_t a_Value)
+{
+	if (a_Offset < std::numeric_limits<int32_t>::min() || a_Offset > std::numeric_limits<int32_t>::max())
+	{
+		m_Failed = true;
+		return false;
+	}
+
+	// mov word [rbx + offset], value
+	Emit8(0x66); Emit8(0xC7); Emit8(0x80 | RBX);
+	Emit32(static_cast<uint32_t>(a_Offset));
+	Emit16(a_Value);
+
+	return !m_Failed;
+}
+
+void JIT::Emit8(uint8_t a_Value)
+{
+	m_Code.push_back(a_Value);
+}
+
+void JIT::Emit16(uint16_t a_Value)
+{
+	Emit8(a_Value & 0xFF);
+	Emit8(a_Value >> 8);
+}
+
+void JIT::Emit32(uint32_t a_Value)
+{
+	Emit16(a_Value & 0xFFFF);
+	Emit16(a_Value >> 16);
+}
+
+void JIT::Emit64(uint64_t a_Value)
+{
+	Emit32(a_Value & 0xFFFFFFFF);
+	Emit32(a_Value >> 32);
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#ifndef H_AMBER_GAMEBOY_JIT
+#define H_AMBER_GAMEBOY_JIT
+
+#include <gameboy/api.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Amber::Gameboy
+{
+	// Call-threaded x86-64 code generator. A trace is a straight-line sequence of member function calls on a single
+	// object, emitted as native code so that running it skips the micro-op queue entirely.
+	class GAMEBOY_API JIT
+	{
+		public:
+		using Function = void (*)(void* a_Object);
+
+		struct Trace
+		{
+			Function m_Function = nullptr;
+			uint32_t m_Hits = 0;
+			bool m_Compiled = false;
+			uint16_t m_EndAddress = 0;
+			uint8_t m_InstructionCount = 0;
+			uint8_t m_Cycles = 0;
+		};
+
+		JIT();
+		~JIT() noexcept;
+
+		static bool IsSupported() noexcept;
+
+		// Traces
+		Trace& GetTrace(uint64_t a_Key);
+		void Clear();
+
+		// Code generation
+		void Begin();
+		Function End();
+
+		template <typename MicroOp>
+		bool EmitCall(MicroOp a_Op)
+		{
+			#if defined(_MSC_VER)
+			// MSVC member function pointers are a plain function pointer for classes with single inheritance, and the
+			// function followed by a 32-bit this adjustment for multiple inheritance (the CPU is also Recordable).
+			// Virtual functions are called through a thunk, which works like any other function. Virtual bases aren't
+			// supported, and the bigger pointers of incomplete classes are left to the interpreter.
+			if constexpr (sizeof(MicroOp) == sizeof(void*))
+			{
+				const void* function;
+				std::memcpy(&function, &a_Op, sizeof(function));
+				return EmitCall(function, 0);
+			}
+			else if constexpr (sizeof(MicroOp) == 2 * sizeof(void*))
+			{
+				struct
+				{
+					uintptr_t m_Function;
+					int32_t m_Adjustment;
+				} representation;
+				std::memcpy(&representation, &a_Op, sizeof(uintptr_t) + sizeof(int32_t));
+				return EmitCall(reinterpret_cast<const void*>(representation.m_Function), representation.m_Adjustment);
+			}
+			else
+			{
+				m_Failed = true;
+				return false;
+			}
+			#else
+			// Itanium ABI member function pointers are { function, this adjustment }, where an odd function value
+			// marks a virtual call
+			struct
+			{
+				uintptr_t m_Function;
+				ptrdiff_t m_Adjustment;
+			} representation;
+			static_assert(sizeof(representation) == sizeof(MicroOp));
+			std::memcpy(&representation, &a_Op, sizeof(representation));
+
+			if ((representation.m_Function & 1) != 0)
+			{
+				m_Failed = true;
+				return false;
+			}
+
+			return EmitCall(reinterpret_cast<const void*>(representation.m_Function), representation.m_Adjustment);
+			#endif
+		}
+
+		bool EmitCall(const void* a_Function, ptrdiff_t a_Adjustment);
+		bool EmitStore16(ptrdiff_t a_Offset, uint16_t a_Value);
+
+		private:
+		struct Page;
+
+		void Emit8(uint8_t a_Value);
+		void Emit16(uint16_t a_Value);
+		void Emit32(uint32_t a_Value);
+		void Emit64(uint64_t a_Value);
+
+		std::unordered_map<uint64_t, Trace> m_Traces;
+		std::vector<std::unique_ptr<Page>> m_Pages;
+		std::vector<uint8_t> m_Code;
+		bool m_Failed = false;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -3,8 +3,18 @@
 #include <gameboy/cpu.hpp>
 
 using namespace Amber;
+using namespace Common;
 using namespace Gameboy;
 
+namespace
+{
+	const RecorderMemberDescription RecorderMembers[] =
+	{
+		{ "ButtonStates", RecorderMemberType::uint8 },
+		{ "Register", RecorderMemberType::uint8 },
+	};
+}
+
 void Joypad::SetCPU(CPU* a_CPU) noexcept
 {
 	m_CPU = a_CPU;
@@ -45,6 +55,28 @@ uint8_t Joypad::GetRegister() const noexcept
 	return m_Register;
 }
 
+size_t Joypad::GetRecorderMemberCount() const noexcept
+{
+	return std::size(RecorderMembers);
+}
+
+const RecorderMemberDescription& Joypad::GetRecorderMember(size_t a_Index) const noexcept
+{
+	return RecorderMembers[a_Index];
+}
+
+void Joypad::SaveRecorderState(ByteWriter& a_Writer) const noexcept
+{
+	a_Writer.Write(m_ButtonStates);
+	a_Writer.Write(m_Register);
+}
+
+void Joypad::LoadRecorderState(ByteReader& a_Reader) noexcept
+{
+	a_Reader.Read(m_ButtonStates);
+	a_Reader.Read(m_Register);
+}
+
 void Joypad::UpdateRegister()
 {
 	// Calculate new button state
@@ -3,11 +3,13 @@
 
 #include <gameboy/api.hpp>
 
+#include <common/recordable.hpp>
+
 namespace Amber::Gameboy
 {
 	class CPU;
 
-	class GAMEBOY_API Joypad
+	class GAMEBOY_API Joypad : public Common::Recordable
 	{
 		public:
 		static constexpr uint8_t DirectionSelectBit = 4;
@@ -23,6 +25,11 @@ namespace Amber::Gameboy
 		uint8_t GetButtonState(uint8_t a_Buttons) const noexcept;
 		uint8_t GetRegister() const noexcept;
 
+		size_t GetRecorderMemberCount() const noexcept override;
+		const Common::RecorderMemberDescription& GetRecorderMember(size_t a_Index) const noexcept override;
+		void SaveRecorderState(Common::ByteWriter& a_Writer) const noexcept override;
+		void LoadRecorderState(Common::ByteReader& a_Reader) noexcept override;
+
 		private:
 		void UpdateRegister();
 
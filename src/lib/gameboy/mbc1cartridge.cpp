@@ -1,11 +1,16 @@
 #include <gameboy/mbc1cartridge.hpp>
 
 using namespace Amber;
+using namespace Common;
 using namespace Gameboy;
 
 MBC1Cartridge::MBC1Cartridge(size_t a_ROMSize, size_t a_RAMSize):
 	BasicCartridge(a_ROMSize, a_RAMSize)
 {
+	m_RecorderMembers.emplace_back("ROMBanking", RecorderMemberType::uint8);
+	m_RecorderMembers.emplace_back("RAMEnabled", RecorderMemberType::uint8);
+	m_RecorderMembers.emplace_back("ROMBank", RecorderMemberType::uint8);
+	m_RecorderMembers.emplace_back("RAMBank", RecorderMemberType::uint8);
 }
 
 uint8_t MBC1Cartridge::Load8(Address a_Address) const
@@ -16,13 +21,21 @@ uint8_t MBC1Cartridge::Load8(Address a_Address) const
 		case 0x1000:
 		case 0x2000:
 		case 0x3000:
-		return m_ROM.Load8(a_Address);
+		return m_ROM->Load8(a_Address);
 
 		case 0x4000:
 		case 0x5000:
 		case 0x6000:
 		case 0x7000:
-		return m_ROM.Load8((a_Address - 0x4000) + m_ROMBank * ROMBankSize);
+		{
+			// Banks past the first 64KB don't fit in a ROM address
+			const size_t offset = (a_Address - 0x4000) + m_ROMBank * ROMBankSize;
+			if (offset < m_ROM->GetSize())
+			{
+				return m_ROM->GetData()[offset];
+			}
+		}
+		break;
 
 		case 0xA000:
 		case 0xB000:
@@ -88,4 +101,97 @@ void MBC1Cartridge::Store8(Address a_Address, uint8_t a_Value)
 		}
 		break;
 	}
+}
+
+uint64_t MBC1Cartridge::GetPhysicalAddress(Address a_Address) const
+{
+	switch (a_Address & 0xF000)
+	{
+		case 0x4000:
+		case 0x5000:
+		case 0x6000:
+		case 0x7000:
+		return (a_Address - 0x4000) + m_ROMBank * uint64_t(ROMBankSize);
+
+		case 0xA000:
+		case 0xB000:
+		return m_ROM->GetSize() + (a_Address - 0xA000) + m_RAMBank * uint64_t(RAMBankSize);
+
+		default:
+		return a_Address;
+	}
+}
+
+const uint8_t* MBC1Cartridge::GetReadPage(Address a_Address) const
+{
+	switch (a_Address & 0xF000)
+	{
+		case 0x0000:
+		case 0x1000:
+		case 0x2000:
+		case 0x3000:
+		return m_ROM->GetReadPage(a_Address);
+
+		case 0x4000:
+		case 0x5000:
+		case 0x6000:
+		case 0x7000:
+		{
+			const size_t offset = (a_Address - 0x4000) + m_ROMBank * ROMBankSize;
+			if (offset + PageSize <= m_ROM->GetSize())
+			{
+				return m_ROM->GetData() + offset;
+			}
+		}
+		break;
+
+		case 0xA000:
+		case 0xB000:
+		if (m_RAMEnabled)
+		{
+			return m_RAM.GetReadPage((a_Address - 0xA000) + m_RAMBank * RAMBankSize);
+		}
+	}
+
+	return nullptr;
+}
+
+uint8_t* MBC1Cartridge::GetWritePage(Address a_Address)
+{
+	switch (a_Address & 0xF000)
+	{
+		case 0xA000:
+		case 0xB000:
+		if (m_RAMEnabled)
+		{
+			return m_RAM.GetWritePage((a_Address - 0xA000) + m_RAMBank * RAMBankSize);
+		}
+	}
+
+	return nullptr;
+}
+
+std::unique_ptr<Cartridge> MBC1Cartridge::Fork() const
+{
+	return std::make_unique<MBC1Cartridge>(*this);
+}
+
+void MBC1Cartridge::SaveRecorderState(ByteWriter& a_Writer) const noexcept
+{
+	BasicCartridge::SaveRecorderState(a_Writer);
+
+	a_Writer.Write(m_ROMBanking);
+	a_Writer.Write(m_RAMEnabled);
+	a_Writer.Write(m_ROMBank);
+	a_Writer.Write(m_RAMBank);
+}
+
+void MBC1Cartridge::LoadRecorderState(ByteReader& a_Reader) noexcept
+{
+	BasicCartridge::LoadRecorderState(a_Reader);
+
+	a_Reader.Read(m_ROMBanking);
+	a_Reader.Read(m_RAMEnabled);
+	a_Reader.Read(m_ROMBank);
+	a_Reader.Read(m_RAMBank);
 }
\ No newline at end of file
@@ -14,6 +14,15 @@ namespace Amber::Gameboy
 		uint8_t Load8(Address a_Address) const override;
 		void Store8(Address a_Address, uint8_t a_Value) override;
 
+		uint64_t GetPhysicalAddress(Address a_Address) const override;
+		const uint8_t* GetReadPage(Address a_Address) const override;
+		uint8_t* GetWritePage(Address a_Address) override;
+
+		std::unique_ptr<Cartridge> Fork() const override;
+
+		void SaveRecorderState(Common::ByteWriter& a_Writer) const noexcept override;
+		void LoadRecorderState(Common::ByteReader& a_Reader) noexcept override;
+
 		private:
 		bool m_ROMBanking = true;
 		bool m_RAMEnabled = false;
@@ -1,11 +1,15 @@
 #include <gameboy/mbc2cartridge.hpp>
 
 using namespace Amber;
+using namespace Common;
 using namespace Gameboy;
 
 MBC2Cartridge::MBC2Cartridge(size_t a_ROMSize):
 	BasicCartridge(a_ROMSize, 0)
 {
+	m_RecorderMembers.emplace_back("RAMEnabled", RecorderMemberType::uint8);
+	m_RecorderMembers.emplace_back("ROMBank", RecorderMemberType::uint8);
+	m_RecorderMembers.emplace_back("RAM", RecorderMemberType::Raw, sizeof(m_RAM));
 }
 
 uint8_t MBC2Cartridge::Load8(Address a_Address) const
@@ -16,13 +20,13 @@ uint8_t MBC2Cartridge::Load8(Address a_Address) const
 		case 0x1000:
 		case 0x2000:
 		case 0x3000:
-		return m_ROM.Load8(a_Address);
+		return m_ROM->Load8(a_Address);
 
 		case 0x4000:
 		case 0x5000:
 		case 0x6000:
 		case 0x7000:
-		return m_ROM.Load8((a_Address - 0x4000) + m_ROMBank * ROMBankSize);
+		return m_ROM->Load8((a_Address - 0x4000) + m_ROMBank * ROMBankSize);
 
 		case 0xA000:
 		if (m_RAMEnabled && a_Address < 0xA200)
@@ -85,4 +89,68 @@ void MBC2Cartridge::Store8(Address a_Address, uint8_t a_Value)
 		}
 		break;
 	}
+}
+
+uint64_t MBC2Cartridge::GetPhysicalAddress(Address a_Address) const
+{
+	switch (a_Address & 0xF000)
+	{
+		case 0x4000:
+		case 0x5000:
+		case 0x6000:
+		case 0x7000:
+		return (a_Address - 0x4000) + m_ROMBank * uint64_t(ROMBankSize);
+
+		default:
+		return BasicCartridge::GetPhysicalAddress(a_Address);
+	}
+}
+
+const uint8_t* MBC2Cartridge::GetReadPage(Address a_Address) const
+{
+	// The RAM only stores nibbles, so it's never accessed directly
+	switch (a_Address & 0xF000)
+	{
+		case 0x0000:
+		case 0x1000:
+		case 0x2000:
+		case 0x3000:
+		return m_ROM->GetReadPage(a_Address);
+
+		case 0x4000:
+		case 0x5000:
+		case 0x6000:
+		case 0x7000:
+		return m_ROM->GetReadPage((a_Address - 0x4000) + m_ROMBank * ROMBankSize);
+	}
+
+	return nullptr;
+}
+
+uint8_t* MBC2Cartridge::GetWritePage(Address a_Address)
+{
+	return nullptr;
+}
+
+std::unique_ptr<Cartridge> MBC2Cartridge::Fork() const
+{
+	return std::make_unique<MBC2Cartridge>(*this);
+}
+
+void MBC2Cartridge::SaveRecorderState(ByteWriter& a_Writer) const noexcept
+{
+	BasicCartridge::SaveRecorderState(a_Writer);
+
+	a_Writer.Write(m_RAMEnabled);
+	a_Writer.Write(m_ROMBank);
+	a_Writer.Write(m_RAM);
+}
+
+void MBC2Cartridge::LoadRecorderState(ByteReader& a_Reader) noexcept
+{
+	BasicCartridge::LoadRecorderState(a_Reader);
+
+	a_Reader.Read(m_RAMEnabled);
+	a_Reader.Read(m_ROMBank);
+	a_Reader.Read(m_RAM);
 }
\ No newline at end of file
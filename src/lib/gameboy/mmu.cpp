@@ -10,6 +10,24 @@ using namespace Amber;
 using namespace Common;
 using namespace Gameboy;
 
+namespace
+{
+	// The upper half of a physical address identifies the memory it lives in
+	constexpr uint64_t PhysicalBootROM   = uint64_t(1) << 32;
+	constexpr uint64_t PhysicalCartridge = uint64_t(2) << 32;
+	constexpr uint64_t PhysicalVRAM      = uint64_t(3) << 32;
+	constexpr uint64_t PhysicalWRAM      = uint64_t(4) << 32;
+	constexpr uint64_t PhysicalInternal  = uint64_t(5) << 32;
+
+	const RecorderMemberDescription RecorderMembers[] =
+	{
+		{ "HRAM", RecorderMemberType::Raw, 127 },
+		{ "BootROMMapped", RecorderMemberType::uint8 },
+		{ "SB", RecorderMemberType::uint8 },
+		{ "SC", RecorderMemberType::uint8 },
+	};
+}
+
 MMU::MMU()
 {
 	for (uint8_t i = 0; i < 0xF; ++i)
@@ -32,6 +50,11 @@ MMU::MMU()
 		m_LastLoads[i] = &MMU::LoadArray<&MMU::m_HRAM, 0xFF80>;
 		m_LastStores[i] = &MMU::StoreArray<&MMU::m_HRAM, 0xFF80>;
 	}
+
+	m_LastLoads[0x0101] = &MMU::LoadSerialData;
+	m_LastLoads[0x0102] = &MMU::LoadSerialControl;
+	m_LastStores[0x0101] = &MMU::StoreSerialData;
+	m_LastStores[0x0102] = &MMU::StoreSerialControl;
 }
 
 void MMU::SetBootROM(Memory* a_BootROM)
@@ -59,6 +82,13 @@ void MMU::SetBootROM(Memory* a_BootROM)
 
 		m_LastStores[0x0150] = &MMU::StoreNOP;
 	}
+
+	if (m_CPU != nullptr)
+	{
+		m_CPU->InvalidateBlocks();
+	}
+
+	UpdatePages();
 }
 
 void MMU::SetCartridge(Memory* a_Cartridge)
@@ -108,7 +138,7 @@ void MMU::SetVRAM(Memory* a_VRAM)
 		for (uint8_t i = 0x8; i < 0xA; ++i)
 		{
 			m_PageLoads[i] = &MMU::LoadMemory<&MMU::m_VRAM, 0x8000>;
-			m_PageStores[i] = &MMU::StoreMemory<&MMU::m_VRAM, 0x8000>;
+			m_PageStores[i] = &MMU::StoreVideo<&MMU::StoreMemory<&MMU::m_VRAM, 0x8000>>;
 		}
 	}
 	else
@@ -119,11 +149,18 @@ void MMU::SetVRAM(Memory* a_VRAM)
 			m_PageStores[i] = &MMU::StoreNOP;
 		}
 	}
+
+	UpdatePages();
 }
 
 void MMU::SetWRAM(Memory* a_WRAM)
 {
 	m_WRAM = a_WRAM;
+	if (m_CPU != nullptr)
+	{
+		m_CPU->InvalidateBlocks();
+	}
+
 	if (m_WRAM != nullptr)
 	{
 		for (uint8_t i = 0xC; i < 0xE; ++i)
@@ -143,6 +180,8 @@ void MMU::SetWRAM(Memory* a_WRAM)
 			m_PageStores[i] = &MMU::StoreNOP;
 		}
 	}
+
+	UpdatePages();
 }
 
 void MMU::SetCPU(CPU* a_CPU)
@@ -154,14 +193,14 @@ void MMU::SetCPU(CPU* a_CPU)
 		m_LastLoads[0x0105] = &MMU::LoadRegister<&MMU::m_CPU, &CPU::GetTIMA>;
 		m_LastLoads[0x0106] = &MMU::LoadRegister<&MMU::m_CPU, &CPU::GetTMA>;
 		m_LastLoads[0x0107] = &MMU::LoadRegister<&MMU::m_CPU, &CPU::GetTAC>;
-		m_LastLoads[0x010F] = &MMU::LoadRegister<&MMU::m_CPU, &CPU::GetInterruptRequests>;
+		m_LastLoads[0x010F] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_CPU, &CPU::GetInterruptRequests>>;
 		m_LastLoads[0x01FF] = &MMU::LoadRegister<&MMU::m_CPU, &CPU::GetInterruptEnable>;
 		
 		m_LastStores[0x0104] = &MMU::StoreRegister<&MMU::m_CPU, &CPU::SetDIV>;
 		m_LastStores[0x0105] = &MMU::StoreRegister<&MMU::m_CPU, &CPU::SetTIMA>;
 		m_LastStores[0x0106] = &MMU::StoreRegister<&MMU::m_CPU, &CPU::SetTMA>;
 		m_LastStores[0x0107] = &MMU::StoreRegister<&MMU::m_CPU, &CPU::SetTAC>;
-		m_LastStores[0x010F] = &MMU::StoreRegister<&MMU::m_CPU, &CPU::SetInterruptRequests>;
+		m_LastStores[0x010F] = &MMU::StoreSynchronized<&MMU::StoreRegister<&MMU::m_CPU, &CPU::SetInterruptRequests>>;
 		m_LastStores[0x0146] = &MMU::StoreRegister<&MMU::m_CPU, &CPU::StartDMA>;
 		m_LastStores[0x01FF] = &MMU::StoreRegister<&MMU::m_CPU, &CPU::SetInterruptEnable>;
 	}
@@ -189,30 +228,30 @@ void MMU::SetPPU(PPU* a_PPU)
 	m_PPU = a_PPU;
 	if (m_PPU != nullptr)
 	{
-		m_LastLoads[0x0140] = &MMU::LoadRegister<&MMU::m_PPU, &PPU::GetLCDC>;
-		m_LastLoads[0x0141] = &MMU::LoadRegister<&MMU::m_PPU, &PPU::GetSTAT>;
-		m_LastLoads[0x0142] = &MMU::LoadRegister<&MMU::m_PPU, &PPU::GetSCY>;
-		m_LastLoads[0x0143] = &MMU::LoadRegister<&MMU::m_PPU, &PPU::GetSCX>;
-		m_LastLoads[0x0144] = &MMU::LoadRegister<&MMU::m_PPU, &PPU::GetLY>;
-		m_LastLoads[0x0145] = &MMU::LoadRegister<&MMU::m_PPU, &PPU::GetLYC>;
-		m_LastLoads[0x0147] = &MMU::LoadRegister<&MMU::m_PPU, &PPU::GetBGP>;
-		m_LastLoads[0x0148] = &MMU::LoadRegister<&MMU::m_PPU, &PPU::GetOBP0>;
-		m_LastLoads[0x0149] = &MMU::LoadRegister<&MMU::m_PPU, &PPU::GetOBP1>;
+		m_LastLoads[0x0140] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_PPU, &PPU::GetLCDC>>;
+		m_LastLoads[0x0141] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_PPU, &PPU::GetSTAT>>;
+		m_LastLoads[0x0142] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_PPU, &PPU::GetSCY>>;
+		m_LastLoads[0x0143] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_PPU, &PPU::GetSCX>>;
+		m_LastLoads[0x0144] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_PPU, &PPU::GetLY>>;
+		m_LastLoads[0x0145] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_PPU, &PPU::GetLYC>>;
+		m_LastLoads[0x0147] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_PPU, &PPU::GetBGP>>;
+		m_LastLoads[0x0148] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_PPU, &PPU::GetOBP0>>;
+		m_LastLoads[0x0149] = &MMU::LoadSynchronized<&MMU::LoadRegister<&MMU::m_PPU, &PPU::GetOBP1>>;
 		
-		m_LastStores[0x0140] = &MMU::StoreRegister<&MMU::m_PPU, &PPU::SetLCDC>;
-		m_LastStores[0x0141] = &MMU::StoreRegister<&MMU::m_PPU, &PPU::SetSTAT>;
-		m_LastStores[0x0142] = &MMU::StoreRegister<&MMU::m_PPU, &PPU::SetSCY>;
-		m_LastStores[0x0143] = &MMU::StoreRegister<&MMU::m_PPU, &PPU::SetSCX>;
-		m_LastStores[0x0145] = &MMU::StoreRegister<&MMU::m_PPU, &PPU::SetLYC>;
-		m_LastStores[0x0147] = &MMU::StoreRegister<&MMU::m_PPU, &PPU::SetBGP>;
-		m_LastStores[0x0148] = &MMU::StoreRegister<&MMU::m_PPU, &PPU::SetOBP0>;
-		m_LastStores[0x0149] = &MMU::StoreRegister<&MMU::m_PPU, &PPU::SetOBP1>;
+		m_LastStores[0x0140] = &MMU::StoreSynchronized<&MMU::StoreRegister<&MMU::m_PPU, &PPU::SetLCDC>>;
+		m_LastStores[0x0141] = &MMU::StoreSynchronized<&MMU::StoreRegister<&MMU::m_PPU, &PPU::SetSTAT>>;
+		m_LastStores[0x0142] = &MMU::StoreSynchronized<&MMU::StoreRegister<&MMU::m_PPU, &PPU::SetSCY>>;
+		m_LastStores[0x0143] = &MMU::StoreSynchronized<&MMU::StoreRegister<&MMU::m_PPU, &PPU::SetSCX>>;
+		m_LastStores[0x0145] = &MMU::StoreSynchronized<&MMU::StoreRegister<&MMU::m_PPU, &PPU::SetLYC>>;
+		m_LastStores[0x0147] = &MMU::StoreSynchronized<&MMU::StoreRegister<&MMU::m_PPU, &PPU::SetBGP>>;
+		m_LastStores[0x0148] = &MMU::StoreSynchronized<&MMU::StoreRegister<&MMU::m_PPU, &PPU::SetOBP0>>;
+		m_LastStores[0x0149] = &MMU::StoreSynchronized<&MMU::StoreRegister<&MMU::m_PPU, &PPU::SetOBP1>>;
 
 		m_OAM = m_PPU->GetOAM();
 		for (size_t i = 0; i < 160; ++i)
 		{
 			m_LastLoads[i] = &MMU::LoadArray<&MMU::m_OAM, 0xFE00>;
-			m_LastStores[i] = &MMU::StoreArray<&MMU::m_OAM, 0xFE00>;
+			m_LastStores[i] = &MMU::StoreVideo<&MMU::StoreArray<&MMU::m_OAM, 0xFE00>>;
 		}
 	}
 	else
@@ -260,21 +299,196 @@ void MMU::SetJoypad(Joypad* a_Joypad)
 	}
 }
 
-uint8_t MMU::Load8(Address a_Address) const
+Memory16* MMU::GetBootROM() const noexcept
 {
-	const uint16_t page = a_Address >> 12;
-	return (this->*(m_PageLoads[page]))(a_Address);
+	return m_BootROM;
+}
+
+Memory16* MMU::GetCartridge() const noexcept
+{
+	return m_Cartridge;
+}
+
+Memory16* MMU::GetVRAM() const noexcept
+{
+	return m_VRAM;
+}
+
+Memory16* MMU::GetWRAM() const noexcept
+{
+	return m_WRAM;
+}
+
+uint8_t MMU::LoadUnmapped(uint16_t a_Address) const
+{
+	// HRAM shares its page with I/O, but it's accessed about as often as the rest of RAM
+	if (a_Address >= 0xFF80 && a_Address != 0xFFFF)
+	{
+		return m_HRAM[a_Address - 0xFF80];
+	}
+
+	return (this->*(m_PageLoads[a_Address >> 12]))(a_Address);
 }
 
 void MMU::Store8(Address a_Address, uint8_t a_Value)
 {
 	const uint16_t page = a_Address >> 12;
-	(this->*(m_PageStores[page]))(a_Address, a_Value);
+	if (uint8_t* const data = m_WritePages[page])
+	{
+		data[a_Address & 0xFFF] = a_Value;
+	}
+	else if (a_Address >= 0xFF80 && a_Address != 0xFFFF)
+	{
+		m_HRAM[a_Address - 0xFF80] = a_Value;
+	}
+	else
+	{
+		(this->*(m_PageStores[page]))(a_Address, a_Value);
+		UpdateStoredPages(a_Address);
+	}
+
+	if (m_CPU != nullptr)
+	{
+		m_CPU->InvalidateBlocks(a_Address);
+	}
+}
+
+void MMU::Store16(Address a_Address, uint16_t a_Value)
+{
+	const uint16_t offset = a_Address & 0xFFF;
+	uint8_t* const data = m_WritePages[a_Address >> 12];
+	if (data == nullptr || offset == 0xFFF)
+	{
+		Store8(a_Address, a_Value & 0xFF);
+		Store8(a_Address + 1, a_Value >> 8);
+		return;
+	}
+
+	data[offset] = a_Value & 0xFF;
+	data[offset + 1] = a_Value >> 8;
+
+	if (m_CPU != nullptr)
+	{
+		m_CPU->InvalidateBlocks(a_Address);
+		m_CPU->InvalidateBlocks(a_Address + 1);
+	}
+}
+
+uint64_t MMU::GetPhysicalAddress(Address a_Address) const
+{
+	switch (a_Address >> 12)
+	{
+		case 0x0:
+		if (m_PageLoads[0x0] == &MMU::LoadBoot && a_Address <= 0xFF)
+		{
+			return PhysicalBootROM | a_Address;
+		}
+		[[fallthrough]];
+
+		case 0x1:
+		case 0x2:
+		case 0x3:
+		case 0x4:
+		case 0x5:
+		case 0x6:
+		case 0x7:
+		case 0xA:
+		case 0xB:
+		if (m_Cartridge != nullptr)
+		{
+			return PhysicalCartridge | m_Cartridge->GetPhysicalAddress(a_Address);
+		}
+		break;
+
+		case 0x8:
+		case 0x9:
+		return PhysicalVRAM | (a_Address - 0x8000);
+
+		case 0xC:
+		case 0xD:
+		return PhysicalWRAM | (a_Address - 0xC000);
+
+		case 0xE:
+		return PhysicalWRAM | (a_Address - 0xE000);
+
+		case 0xF:
+		if (a_Address < 0xFE00)
+		{
+			return PhysicalWRAM | (a_Address - 0xE000);
+		}
+		break;
+	}
+
+	return PhysicalInternal | a_Address;
+}
+
+void MMU::UpdatePages()
+{
+	for (uint8_t page = 0; page < 16; ++page)
+	{
+		UpdatePage(page);
+	}
 }
 
 void MMU::Reset()
 {
 	SetBootROM(m_BootROM);
+
+	m_SerialData = 0x00;
+	m_SerialControl = 0x00;
+}
+
+const std::vector<uint8_t>& MMU::GetSerialOutput() const noexcept
+{
+	return m_SerialOutput;
+}
+
+void MMU::ClearSerialOutput() noexcept
+{
+	m_SerialOutput.clear();
+}
+
+size_t MMU::GetRecorderMemberCount() const noexcept
+{
+	return std::size(RecorderMembers);
+}
+
+const RecorderMemberDescription& MMU::GetRecorderMember(size_t a_Index) const noexcept
+{
+	return RecorderMembers[a_Index];
+}
+
+void MMU::SaveRecorderState(ByteWriter& a_Writer) const noexcept
+{
+	const bool boot_rom_mapped = m_PageLoads[0x0] == &MMU::LoadBoot;
+
+	a_Writer.Write(m_HRAM);
+	a_Writer.Write(boot_rom_mapped);
+	a_Writer.Write(m_SerialData);
+	a_Writer.Write(m_SerialControl);
+}
+
+void MMU::LoadRecorderState(ByteReader& a_Reader) noexcept
+{
+	bool boot_rom_mapped = false;
+
+	a_Reader.Read(m_HRAM);
+	a_Reader.Read(boot_rom_mapped);
+	a_Reader.Read(m_SerialData);
+	a_Reader.Read(m_SerialControl);
+
+	// Same as SetBootROM and writing to FF50, minus invalidating the CPU's blocks
+	if (boot_rom_mapped && m_BootROM != nullptr)
+	{
+		m_PageLoads[0x0] = &MMU::LoadBoot;
+		m_PageStores[0x0] = &MMU::StoreBoot;
+	}
+	else
+	{
+		StoreDisableBoot(0xFF50, 0);
+	}
+
+	UpdatePage(0x0);
 }
 
 uint8_t MMU::LoadNOP(uint16_t a_Address) const
@@ -317,6 +531,132 @@ uint8_t MMU::LoadLastPage(uint16_t a_Address) const
 	}
 }
 
+uint8_t MMU::LoadSerialData(uint16_t a_Address) const
+{
+	return m_SerialData;
+}
+
+uint8_t MMU::LoadSerialControl(uint16_t a_Address) const
+{
+	return m_SerialControl | 0b0111'1110;
+}
+
+void MMU::SynchronizePPU() const
+{
+	// Anything the PPU reads or writes while ticking must see every cycle up to now
+	if (m_PPU != nullptr)
+	{
+		m_PPU->Synchronize();
+	}
+}
+
+void MMU::FlushPPULine() const
+{
+	// A deferred line has to be drawn up to now before the memory it reads changes
+	if (m_PPU != nullptr)
+	{
+		m_PPU->Synchronize();
+		m_PPU->FlushLine();
+	}
+}
+
+void MMU::UpdatePage(uint8_t a_Page)
+{
+	Memory* memory = nullptr;
+	uint16_t offset = 0;
+	bool writable = true;
+
+	switch (a_Page)
+	{
+		case 0x0:
+		if (m_PageLoads[0x0] == &MMU::LoadBoot)
+		{
+			break;
+		}
+		[[fallthrough]];
+
+		case 0x1:
+		case 0x2:
+		case 0x3:
+		case 0x4:
+		case 0x5:
+		case 0x6:
+		case 0x7:
+		case 0xA:
+		case 0xB:
+		memory = m_Cartridge;
+		break;
+
+		// Stores have to draw the PPU's deferred line first
+		case 0x8:
+		case 0x9:
+		memory = m_VRAM;
+		offset = 0x8000;
+		writable = false;
+		break;
+
+		case 0xC:
+		case 0xD:
+		memory = m_WRAM;
+		offset = 0xC000;
+		break;
+
+		case 0xE:
+		memory = m_WRAM;
+		offset = 0xE000;
+		break;
+	}
+
+	if (memory != nullptr)
+	{
+		const uint16_t address = static_cast<uint16_t>((a_Page << 12) - offset);
+		m_ReadPages[a_Page] = memory->GetReadPage(address);
+		m_WritePages[a_Page] = writable ? memory->GetWritePage(address) : nullptr;
+	}
+	else
+	{
+		m_ReadPages[a_Page] = nullptr;
+		m_WritePages[a_Page] = nullptr;
+	}
+}
+
+void MMU::UpdateStoredPages(uint16_t a_Address)
+{
+	// A store that didn't go straight to memory may have switched banks, or made the memory copy a shared page
+	switch (a_Address >> 12)
+	{
+		case 0x8:
+		case 0x9:
+		UpdatePage(0x8);
+		UpdatePage(0x9);
+		break;
+
+		case 0xF:
+		if (a_Address >= 0xFE00)
+		{
+			break;
+		}
+		[[fallthrough]];
+
+		case 0xC:
+		case 0xD:
+		case 0xE:
+		UpdatePage(0xC);
+		UpdatePage(0xD);
+		UpdatePage(0xE);
+		break;
+
+		default:
+		for (uint8_t page = 0x0; page < 0x8; ++page)
+		{
+			UpdatePage(page);
+		}
+		UpdatePage(0xA);
+		UpdatePage(0xB);
+		break;
+	}
+}
+
 void MMU::StoreNOP(uint16_t a_Address, uint8_t a_Value)
 {
 }
@@ -349,6 +689,8 @@ void MMU::StoreDisableBoot(uint16_t a_Address, uint8_t a_Value)
 		m_PageLoads[0x0] = &MMU::LoadNOP;
 		m_PageStores[0x0] = &MMU::StoreNOP;
 	}
+
+	UpdatePage(0x0);
 }
 
 void MMU::StoreLastPage(uint16_t a_Address, uint8_t a_Value)
@@ -364,4 +706,28 @@ void MMU::StoreLastPage(uint16_t a_Address, uint8_t a_Value)
 	{
 		(this->*(m_LastStores[a_Address & 0x1FF]))(a_Address, a_Value);
 	}
+}
+
+void MMU::StoreSerialData(uint16_t a_Address, uint8_t a_Value)
+{
+	m_SerialData = a_Value;
+}
+
+void MMU::StoreSerialControl(uint16_t a_Address, uint8_t a_Value)
+{
+	m_SerialControl = a_Value & 0b1000'0001;
+	if (m_SerialControl != 0b1000'0001)
+	{
+		return;
+	}
+
+	// Nothing is connected, so the byte shifted back in is all ones
+	m_SerialOutput.push_back(m_SerialData);
+	m_SerialData = 0xFF;
+	m_SerialControl &= 0b0111'1111;
+
+	if (m_CPU != nullptr)
+	{
+		m_CPU->RequestInterrupts(CPU::InterruptSerial);
+	}
 }
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <gameboy/api.hpp>
 
 #include <common/memory.hpp>
+#include <common/recordable.hpp>
+
+#include <vector>
 
 namespace Amber::Gameboy
 {
@@ -11,7 +14,7 @@ namespace Amber::Gameboy
 	class Joypad;
 	class PPU;
 
-	class GAMEBOY_API MMU : public Common::MemoryHelper<uint16_t, false>
+	class GAMEBOY_API MMU final : public Common::MemoryHelper<uint16_t, false>, public Common::Recordable
 	{
 		public:
 		MMU();
@@ -24,18 +27,68 @@ namespace Amber::Gameboy
 		void SetPPU(PPU* a_PPU);
 		void SetJoypad(Joypad* a_Joypad);
 
-		uint8_t Load8(Address a_Address) const override;
+		Memory* GetBootROM() const noexcept;
+		Memory* GetCartridge() const noexcept;
+		Memory* GetVRAM() const noexcept;
+		Memory* GetWRAM() const noexcept;
+
+		// The MMU is final and its loads are inline, so callers holding it by its own type skip the virtual calls.
+		// A 16-bit access within a directly mapped page compiles to a single load.
+		uint8_t Load8(Address a_Address) const override
+		{
+			if (const uint8_t* const data = m_ReadPages[a_Address >> 12])
+			{
+				return data[a_Address & 0xFFF];
+			}
+
+			return LoadUnmapped(a_Address);
+		}
+
+		uint16_t Load16(Address a_Address) const override
+		{
+			const uint16_t offset = a_Address & 0xFFF;
+			const uint8_t* const data = m_ReadPages[a_Address >> 12];
+			if (data != nullptr && offset != 0xFFF)
+			{
+				return data[offset] | (data[offset + 1] << 8);
+			}
+
+			return Load8(a_Address) | (Load8(a_Address + 1) << 8);
+		}
+
 		void Store8(Address a_Address, uint8_t a_Value) override;
+		void Store16(Address a_Address, uint16_t a_Value) override;
+
+		uint64_t GetPhysicalAddress(Address a_Address) const override;
 
 		void Reset();
 
+		// Loads and stores to plain RAM and ROM go straight to the host memory behind the page, everything else goes
+		// through the page's handlers. The MMU keeps its pointers up to date as long as the memories are only changed
+		// through it, call UpdatePages after copying or loading them from outside.
+		void UpdatePages();
+
+		// Serial: there's never a link partner, so transfers on the internal clock complete right away and every
+		// byte sent is appended to the serial output (which isn't part of the recorded state)
+		const std::vector<uint8_t>& GetSerialOutput() const noexcept;
+		void ClearSerialOutput() noexcept;
+
+		// Recording: only the MMU's own state, the memories attached to it are recorded separately
+		size_t GetRecorderMemberCount() const noexcept override;
+		const Common::RecorderMemberDescription& GetRecorderMember(size_t a_Index) const noexcept override;
+		void SaveRecorderState(Common::ByteWriter& a_Writer) const noexcept override;
+		void LoadRecorderState(Common::ByteReader& a_Reader) noexcept override;
+
 		private:
 		using LoadOp = uint8_t(MMU::*)(uint16_t a_Address) const;
 		using StoreOp = void (MMU::*)(uint16_t a_Address, uint8_t a_Value);
 
+		uint8_t LoadUnmapped(uint16_t a_Address) const;
 		uint8_t LoadNOP(uint16_t a_Address) const;
 		uint8_t LoadBoot(uint16_t a_Address) const;
 		uint8_t LoadLastPage(uint16_t a_Address) const;
+		uint8_t LoadSerialData(uint16_t a_Address) const;
+		uint8_t LoadSerialControl(uint16_t a_Address) const;
 		template <auto Member, uint16_t a_Offset>
 		uint8_t LoadMemory(uint16_t a_Address) const
 		{
@@ -51,11 +104,19 @@ namespace Amber::Gameboy
 		{
 			return ((this->*Member)->*Op)();
 		}
+		template <auto Op>
+		uint8_t LoadSynchronized(uint16_t a_Address) const
+		{
+			SynchronizePPU();
+			return (this->*Op)(a_Address);
+		}
 
 		void StoreNOP(uint16_t a_Address, uint8_t a_Value);
 		void StoreBoot(uint16_t a_Address, uint8_t a_Value);
 		void StoreDisableBoot(uint16_t a_Address, uint8_t a_Value);
 		void StoreLastPage(uint16_t a_Address, uint8_t a_Value);
+		void StoreSerialData(uint16_t a_Address, uint8_t a_Value);
+		void StoreSerialControl(uint16_t a_Address, uint8_t a_Value);
 		template <auto Member, uint16_t a_Offset>
 		void StoreMemory(uint16_t a_Address, uint8_t a_Value)
 		{
@@ -71,7 +132,27 @@ namespace Amber::Gameboy
 		{
 			((this->*Member)->*Op)(a_Value);
 		}
+		template <auto Op>
+		void StoreSynchronized(uint16_t a_Address, uint8_t a_Value)
+		{
+			SynchronizePPU();
+			(this->*Op)(a_Address, a_Value);
+		}
+		template <auto Op>
+		void StoreVideo(uint16_t a_Address, uint8_t a_Value)
+		{
+			FlushPPULine();
+			(this->*Op)(a_Address, a_Value);
+		}
+
+		void SynchronizePPU() const;
+		void FlushPPULine() const;
+
+		void UpdatePage(uint8_t a_Page);
+		void UpdateStoredPages(uint16_t a_Address);
 
+		const uint8_t* m_ReadPages[16] = {};
+		uint8_t* m_WritePages[16] = {};
 		LoadOp m_PageLoads[16];
 		StoreOp m_PageStores[16];
 		LoadOp m_LastLoads[512];
@@ -86,6 +167,9 @@ namespace Amber::Gameboy
 		uint8_t* m_OAM = nullptr;
 		Joypad* m_Joypad = nullptr;
 		uint8_t m_HRAM[127] = {};
+		uint8_t m_SerialData = 0x00;
+		uint8_t m_SerialControl = 0x00;
+		std::vector<uint8_t> m_SerialOutput;
 	};
 }
 
@@ -1,38 +1,11 @@
 #include <gameboy/pixelfifo.hpp>
 
-#include <array>
+#include <gameboy/tiledecoder.hpp>
 
 using namespace Amber;
+using namespace Common;
 using namespace Gameboy;
 
-namespace
-{
-	constexpr std::array<uint8_t, 256> g_ReverseTable = []() constexpr
-	{
-		std::array<uint8_t, 256> bytes{};
-		for (size_t i = 0; i < 256; ++i)
-		{
-			const uint8_t from = static_cast<uint8_t>(i);
-			uint8_t to = 0;
-
-			for (size_t bit = 0; bit < 8; ++bit)
-			{
-				to <<= 1;
-				const uint8_t mask = static_cast<uint8_t>(1 << bit);
-
-				if (from & mask)
-				{
-					to |= 1;
-				}
-			}
-
-			bytes[i] = to;
-		}
-
-		return bytes;
-	}();
-}
-
 size_t PixelFIFO::GetPixelCount() const noexcept
 {
 	return m_PixelCount;
@@ -56,15 +29,11 @@ void PixelFIFO::Push(Pixel a_Pixel) noexcept
 
 void PixelFIFO::Push(const uint8_t a_Colors[2], PixelSource::Enum a_Source) noexcept
 {
-	for (uint8_t i = 0; i < 8; ++i)
-	{
-		const uint8_t bit0 = (a_Colors[0] >> (7 - i)) & 0b1;
-		const uint8_t bit1 = (a_Colors[1] >> (7 - i)) & 0b1;
-		const uint8_t color = bit0 | (bit1 << 1);
+	// Every nibble gets the source on top of its color, see Pixel
+	const uint32_t pixels = TileDecoder::DecodeRowNibbles(a_Colors[0], a_Colors[1]) | (((a_Source & 0b11) << 2) * 0x1111'1111u);
 
-		Pixel pixel(color, a_Source);
-		Push(pixel);
-	}
+	m_PixelData |= static_cast<uint64_t>(pixels) << (m_PixelCount * 4);
+	m_PixelCount += 8;
 }
 
 Pixel PixelFIFO::GetPixel(size_t a_Index) const noexcept
@@ -101,13 +70,9 @@ void PixelFIFO::SetPaused(bool a_Paused) noexcept
 
 void PixelFIFO::MixSprite(const uint8_t a_Colors[2], uint8_t a_Attributes) noexcept
 {
-	uint8_t colors[2];
-	std::memcpy(colors, a_Colors, 2);
-	if (a_Attributes & XFlipAttributeMask)
-	{
-		colors[0] = g_ReverseTable[colors[0]];
-		colors[1] = g_ReverseTable[colors[1]];
-	}
+	uint8_t colors[8];
+	TileDecoder::DecodeRow(a_Colors[0], a_Colors[1], colors);
+	const bool flip_x = (a_Attributes & XFlipAttributeMask) != 0;
 
 	const PixelSource::Enum source = (a_Attributes & PaletteAttributeMask) ? PixelSource::Sprite1 : PixelSource::Sprite0;
 
@@ -128,9 +93,7 @@ void PixelFIFO::MixSprite(const uint8_t a_Colors[2], uint8_t a_Attributes) noexc
 			}
 		}
 
-		const uint8_t bit0 = (colors[0] >> (7 - i)) & 0b1;
-		const uint8_t bit1 = (colors[1] >> (7 - i)) & 0b1;
-		const uint8_t color = bit0 | (bit1 << 1);
+		const uint8_t color = colors[flip_x ? 7 - i : i];
 		if (color == 0)
 		{
 			continue;
@@ -145,4 +108,21 @@ void PixelFIFO::Reset(size_t a_PixelCount)
 {
 	m_PixelData = 0;
 	m_PixelCount = a_PixelCount;
+}
+
+void PixelFIFO::SaveRecorderState(ByteWriter& a_Writer) const noexcept
+{
+	a_Writer.Write(m_PixelData);
+	a_Writer.Write(static_cast<uint64_t>(m_PixelCount));
+	a_Writer.Write(m_Paused);
+}
+
+void PixelFIFO::LoadRecorderState(ByteReader& a_Reader) noexcept
+{
+	uint64_t pixel_count = 0;
+	a_Reader.Read(m_PixelData);
+	a_Reader.Read(pixel_count);
+	a_Reader.Read(m_Paused);
+
+	m_PixelCount = static_cast<size_t>(pixel_count);
 }
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <gameboy/api.hpp>
 #include <gameboy/pixel.hpp>
 
+#include <common/bytereader.hpp>
+#include <common/bytewriter.hpp>
+
 namespace Amber::Gameboy
 {
 	class GAMEBOY_API PixelFIFO
@@ -33,6 +36,12 @@ namespace Amber::Gameboy
 
 		void Reset(size_t a_PixelCount);
 
+		// Recorded as part of the PPU's state
+		static constexpr size_t RecorderStateSize = 17;
+
+		void SaveRecorderState(Common::ByteWriter& a_Writer) const noexcept;
+		void LoadRecorderState(Common::ByteReader& a_Reader) noexcept;
+
 		private:
 		uint64_t m_PixelData = 0;
 		size_t m_PixelCount = 0;
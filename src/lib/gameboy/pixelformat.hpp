@@ -0,0 +1,35 @@
+#ifndef H_AMBER_GAMEBOY_PIXELFORMAT
+#define H_AMBER_GAMEBOY_PIXELFORMAT
+
+#include <gameboy/api.hpp>
+
+namespace Amber::Gameboy
+{
+	namespace PixelFormat
+	{
+		enum Enum : uint8_t
+		{
+			RGBA8888, // Bytes in R, G, B, A order
+			BGRA8888, // Bytes in B, G, R, A order
+			RGB565,   // Native endian 16-bit words, red in the high bits
+			Indexed8, // One byte per pixel holding the shade index, 0 (lightest) to 3 (darkest)
+		};
+
+		constexpr size_t GetBytesPerPixel(PixelFormat::Enum a_Value)
+		{
+			switch (a_Value)
+			{
+				case RGB565:
+				return 2;
+
+				case Indexed8:
+				return 1;
+
+				default:
+				return 4;
+			}
+		}
+	}
+}
+
+#endif
\ No newline at end of file
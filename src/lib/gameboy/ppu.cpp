@@ -3,12 +3,151 @@
 #include <gameboy/cpu.hpp>
 #include <gameboy/mmu.hpp>
 #include <gameboy/ppuobserver.hpp>
+#include <gameboy/tiledecoder.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 
 using namespace Amber;
+using namespace Common;
 using namespace Gameboy;
 
+namespace
+{
+	const RecorderMemberDescription RecorderMembers[] =
+	{
+		{ "OAM", RecorderMemberType::Raw, 160 },
+		{ "Sprites", RecorderMemberType::Raw, 10 * 4 },
+		{ "SpriteCount", RecorderMemberType::uint8 },
+		{ "SpriteY", RecorderMemberType::uint8 },
+		{ "NextSprite", RecorderMemberType::uint8 },
+		{ "SpriteAttributes", RecorderMemberType::uint8 },
+		{ "HCounter", RecorderMemberType::uint16 },
+		{ "VCounter", RecorderMemberType::uint16 },
+		{ "LCDC", RecorderMemberType::uint8 },
+		{ "STAT", RecorderMemberType::uint8 },
+		{ "SCX", RecorderMemberType::uint8 },
+		{ "SCY", RecorderMemberType::uint8 },
+		{ "LYC", RecorderMemberType::uint8 },
+		{ "BGP", RecorderMemberType::uint8 },
+		{ "OBP0", RecorderMemberType::uint8 },
+		{ "OBP1", RecorderMemberType::uint8 },
+		{ "PixelFIFO", RecorderMemberType::Raw, PixelFIFO::RecorderStateSize },
+		{ "TileFetcher", RecorderMemberType::Raw, TileFetcher::RecorderStateSize },
+		{ "IsFetchingSprite", RecorderMemberType::uint8 },
+		{ "DrawX", RecorderMemberType::uint8 },
+		{ "LineDeferred", RecorderMemberType::uint8 },
+		{ "LineDrawn", RecorderMemberType::uint8 },
+		{ "LineEnd", RecorderMemberType::uint16 },
+		{ "LCD", RecorderMemberType::Raw, PPU::FrameBufferSize },
+		{ "LCDBackBuffer", RecorderMemberType::Raw, PPU::FrameBufferSize },
+	};
+
+	// Line layouts seen by the scanline renderer are remembered up to this many, then forgotten all at once
+	constexpr size_t MaxLineTimings = 4096;
+
+	// Blitting
+	constexpr uint8_t Shades[] = { 0xFF, 0xCC, 0x77, 0x00 };
+	constexpr size_t PackedLineSize = PPU::LCDWidth / 4;
+
+	// Every packed LCD byte expanded to its four output pixels
+	template <typename T>
+	struct BlitTable
+	{
+		T m_Pixels[256][4];
+	};
+
+	template <typename T, typename Convert>
+	BlitTable<T> MakeBlitTable(Convert a_Convert)
+	{
+		BlitTable<T> table;
+		for (size_t byte = 0; byte < 256; ++byte)
+		{
+			for (size_t pixel = 0; pixel < 4; ++pixel)
+			{
+				table.m_Pixels[byte][pixel] = a_Convert(static_cast<uint8_t>((byte >> ((3 - pixel) * 2)) & 0b11));
+			}
+		}
+
+		return table;
+	}
+
+	// A whole group of four pixels is scaled horizontally before it is stored, then the first row of every scaled
+	// line is copied down. The fixed scale lets the compiler turn the inner loops into plain vector stores.
+	template <size_t Scale, typename T>
+	void BlitScaled(const uint8_t* a_LCD, uint8_t* a_Destination, size_t a_Pitch, const BlitTable<T>& a_Table) noexcept
+	{
+		for (size_t y = 0; y < PPU::LCDHeight; ++y)
+		{
+			const uint8_t* const packed = a_LCD + y * PackedLineSize;
+			uint8_t* const row = a_Destination + y * Scale * a_Pitch;
+
+			for (size_t x = 0; x < PackedLineSize; ++x)
+			{
+				const T* const pixels = a_Table.m_Pixels[packed[x]];
+
+				T scaled[4 * Scale];
+				for (size_t pixel = 0; pixel < 4; ++pixel)
+				{
+					for (size_t i = 0; i < Scale; ++i)
+					{
+						scaled[pixel * Scale + i] = pixels[pixel];
+					}
+				}
+
+				std::memcpy(row + x * sizeof(scaled), scaled, sizeof(scaled));
+			}
+
+			for (size_t i = 1; i < Scale; ++i)
+			{
+				std::memcpy(row + i * a_Pitch, row, PPU::LCDWidth * Scale * sizeof(T));
+			}
+		}
+	}
+
+	template <typename T>
+	void BlitScaled(const uint8_t* a_LCD, uint8_t* a_Destination, size_t a_Pitch, size_t a_Scale, const BlitTable<T>& a_Table) noexcept
+	{
+		switch (a_Scale)
+		{
+			case 0:
+			break;
+
+			case 1:
+			BlitScaled<1>(a_LCD, a_Destination, a_Pitch, a_Table);
+			break;
+
+			case 2:
+			BlitScaled<2>(a_LCD, a_Destination, a_Pitch, a_Table);
+			break;
+
+			case 3:
+			BlitScaled<3>(a_LCD, a_Destination, a_Pitch, a_Table);
+			break;
+
+			case 4:
+			BlitScaled<4>(a_LCD, a_Destination, a_Pitch, a_Table);
+			break;
+
+			default:
+			for (size_t y = 0; y < PPU::LCDHeight * a_Scale; ++y)
+			{
+				const uint8_t* const packed = a_LCD + (y / a_Scale) * PackedLineSize;
+				uint8_t* const row = a_Destination + y * a_Pitch;
+
+				for (size_t x = 0; x < PPU::LCDWidth * a_Scale; ++x)
+				{
+					const size_t lcd_x = x / a_Scale;
+					const T pixel = a_Table.m_Pixels[packed[lcd_x / 4]][lcd_x % 4];
+					std::memcpy(row + x * sizeof(T), &pixel, sizeof(T));
+				}
+			}
+			break;
+		}
+	}
+}
+
 PPU::PPU(MMU& a_MMU):
 	m_MMU(a_MMU),
 	m_TileFetcher(a_MMU)
@@ -83,21 +222,25 @@ void PPU::SetCPU(CPU* a_CPU) noexcept
 
 void PPU::SetLCDC(uint8_t a_Value) noexcept
 {
+	FlushLine();
 	m_LCDC = a_Value;
 }
 
 void PPU::SetSTAT(uint8_t a_Value) noexcept
 {
 	m_STAT = (m_STAT & 0b0000'0111) | (a_Value & 0b1111'1000);
+	UpdateDeadline();
 }
 
 void PPU::SetSCX(uint8_t a_Value) noexcept
 {
+	FlushLine();
 	m_SCX = a_Value;
 }
 
 void PPU::SetSCY(uint8_t a_Value) noexcept
 {
+	FlushLine();
 	m_SCY = a_Value;
 }
 
@@ -108,16 +251,19 @@ void PPU::SetLYC(uint8_t a_Value) noexcept
 
 void PPU::SetBGP(uint8_t a_Value) noexcept
 {
+	FlushLine();
 	m_BGP = a_Value;
 }
 
 void PPU::SetOBP0(uint8_t a_Value) noexcept
 {
+	FlushLine();
 	m_OBP0 = a_Value;
 }
 
 void PPU::SetOBP1(uint8_t a_Value) noexcept
 {
+	FlushLine();
 	m_OBP1 = a_Value;
 }
 
@@ -167,7 +313,7 @@ void PPU::Tick()
 		break;
 
 		case LCDMode::PixelTransfer:
-		if (m_DrawX == LCDWidth + 16)
+		if (m_LineDeferred ? m_HCounter == m_LineEnd : m_DrawX == LCDWidth + 16)
 		{
 			GotoHBlank();
 		}
@@ -175,6 +321,11 @@ void PPU::Tick()
 	}
 
 	// Process LCD Mode
+	if (m_LineDeferred)
+	{
+		return;
+	}
+
 	switch (GetLCDMode())
 	{
 		case LCDMode::OAMSearch:
@@ -197,31 +348,187 @@ void PPU::Reset()
 	m_VCounter = FrameLines - 1;
 	SetLCDMode(LCDMode::VBlank);
 
+	// Deferred ticking
+	m_PendingCycles = 0;
+
+	// Scanline rendering
+	m_LineDeferred = false;
+	m_LineDrawn = false;
+
 	// LCD control
 	m_LCDC = 0x91;
 	m_STAT = 0x00;
 	m_SCX = 0x00;
 	m_SCY = 0x00;
 	m_LYC = 0x00;
+
+	UpdateDeadline();
+}
+
+void PPU::Advance(size_t a_Cycles)
+{
+	// Only catch up once the next cycle that could request an interrupt is due
+	m_PendingCycles += a_Cycles;
+	if (m_PendingCycles >= m_Deadline)
+	{
+		Synchronize();
+	}
+}
+
+void PPU::Synchronize()
+{
+	while (m_PendingCycles != 0)
+	{
+		// HBlank, VBlank and deferred modes do nothing until they end, so skip straight to it
+		size_t mode_end = 0;
+		switch (GetLCDMode())
+		{
+			case LCDMode::HBlank:
+			case LCDMode::VBlank:
+			mode_end = LineCycles;
+			break;
+
+			case LCDMode::OAMSearch:
+			mode_end = m_LineDeferred ? OAMCycles : 0;
+			break;
+
+			case LCDMode::PixelTransfer:
+			mode_end = m_LineDeferred ? m_LineEnd : 0;
+			break;
+		}
+
+		if (m_HCounter + 1u < mode_end)
+		{
+			const size_t cycles = std::min<size_t>(m_PendingCycles, mode_end - 1 - m_HCounter);
+			m_HCounter += static_cast<uint16_t>(cycles);
+			m_PendingCycles -= cycles;
+			continue;
+		}
+
+		--m_PendingCycles;
+		Tick();
+	}
+
+	UpdateDeadline();
+}
+
+size_t PPU::GetPendingCycles() const noexcept
+{
+	return m_PendingCycles;
+}
+
+size_t PPU::GetIdleDots() const noexcept
+{
+	// LY also only changes at the start of a line, so the deadline covers it
+	const size_t deadline = GetDeadline();
+	return deadline > m_PendingCycles ? deadline - m_PendingCycles : 0;
+}
+
+bool PPU::IsScanlineRendererEnabled() const noexcept
+{
+	return m_ScanlineRenderer;
+}
+
+void PPU::SetScanlineRendererEnabled(bool a_Enabled)
+{
+	// Takes effect from the next line on
+	FlushLine();
+	m_ScanlineRenderer = a_Enabled;
+}
+
+void PPU::FlushLine() noexcept
+{
+	if (!m_LineDeferred)
+	{
+		return;
+	}
+
+	m_LineDeferred = false;
+
+	// Replay every dot of the current mode up to and including the current one
+	const uint16_t h_counter = m_HCounter;
+	switch (GetLCDMode())
+	{
+		case LCDMode::OAMSearch:
+		for (m_HCounter = 0; m_HCounter <= h_counter; ++m_HCounter)
+		{
+			OAMSearch();
+		}
+		break;
+
+		case LCDMode::PixelTransfer:
+		// The line may already have been drawn ahead of time, the pixel FIFO has to start from a blank line
+		std::memset(GetBackBuffer() + (static_cast<size_t>(m_VCounter) * LCDWidth) / 4, 0, LCDWidth / 4);
+
+		BeginPixelTransfer();
+		for (m_HCounter = OAMCycles; m_HCounter <= h_counter; ++m_HCounter)
+		{
+			PixelTransfer();
+		}
+		break;
+	}
+	m_HCounter = h_counter;
+
+	UpdateDeadline();
+}
+
+uint64_t PPU::GetFrameSequence() const noexcept
+{
+	return m_FrameSequence.load(std::memory_order_acquire);
+}
+
+const uint8_t* PPU::GetFrameBuffer() const noexcept
+{
+	return m_LCDBuffers[GetFrameSequence() & 1];
 }
 
 void PPU::Blit(void* a_Destination, size_t a_Pitch) const noexcept
 {
-	static constexpr uint8_t colors[] = { 0xFF, 0xCC, 0x77, 0x00 };
+	Blit(a_Destination, a_Pitch, PixelFormat::RGBA8888);
+}
+
+void PPU::Blit(void* a_Destination, size_t a_Pitch, PixelFormat::Enum a_Format, size_t a_Scale) const noexcept
+{
+	uint8_t* const destination = static_cast<uint8_t*>(a_Destination);
+	const size_t pitch = a_Pitch * PixelFormat::GetBytesPerPixel(a_Format);
 
-	for (size_t y = 0; y < LCDHeight; ++y)
+	switch (a_Format)
 	{
-		for (size_t x = 0; x < LCDWidth; ++x)
+		// The shades are gray, so both byte orders come out the same
+		case PixelFormat::RGBA8888:
+		case PixelFormat::BGRA8888:
 		{
-			const uint8_t color = colors[GetPixel(x, y)];
+			static const auto table = MakeBlitTable<uint32_t>([](uint8_t a_Shade)
+			{
+				const uint8_t bytes[4] = { Shades[a_Shade], Shades[a_Shade], Shades[a_Shade], 0xFF };
+				uint32_t color;
+				std::memcpy(&color, bytes, sizeof(color));
+				return color;
+			});
+			BlitScaled(GetFrameBuffer(), destination, pitch, a_Scale, table);
+		}
+		break;
 
-			uint8_t* const pixel = reinterpret_cast<uint8_t*>(a_Destination) + (y * a_Pitch + x) * 4;
+		case PixelFormat::RGB565:
+		{
+			static const auto table = MakeBlitTable<uint16_t>([](uint8_t a_Shade)
+			{
+				const uint16_t shade = Shades[a_Shade];
+				return static_cast<uint16_t>(((shade >> 3) << 11) | ((shade >> 2) << 5) | (shade >> 3));
+			});
+			BlitScaled(GetFrameBuffer(), destination, pitch, a_Scale, table);
+		}
+		break;
 
-			pixel[0] = color;
-			pixel[1] = color;
-			pixel[2] = color;
-			pixel[3] = 0xFF;
+		case PixelFormat::Indexed8:
+		{
+			static const auto table = MakeBlitTable<uint8_t>([](uint8_t a_Shade)
+			{
+				return a_Shade;
+			});
+			BlitScaled(GetFrameBuffer(), destination, pitch, a_Scale, table);
 		}
+		break;
 	}
 }
 
@@ -235,6 +542,103 @@ void PPU::RemoveObserver(PPUObserver& a_Observer)
 	m_Observers.erase(&a_Observer);
 }
 
+size_t PPU::GetRecorderMemberCount() const noexcept
+{
+	return std::size(RecorderMembers);
+}
+
+const RecorderMemberDescription& PPU::GetRecorderMember(size_t a_Index) const noexcept
+{
+	return RecorderMembers[a_Index];
+}
+
+void PPU::SaveRecorderState(ByteWriter& a_Writer) const noexcept
+{
+	static_assert(sizeof(m_Sprites) == 10 * 4);
+
+	// OAM
+	a_Writer.Write(m_OAM);
+	a_Writer.Write(m_Sprites);
+	a_Writer.Write(m_SpriteCount);
+	a_Writer.Write(m_SpriteY);
+	a_Writer.Write(m_NextSprite);
+	a_Writer.Write(m_SpriteAttributes);
+
+	// LCD mode
+	a_Writer.Write(m_HCounter);
+	a_Writer.Write(m_VCounter);
+
+	// LCD control and palettes
+	a_Writer.Write(m_LCDC);
+	a_Writer.Write(m_STAT);
+	a_Writer.Write(m_SCX);
+	a_Writer.Write(m_SCY);
+	a_Writer.Write(m_LYC);
+	a_Writer.Write(m_BGP);
+	a_Writer.Write(m_OBP0);
+	a_Writer.Write(m_OBP1);
+
+	// Drawing
+	m_PixelFIFO.SaveRecorderState(a_Writer);
+	m_TileFetcher.SaveRecorderState(a_Writer);
+	a_Writer.Write(m_IsFetchingSprite);
+	a_Writer.Write(m_DrawX);
+
+	// Scanline rendering
+	a_Writer.Write(m_LineDeferred);
+	a_Writer.Write(m_LineDrawn);
+	a_Writer.Write(m_LineEnd);
+
+	// The presented frame, and the lines of the current one drawn so far
+	a_Writer.Write(GetFrameBuffer(), FrameBufferSize);
+	a_Writer.Write(m_LCDBuffers[(GetFrameSequence() & 1) ^ 1], FrameBufferSize);
+}
+
+void PPU::LoadRecorderState(ByteReader& a_Reader) noexcept
+{
+	// OAM
+	a_Reader.Read(m_OAM);
+	a_Reader.Read(m_Sprites);
+	a_Reader.Read(m_SpriteCount);
+	a_Reader.Read(m_SpriteY);
+	a_Reader.Read(m_NextSprite);
+	a_Reader.Read(m_SpriteAttributes);
+
+	// LCD mode
+	a_Reader.Read(m_HCounter);
+	a_Reader.Read(m_VCounter);
+
+	// LCD control and palettes
+	a_Reader.Read(m_LCDC);
+	a_Reader.Read(m_STAT);
+	a_Reader.Read(m_SCX);
+	a_Reader.Read(m_SCY);
+	a_Reader.Read(m_LYC);
+	a_Reader.Read(m_BGP);
+	a_Reader.Read(m_OBP0);
+	a_Reader.Read(m_OBP1);
+
+	// Drawing
+	m_PixelFIFO.LoadRecorderState(a_Reader);
+	m_TileFetcher.LoadRecorderState(a_Reader);
+	a_Reader.Read(m_IsFetchingSprite);
+	a_Reader.Read(m_DrawX);
+
+	// Scanline rendering
+	a_Reader.Read(m_LineDeferred);
+	a_Reader.Read(m_LineDrawn);
+	a_Reader.Read(m_LineEnd);
+
+	// Present the recorded frame the same way VBlank does, then resume the current one
+	a_Reader.Read(GetBackBuffer(), FrameBufferSize);
+	m_FrameSequence.store(m_FrameSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	a_Reader.Read(GetBackBuffer(), FrameBufferSize);
+
+	// Deferred ticking
+	m_PendingCycles = 0;
+	UpdateDeadline();
+}
+
 void PPU::SetLCDMode(LCDMode::Enum a_Mode)
 {
 	const auto from_mode = GetLCDMode();
@@ -273,10 +677,15 @@ void PPU::SetLCDMode(LCDMode::Enum a_Mode)
 		}
 	}
 
+	// The finished frame is presented when VBlank starts, drawing resumes on the other buffer after it ends
 	const auto to_mode = GetLCDMode();
-	if (from_mode == LCDMode::VBlank && to_mode == LCDMode::OAMSearch)
+	if (to_mode == LCDMode::VBlank)
+	{
+		m_FrameSequence.store(m_FrameSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+	else if (from_mode == LCDMode::VBlank && to_mode == LCDMode::OAMSearch)
 	{
-		std::memset(m_LCDBuffer, 0, sizeof(m_LCDBuffer));
+		std::memset(GetBackBuffer(), 0, sizeof(m_LCDBuffers[0]));
 	}
 
 	for (auto& observer : m_Observers)
@@ -285,6 +694,28 @@ void PPU::SetLCDMode(LCDMode::Enum a_Mode)
 	}
 }
 
+size_t PPU::GetDeadline() const noexcept
+{
+	// Interrupts are only requested at the start of a line, or when entering HBlank with its STAT interrupt enabled
+	const auto mode = GetLCDMode();
+	if ((m_STAT & HBlankInterruptSTATMask) && (mode == LCDMode::OAMSearch || mode == LCDMode::PixelTransfer))
+	{
+		if (!m_LineDeferred)
+		{
+			return 1;
+		}
+
+		return (mode == LCDMode::OAMSearch ? OAMCycles : m_LineEnd) - m_HCounter;
+	}
+
+	return LineCycles - m_HCounter;
+}
+
+void PPU::UpdateDeadline() noexcept
+{
+	m_Deadline = GetDeadline();
+}
+
 void PPU::GotoOAM() noexcept
 {
 	const bool lyc_result = GetLY() == GetLYC();
@@ -296,29 +727,72 @@ void PPU::GotoOAM() noexcept
 	}
 
 	m_SpriteCount = 0;
+	m_LineDeferred = m_ScanlineRenderer;
+	m_LineDrawn = false;
 
 	SetLCDMode(LCDMode::OAMSearch);
 }
 
-void PPU::GotoPixelTransfer() noexcept
+void PPU::GotoPixelTransfer()
 {
-	m_NextSprite = 0;
+	if (!m_LineDeferred)
+	{
+		BeginPixelTransfer();
+		SetLCDMode(LCDMode::PixelTransfer);
+		return;
+	}
 
-	const uint8_t screen_y = static_cast<uint8_t>(m_VCounter);
-	const uint8_t scroll_x = m_SCX;
-	const uint8_t scroll_y = screen_y + m_SCY;
+	// Catch up on the sprite search in one go
+	for (m_HCounter = 0; m_HCounter < OAMCycles; ++m_HCounter)
+	{
+		OAMSearch();
+	}
 
-	m_PixelFIFO.Reset(7);
-	m_PixelFIFO.SetPaused(true);
-	m_TileFetcher.FetchBackgroundTile(scroll_x, scroll_y, m_LCDC);
-	m_IsFetchingSprite = false;
-	m_DrawX = 9 - m_SCX % 8;
+	// The length of pixel transfer only depends on the fine scroll and where the sprites are
+	LineLayout layout = {};
+	layout[0] = m_SCX % 8;
+	for (uint8_t i = 0; i < m_SpriteCount; ++i)
+	{
+		layout[i + 1] = m_Sprites[i].m_DrawX;
+	}
+
+	const auto timing = m_LineTimings.find(layout);
+	if (timing != m_LineTimings.end())
+	{
+		m_LineEnd = timing->second;
+	}
+	else
+	{
+		// Unseen layout, draw this line with the pixel FIFO and remember how long it took
+		BeginPixelTransfer();
+		for (m_HCounter = OAMCycles; m_DrawX != LCDWidth + 16; ++m_HCounter)
+		{
+			PixelTransfer();
+		}
+
+		m_LineEnd = m_HCounter;
+		m_LineDrawn = true;
+
+		if (m_LineTimings.size() >= MaxLineTimings)
+		{
+			m_LineTimings.clear();
+		}
+		m_LineTimings.emplace(layout, m_LineEnd);
+	}
+
+	m_HCounter = OAMCycles;
 
 	SetLCDMode(LCDMode::PixelTransfer);
 }
 
 void PPU::GotoHBlank() noexcept
 {
+	if (m_LineDeferred && !m_LineDrawn)
+	{
+		RenderLine();
+	}
+	m_LineDeferred = false;
+
 	SetLCDMode(LCDMode::HBlank);
 }
 
@@ -392,6 +866,21 @@ void PPU::OAMSearch() noexcept
 	++m_SpriteCount;
 }
 
+void PPU::BeginPixelTransfer() noexcept
+{
+	m_NextSprite = 0;
+
+	const uint8_t screen_y = static_cast<uint8_t>(m_VCounter);
+	const uint8_t scroll_x = m_SCX;
+	const uint8_t scroll_y = screen_y + m_SCY;
+
+	m_PixelFIFO.Reset(7);
+	m_PixelFIFO.SetPaused(true);
+	m_TileFetcher.FetchBackgroundTile(scroll_x, scroll_y, m_LCDC);
+	m_IsFetchingSprite = false;
+	m_DrawX = 9 - m_SCX % 8;
+}
+
 void PPU::PixelTransfer() noexcept
 {
 	// Check if the next sprite needs to be drawn at the current pixel
@@ -500,14 +989,81 @@ void PPU::PixelTransfer() noexcept
 	++m_DrawX;
 }
 
-uint8_t PPU::GetPixel(uint8_t a_X, uint8_t a_Y) const noexcept
+void PPU::RenderLine() noexcept
 {
-	const size_t byte_offset = (static_cast<size_t>(a_X) + static_cast<size_t>(a_Y) * LCDWidth) / 4;
-	const uint8_t bit_offset = (3 - (a_X % 4)) * 2;
+	const uint8_t screen_y = static_cast<uint8_t>(m_VCounter);
+	const uint8_t background_y = screen_y + m_SCY;
+	const uint8_t fine_x = m_SCX % 8;
+	const bool signed_index = (m_LCDC & 0b0001'0000) == 0;
+	const uint16_t tile_base_address = signed_index ? 0x8800 : 0x8000;
+	const uint16_t map_address = 0x9800 + (background_y / 8) * 32;
+
+	// Background color indices, starting at the first (partially) visible tile
+	uint8_t background[LCDWidth + 8];
+	for (size_t tile = 0; tile < LCDWidth / 8 + 1; ++tile)
+	{
+		const uint8_t background_x = static_cast<uint8_t>(m_SCX + tile * 8);
+		const uint8_t tile_index = m_MMU.Load8(map_address + background_x / 8) + (signed_index ? 128 : 0);
+		const uint16_t tile_address = tile_base_address + tile_index * 16 + (background_y % 8) * 2;
+
+		// Both bytes of a row in one load, the low byte holds the low bits of each pixel
+		const uint16_t row = m_MMU.Load16(tile_address);
+		TileDecoder::DecodeRow(row & 0xFF, row >> 8, background + tile * 8);
+	}
+
+	uint8_t colors[LCDWidth];
+	for (size_t x = 0; x < LCDWidth; ++x)
+	{
+		colors[x] = (m_BGP >> (background[x + fine_x] * 2)) & 0b11;
+	}
+
+	// Sprites in fetch order, the first sprite to cover a pixel keeps it
+	bool covered[LCDWidth] = {};
+	for (uint8_t i = 0; i < m_SpriteCount; ++i)
+	{
+		const auto& sprite = m_Sprites[i];
+
+		const uint8_t tile_index = m_MMU.Load8(0xFE00 + sprite.m_SpriteIndex * 4 + 2);
+		const uint16_t tile_address = 0x8000 + tile_index * 16 + sprite.m_TileY * 2;
+
+		uint8_t sprite_colors[8];
+		const uint16_t row = m_MMU.Load16(tile_address);
+		TileDecoder::DecodeRow(row & 0xFF, row >> 8, sprite_colors);
 
-	const uint8_t pixel_mask = (0b11 << bit_offset);
+		const bool flip_x = (sprite.m_Attributes & PixelFIFO::XFlipAttributeMask) != 0;
+		const bool behind = (sprite.m_Attributes & PixelFIFO::PriorityAttributeMask) != 0;
+		const uint8_t palette = (sprite.m_Attributes & PixelFIFO::PaletteAttributeMask) ? m_OBP1 : m_OBP0;
 
-	return (m_LCDBuffer[byte_offset] & pixel_mask) >> bit_offset;
+		for (uint8_t pixel = 0; pixel < 8; ++pixel)
+		{
+			const int screen_x = sprite.m_DrawX - 16 + pixel;
+			if (screen_x < 0 || screen_x >= static_cast<int>(LCDWidth) || covered[screen_x])
+			{
+				continue;
+			}
+
+			const uint8_t color = sprite_colors[flip_x ? 7 - pixel : pixel];
+			if (color == 0 || (behind && background[screen_x + fine_x] != 0))
+			{
+				continue;
+			}
+
+			colors[screen_x] = (palette >> (color * 2)) & 0b11;
+			covered[screen_x] = true;
+		}
+	}
+
+	// Pack four pixels per byte, leftmost pixel in the high bits
+	uint8_t* const line = GetBackBuffer() + (static_cast<size_t>(screen_y) * LCDWidth) / 4;
+	for (size_t x = 0; x < LCDWidth; x += 4)
+	{
+		line[x / 4] = static_cast<uint8_t>((colors[x] << 6) | (colors[x + 1] << 4) | (colors[x + 2] << 2) | colors[x + 3]);
+	}
+}
+
+uint8_t* PPU::GetBackBuffer() noexcept
+{
+	return m_LCDBuffers[(m_FrameSequence.load(std::memory_order_relaxed) & 1) ^ 1];
 }
 
 void PPU::SetPixel(uint8_t a_X, uint8_t a_Y, uint8_t a_Color) noexcept
@@ -517,5 +1073,6 @@ void PPU::SetPixel(uint8_t a_X, uint8_t a_Y, uint8_t a_Color) noexcept
 
 	const uint8_t pixel_mask = ~(0b11 << bit_offset);
 
-	m_LCDBuffer[byte_offset] = (m_LCDBuffer[byte_offset] & pixel_mask) | ((a_Color & 0b11) << bit_offset);
+	uint8_t* const buffer = GetBackBuffer();
+	buffer[byte_offset] = (buffer[byte_offset] & pixel_mask) | ((a_Color & 0b11) << bit_offset);
 }
\ No newline at end of file
@@ -4,8 +4,14 @@
 #include <gameboy/api.hpp>
 #include <gameboy/lcdmode.hpp>
 #include <gameboy/pixelfifo.hpp>
+#include <gameboy/pixelformat.hpp>
 #include <gameboy/tilefetcher.hpp>
 
+#include <common/recordable.hpp>
+
+#include <array>
+#include <atomic>
+#include <map>
 #include <set>
 
 namespace Amber::Gameboy
@@ -14,7 +20,7 @@ namespace Amber::Gameboy
 	class MMU;
 	class PPUObserver;
 
-	class GAMEBOY_API PPU
+	class GAMEBOY_API PPU : public Common::Recordable
 	{
 		public:
 		static constexpr size_t LCDWidth = 160;
@@ -68,11 +74,44 @@ namespace Amber::Gameboy
 		void Tick();
 		void Reset();
 
+		// Deferred ticking
+		void Advance(size_t a_Cycles);
+		void Synchronize();
+		size_t GetPendingCycles() const noexcept;
+		// Dots until the PPU may next request an interrupt or change LY, counting the pending ones as already passed
+		size_t GetIdleDots() const noexcept;
+
+		// Scanline rendering: each line is drawn in one go when it enters HBlank, using the line timings the pixel
+		// FIFO produced for the same scroll and sprite layout. A write to VRAM, OAM or an LCD register while a line
+		// is in progress replays that line through the pixel FIFO up to the current dot, see FlushLine.
+		bool IsScanlineRendererEnabled() const noexcept;
+		void SetScanlineRendererEnabled(bool a_Enabled);
+		void FlushLine() noexcept;
+
+		// Frame output: the PPU draws into a back buffer and presents it when VBlank starts, which bumps the frame
+		// sequence. The frame buffer holds the last complete frame packed as four 2-bit shades per byte, leftmost
+		// pixel in the high bits. It stays untouched until the sequence moves on again, so a reader on another
+		// thread can use it in place and check the sequence afterwards to know it did not tear.
+		static constexpr size_t FrameBufferSize = (LCDWidth * LCDHeight) / 4;
+
+		uint64_t GetFrameSequence() const noexcept;
+		const uint8_t* GetFrameBuffer() const noexcept;
+
+		// Converts the last complete frame to the given format, scaling every pixel up to a_Scale x a_Scale. The pitch is the
+		// distance between destination rows in pixels.
 		void Blit(void* a_Destination, size_t a_Pitch) const noexcept;
+		void Blit(void* a_Destination, size_t a_Pitch, PixelFormat::Enum a_Format, size_t a_Scale = 1) const noexcept;
 
 		void AddObserver(PPUObserver& a_Observer);
 		void RemoveObserver(PPUObserver& a_Observer);
 
+		// Recording: save after synchronizing. Both the last complete frame and the partly drawn one are part of the
+		// state. Loading presents the complete frame again and goes on drawing the other from where it was saved.
+		size_t GetRecorderMemberCount() const noexcept override;
+		const Common::RecorderMemberDescription& GetRecorderMember(size_t a_Index) const noexcept override;
+		void SaveRecorderState(Common::ByteWriter& a_Writer) const noexcept override;
+		void LoadRecorderState(Common::ByteReader& a_Reader) noexcept override;
+
 		private:
 		struct SpriteDrawInfo
 		{
@@ -83,16 +122,21 @@ namespace Amber::Gameboy
 		};
 
 		void SetLCDMode(LCDMode::Enum a_Mode);
+		size_t GetDeadline() const noexcept;
+		void UpdateDeadline() noexcept;
 
 		void GotoOAM() noexcept;
-		void GotoPixelTransfer() noexcept;
+		void GotoPixelTransfer();
 		void GotoHBlank() noexcept;
 		void GotoVBlank() noexcept;
 
 		void OAMSearch() noexcept;
 		void PixelTransfer() noexcept;
 
-		uint8_t GetPixel(uint8_t a_X, uint8_t a_Y) const noexcept;
+		void BeginPixelTransfer() noexcept;
+		void RenderLine() noexcept;
+
+		uint8_t* GetBackBuffer() noexcept;
 		void SetPixel(uint8_t a_X, uint8_t a_Y, uint8_t a_Color) noexcept;
 
 		// Other components
@@ -111,6 +155,10 @@ namespace Amber::Gameboy
 		uint16_t m_HCounter = 0;
 		uint16_t m_VCounter = 0;
 
+		// Deferred ticking
+		size_t m_PendingCycles = 0;
+		size_t m_Deadline = 1;
+
 		// LCD control
 		uint8_t m_LCDC = 0x91;
 		uint8_t m_STAT = 0x00;
@@ -129,8 +177,18 @@ namespace Amber::Gameboy
 		bool m_IsFetchingSprite;
 		uint8_t m_DrawX;
 
-		// LCD result buffer
-		uint8_t m_LCDBuffer[(LCDWidth * LCDHeight) / 4] = {};
+		// Scanline rendering
+		using LineLayout = std::array<uint8_t, 11>;
+
+		std::map<LineLayout, uint16_t> m_LineTimings;
+		bool m_ScanlineRenderer = false;
+		bool m_LineDeferred = false;
+		bool m_LineDrawn = false;
+		uint16_t m_LineEnd = 0;
+
+		// LCD result buffers, the front buffer is picked by the parity of the frame sequence
+		uint8_t m_LCDBuffers[2][FrameBufferSize] = {};
+		std::atomic<uint64_t> m_FrameSequence = 0;
 
 		// Observers
 		std::set<PPUObserver*> m_Observers;
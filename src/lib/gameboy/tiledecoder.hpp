@@ -0,0 +1,119 @@
+#ifndef H_AMBER_GAMEBOY_TILEDECODER
+#define H_AMBER_GAMEBOY_TILEDECODER
+
+#include <gameboy/api.hpp>
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AMBER_GAMEBOY_TILEDECODER_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__BMI2__)
+#define AMBER_GAMEBOY_TILEDECODER_BMI2
+#include <immintrin.h>
+#endif
+
+namespace Amber::Gameboy
+{
+	// Tiles are stored as two bit planes per row, pixel i of a row takes bit 7 - i of the low plane as bit 0 of its
+	// color index and bit 7 - i of the high plane as bit 1. Every function here decodes a whole row at once.
+	namespace TileDecoder
+	{
+		// Eight color indices, one per byte, leftmost pixel in the lowest byte
+		inline uint64_t DecodeRow(uint8_t a_Low, uint8_t a_High) noexcept
+		{
+			constexpr uint64_t Broadcast = 0x0101'0101'0101'0101;
+			constexpr uint64_t BitMask = 0x0102'0408'1020'4080; // Byte i keeps bit 7 - i
+			constexpr uint64_t Carry = 0x7F7F'7F7F'7F7F'7F7F;
+
+			const uint64_t low = ((((a_Low * Broadcast) & BitMask) + Carry) >> 7) & Broadcast;
+			const uint64_t high = ((((a_High * Broadcast) & BitMask) + Carry) >> 7) & Broadcast;
+
+			return low | (high << 1);
+		}
+
+		inline void DecodeRow(uint8_t a_Low, uint8_t a_High, uint8_t a_Colors[8]) noexcept
+		{
+			const uint64_t colors = DecodeRow(a_Low, a_High);
+
+			// Byte order has to match pixel order
+			for (uint8_t i = 0; i < 8; ++i)
+			{
+				a_Colors[i] = static_cast<uint8_t>(colors >> (i * 8));
+			}
+		}
+
+		// Eight color indices, one per nibble, leftmost pixel in the lowest nibble (the pixel FIFO layout)
+		inline uint32_t DecodeRowNibbles(uint8_t a_Low, uint8_t a_High) noexcept
+		{
+			uint64_t colors = DecodeRow(a_Low, a_High);
+			colors = (colors | (colors >> 4)) & 0x00FF'00FF'00FF'00FF;
+			colors = (colors | (colors >> 8)) & 0x0000'FFFF'0000'FFFF;
+			colors = (colors | (colors >> 16)) & 0x0000'0000'FFFF'FFFF;
+
+			return static_cast<uint32_t>(colors);
+		}
+
+		// Eight 2-bit color indices, leftmost pixel in the highest bits (the LCD buffer layout)
+		inline uint16_t InterleaveRow(uint8_t a_Low, uint8_t a_High) noexcept
+		{
+			#if defined(AMBER_GAMEBOY_TILEDECODER_BMI2)
+			return static_cast<uint16_t>(_pdep_u32(a_Low, 0x5555) | _pdep_u32(a_High, 0xAAAA));
+			#else
+			uint32_t low = a_Low;
+			low = (low | (low << 4)) & 0x0F0F;
+			low = (low | (low << 2)) & 0x3333;
+			low = (low | (low << 1)) & 0x5555;
+
+			uint32_t high = a_High;
+			high = (high | (high << 4)) & 0x0F0F;
+			high = (high | (high << 2)) & 0x3333;
+			high = (high | (high << 1)) & 0x5555;
+
+			return static_cast<uint16_t>(low | (high << 1));
+			#endif
+		}
+
+		// A whole 8x8 tile, 16 bytes of plane data to 64 color indices in row order
+		inline void DecodeTile(const uint8_t a_Data[16], uint8_t a_Colors[64]) noexcept
+		{
+			#if defined(AMBER_GAMEBOY_TILEDECODER_SSE2)
+			// Each row is spread into one register as eight copies of the low plane followed by eight copies of the
+			// high plane, then a bit test per lane yields both halves of the color index
+			const __m128i bit_mask = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+			const __m128i plane_value = _mm_set_epi8(2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1);
+
+			const auto decode = [&](__m128i a_Row)
+			{
+				const __m128i bits = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(a_Row, bit_mask), bit_mask), plane_value);
+				return _mm_or_si128(bits, _mm_srli_si128(bits, 8));
+			};
+
+			const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_Data));
+			const __m128i pairs[2] = { _mm_unpacklo_epi8(data, data), _mm_unpackhi_epi8(data, data) };
+
+			for (size_t i = 0; i < 2; ++i)
+			{
+				const __m128i quads[2] = { _mm_unpacklo_epi16(pairs[i], pairs[i]), _mm_unpackhi_epi16(pairs[i], pairs[i]) };
+
+				for (size_t j = 0; j < 2; ++j)
+				{
+					const __m128i row0 = decode(_mm_unpacklo_epi32(quads[j], quads[j]));
+					const __m128i row1 = decode(_mm_unpackhi_epi32(quads[j], quads[j]));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(a_Colors + (i * 2 + j) * 16), _mm_unpacklo_epi64(row0, row1));
+				}
+			}
+			#else
+			for (size_t row = 0; row < 8; ++row)
+			{
+				DecodeRow(a_Data[row * 2], a_Data[row * 2 + 1], a_Colors + row * 8);
+			}
+			#endif
+		}
+	}
+}
+
+#endif
\ No newline at end of file
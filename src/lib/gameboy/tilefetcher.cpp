@@ -4,8 +4,8 @@ using namespace Amber;
 using namespace Common;
 using namespace Gameboy;
 
-TileFetcher::TileFetcher(Memory16& a_Memory):
-	m_Memory(a_Memory)
+TileFetcher::TileFetcher(MMU& a_MMU):
+	m_MMU(a_MMU)
 {
 }
 
@@ -25,7 +25,7 @@ void TileFetcher::Tick()
 	{
 		case State::ReadTile:
 		{
-			const uint8_t tile_index = m_Memory.Load8(m_TileIndexAddress) + (m_SignedIndex ? 128 : 0);
+			const uint8_t tile_index = m_MMU.Load8(m_TileIndexAddress) + (m_SignedIndex ? 128 : 0);
 			const uint16_t tile_base_address = m_SignedIndex ? 0x8800 : 0x8000;
 			m_TileAddress = tile_base_address + tile_index * 16 + m_TileY * 2;
 
@@ -34,12 +34,12 @@ void TileFetcher::Tick()
 		break;
 
 		case State::ReadData0:
-		m_Colors[0] = m_Memory.Load8(m_TileAddress);
+		m_Colors[0] = m_MMU.Load8(m_TileAddress);
 		m_State = State::ReadData1;
 		break;
 
 		case State::ReadData1:
-		m_Colors[1] = m_Memory.Load8(m_TileAddress + 1);
+		m_Colors[1] = m_MMU.Load8(m_TileAddress + 1);
 		m_State = State::Done;
 		break;
 	}
@@ -73,4 +73,28 @@ void TileFetcher::FetchSprite(uint8_t a_SpriteIndex, uint8_t a_TileY, uint8_t a_
 	m_SignedIndex = false;
 
 	m_State = State::ReadTile;
+}
+
+void TileFetcher::SaveRecorderState(ByteWriter& a_Writer) const noexcept
+{
+	a_Writer.Write(m_X);
+	a_Writer.Write(m_Y);
+	a_Writer.Write(m_TileY);
+	a_Writer.Write(m_TileIndexAddress);
+	a_Writer.Write(m_SignedIndex);
+	a_Writer.Write(m_State);
+	a_Writer.Write(m_TileAddress);
+	a_Writer.Write(m_Colors);
+}
+
+void TileFetcher::LoadRecorderState(ByteReader& a_Reader) noexcept
+{
+	a_Reader.Read(m_X);
+	a_Reader.Read(m_Y);
+	a_Reader.Read(m_TileY);
+	a_Reader.Read(m_TileIndexAddress);
+	a_Reader.Read(m_SignedIndex);
+	a_Reader.Read(m_State);
+	a_Reader.Read(m_TileAddress);
+	a_Reader.Read(m_Colors);
 }
\ No newline at end of file
@@ -2,15 +2,17 @@
 #define H_AMBER_GAMEBOY_TILEFETCHER
 
 #include <gameboy/api.hpp>
+#include <gameboy/mmu.hpp>
 
-#include <common/memory.hpp>
+#include <common/bytereader.hpp>
+#include <common/bytewriter.hpp>
 
 namespace Amber::Gameboy
 {
 	class GAMEBOY_API TileFetcher
 	{
 		public:
-		TileFetcher(Common::Memory16& a_Memory);
+		TileFetcher(MMU& a_MMU);
 
 		bool IsDone() const noexcept;
 		const uint8_t* GetColors() const noexcept;
@@ -20,6 +22,12 @@ namespace Amber::Gameboy
 		void FetchBackgroundTile(uint8_t a_X, uint8_t a_Y, uint8_t a_LCDC);
 		void FetchSprite(uint8_t a_SpriteIndex, uint8_t a_TileY, uint8_t a_Attributes);
 
+		// Recorded as part of the PPU's state
+		static constexpr size_t RecorderStateSize = 11;
+
+		void SaveRecorderState(Common::ByteWriter& a_Writer) const noexcept;
+		void LoadRecorderState(Common::ByteReader& a_Reader) noexcept;
+
 		private:
 		enum class State : uint8_t
 		{
@@ -30,7 +38,7 @@ namespace Amber::Gameboy
 		};
 
 		// Memory location
-		Common::Memory16& m_Memory;
+		MMU& m_MMU;
 		uint8_t m_X = 0;
 		uint8_t m_Y = 0;
 		uint8_t m_TileY = 0;
@@ -1,5 +1,7 @@
 #include <gameboy/videoviewer.hpp>
 
+#include <gameboy/tiledecoder.hpp>
+
 using namespace Amber;
 using namespace Gameboy;
 
@@ -22,25 +24,14 @@ void VideoViewer::BlitTile(size_t a_Tile, void* a_Destination, size_t a_Pitch) c
 {
 	static constexpr uint8_t colors[] = { 0xFF, 0x77, 0xCC, 0x00 };
 
-	uint8_t tile_data[16];
-	for (size_t i = 0; i < 16; ++i)
-	{
-		tile_data[i] = m_VRAM.Load8(a_Tile * 16 + i);
-	}
+	uint8_t tile_colors[64];
+	TileDecoder::DecodeTile(m_VRAM.GetData() + a_Tile * 16, tile_colors);
 
 	for (size_t y = 0; y < GetTileHeight(); ++y)
 	{
 		for (size_t x = 0; x < GetTileWidth(); ++x)
 		{
-			const uint8_t line = y * 2;
-
-			const uint8_t byte0 = tile_data[line + 0];
-			const uint8_t byte1 = tile_data[line + 1];
-
-			const uint8_t bit0 = (byte0 >> (7 - x)) & 0x01;
-			const uint8_t bit1 = (byte1 >> (7 - x)) & 0x01;
-
-			const uint8_t color = colors[bit0 | (bit1 << 1)];
+			const uint8_t color = colors[tile_colors[y * 8 + x]];
 
 			uint8_t* const pixel = reinterpret_cast<uint8_t*>(a_Destination) + (y * a_Pitch + x) * 4;
 
@@ -0,0 +1,64 @@
+#include <catch2/catch.hpp>
+
+#include <common/blockcache.hpp>
+
+using namespace Amber;
+using namespace Common;
+
+#define TEST_TAGS "[blockcache]"
+
+namespace
+{
+	using TestBlockCache = BlockCache<uint16_t, int>;
+
+	// A block running over from the first page into the second
+	TestBlockCache::Block CreateBlock()
+	{
+		TestBlockCache::Block block;
+		block.m_Address = TestBlockCache::PageSize - 0x10;
+		block.m_Length = 0x20;
+		return block;
+	}
+}
+
+TEST_CASE("BlockCache drops a block through any page it spans", TEST_TAGS)
+{
+	const uint16_t store = GENERATE(uint16_t(TestBlockCache::PageSize - 1), uint16_t(TestBlockCache::PageSize));
+
+	TestBlockCache cache;
+	cache.Insert(1, CreateBlock(), true);
+	REQUIRE(cache.GetWatchCount(0) == 1);
+	REQUIRE(cache.GetWatchCount(TestBlockCache::PageSize) == 1);
+
+	const uint64_t generation = cache.GetGeneration();
+	cache.Invalidate(store);
+	REQUIRE(cache.Find(1) == nullptr);
+	REQUIRE(cache.GetGeneration() != generation);
+
+	// Nothing is left watching the other page either
+	REQUIRE(cache.GetWatchCount(0) == 0);
+	REQUIRE(cache.GetWatchCount(TestBlockCache::PageSize) == 0);
+}
+
+TEST_CASE("BlockCache watches a recompiled block only once", TEST_TAGS)
+{
+	TestBlockCache cache;
+
+	// Self-modifying code: the block is dropped through its first page and compiled again, over and over
+	for (size_t i = 0; i < 100; ++i)
+	{
+		cache.Insert(1, CreateBlock(), true);
+		cache.Invalidate(0);
+	}
+
+	cache.Insert(1, CreateBlock(), true);
+	cache.Insert(1, CreateBlock(), true);
+	REQUIRE(cache.GetBlockCount() == 1);
+	REQUIRE(cache.GetWatchCount(0) == 1);
+	REQUIRE(cache.GetWatchCount(TestBlockCache::PageSize) == 1);
+
+	// An unwatched block replacing it stops the watch
+	cache.Insert(1, CreateBlock(), false);
+	REQUIRE(cache.GetWatchCount(0) == 0);
+	REQUIRE(cache.GetWatchCount(TestBlockCache::PageSize) == 0);
+}
\ No newline at end of file
@@ -128,4 +128,36 @@ TEST_CASE("ByteWriter can read bytes")
 			REQUIRE(std::strcmp(source, destination) == 0);
 		}
 	}
+}
+
+TEST_CASE("ByteReader can read variable length quantities")
+{
+	uint8_t buffer[64];
+	ByteReader reader(buffer, sizeof(buffer));
+	ByteWriter writer(buffer, sizeof(buffer));
+
+	const uint64_t sources[] = { 0, 1, 0x7F, 0x80, 0x3FFF, 0x4000, 0x12345678, ~uint64_t(0) };
+	const size_t sizes[] = { 1, 1, 1, 2, 2, 3, 5, 10 };
+	for (size_t i = 0; i < std::size(sources); ++i)
+	{
+		const size_t position = writer.GetPosition();
+		const size_t bytes_written = writer.WriteVLQ(sources[i]);
+		REQUIRE(bytes_written == sizes[i]);
+		REQUIRE(writer.GetPosition() == position + bytes_written);
+
+		uint64_t destination = 1;
+		const size_t bytes_read = reader.ReadVLQ(destination);
+		REQUIRE(bytes_read == bytes_written);
+		REQUIRE(reader.GetPosition() == writer.GetPosition());
+		REQUIRE(destination == sources[i]);
+	}
+
+	SECTION("A truncated quantity isn't read")
+	{
+		ByteWriter(buffer, sizeof(buffer)).WriteVLQ(uint32_t(0x12345678));
+
+		uint32_t destination;
+		ByteReader truncated(buffer, 4);
+		REQUIRE(truncated.ReadVLQ(destination) == 0);
+	}
 }
\ No newline at end of file
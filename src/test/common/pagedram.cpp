@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+
+#include <common/bytereader.hpp>
+#include <common/bytewriter.hpp>
+#include <common/pagedram.hpp>
+
+#include <vector>
+
+using namespace Amber;
+using namespace Common;
+
+#define TEST_TAGS "[memory]"
+
+TEST_CASE("PagedRAM can store and load bytes across pages", TEST_TAGS)
+{
+	const size_t ram_size = GENERATE(size_t(1), size_t(0x1000), size_t(0x2800));
+	PagedRAM32<false> ram(ram_size);
+	REQUIRE(ram.GetSize() == ram_size);
+
+	for (size_t i = 0; i < ram_size; ++i)
+	{
+		REQUIRE(ram.Load8(static_cast<uint32_t>(i)) == 0);
+		ram.Store8(static_cast<uint32_t>(i), static_cast<uint8_t>(i * 7));
+	}
+
+	std::vector<uint8_t> data(ram_size);
+	ram.Read(0, data.data(), data.size());
+	for (size_t i = 0; i < ram_size; ++i)
+	{
+		REQUIRE(data[i] == static_cast<uint8_t>(i * 7));
+	}
+
+	if (ram_size > PagedRAM32<false>::PageSize)
+	{
+		constexpr uint32_t address = PagedRAM32<false>::PageSize - 2;
+		ram.Store32(address, 0x12345678);
+		REQUIRE(ram.Load32(address) == 0x12345678);
+		REQUIRE(ram.Load16(address + 2) == 0x1234);
+	}
+}
+
+TEST_CASE("PagedRAM copies share pages until they are written", TEST_TAGS)
+{
+	const uint8_t source[] = { 1, 2, 3, 4 };
+	PagedRAM16<false> ram(0x3000);
+	ram.Write(0x0FFE, source, sizeof(source));
+
+	PagedRAM16<false> copy(ram);
+	REQUIRE(ram.GetSharedPageCount() == 3);
+	REQUIRE(copy.GetSharedPageCount() == 3);
+	REQUIRE(copy.Load8(0x1001) == 4);
+
+	copy.Store8(0x1001, 5);
+	REQUIRE(copy.Load8(0x1001) == 5);
+	REQUIRE(ram.Load8(0x1001) == 4);
+	REQUIRE(copy.GetSharedPageCount() == 2);
+
+	ram.Store8(0x0000, 6);
+	REQUIRE(ram.Load8(0x0000) == 6);
+	REQUIRE(copy.Load8(0x0000) == 0);
+	REQUIRE(ram.GetSharedPageCount() == 1);
+
+	SECTION("Loading the same contents keeps pages shared")
+	{
+		std::vector<uint8_t> state(ram.GetRecorderStateSize());
+		ByteWriter writer(state.data(), state.size());
+		ram.SaveRecorderState(writer);
+
+		PagedRAM16<false> other(ram);
+		state[0x2000] = 7;
+		ByteReader reader(state.data(), state.size());
+		other.LoadRecorderState(reader);
+
+		REQUIRE(other.GetSharedPageCount() == 2);
+		REQUIRE(other.Load8(0x2000) == 7);
+		REQUIRE(ram.Load8(0x2000) == 0);
+	}
+}
\ No newline at end of file
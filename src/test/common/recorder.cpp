@@ -2,9 +2,60 @@
 
 #include <common/recorder.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
 using namespace Amber;
 using namespace Common;
 
+namespace
+{
+	RecorderChannelDescription MakeChannelDescription(std::string_view a_Name, size_t a_Size, bool a_Journaled = false)
+	{
+		RecorderMemberDescription member_description;
+		member_description.SetName("Data");
+		member_description.SetSize(a_Size);
+
+		RecorderChannelDescription channel_description;
+		channel_description.SetName(a_Name);
+		channel_description.AddMember(member_description);
+		channel_description.SetJournaled(a_Journaled);
+
+		return channel_description;
+	}
+
+	// A tiny deterministic machine, the next state only depends on the current state and the input
+	struct Machine : RecorderReplayer
+	{
+		static constexpr size_t StateSize = 256;
+
+		static void Step(uint8_t* a_State, uint8_t a_Input)
+		{
+			for (size_t i = 0; i < StateSize; ++i)
+			{
+				a_State[i] = static_cast<uint8_t>(a_State[i] * 31 + a_State[(i + 1) % StateSize] + a_Input + i);
+			}
+		}
+
+		void ReplayFrame(Recorder& a_Recorder, size_t a_Frame) override
+		{
+			uint8_t state[StateSize];
+			std::memcpy(state, a_Recorder.ReadChannelData(m_StateChannel), StateSize);
+			Step(state, *static_cast<const uint8_t*>(a_Recorder.ReadChannelData(m_InputChannel)));
+			a_Recorder.WriteChannelData(m_StateChannel, state);
+
+			++m_ReplayedFrames;
+		}
+
+		size_t m_StateChannel = 0;
+		size_t m_InputChannel = 0;
+		size_t m_ReplayedFrames = 0;
+	};
+}
+
 TEST_CASE("Recorder can save and restore frame data")
 {
 	struct FooData
@@ -20,13 +71,8 @@ TEST_CASE("Recorder can save and restore frame data")
 		uint8_t m_Field3[17];
 	};
 
-	ChannelDescription foo_channel_description;
-	foo_channel_description.SetName("Foo");
-	foo_channel_description.SetSize(sizeof(FooData));
-
-	ChannelDescription bar_channel_description;
-	bar_channel_description.SetName("Bar");
-	bar_channel_description.SetSize(sizeof(BarData));
+	const RecorderChannelDescription foo_channel_description = MakeChannelDescription("Foo", sizeof(FooData));
+	const RecorderChannelDescription bar_channel_description = MakeChannelDescription("Bar", sizeof(BarData));
 
 	RecorderDescription recorder_description;
 	const size_t foo_channel = recorder_description.AddChannel(foo_channel_description);
@@ -76,7 +122,7 @@ TEST_CASE("Recorder can save and restore frame data")
 
 	REQUIRE(recorder.GetFrameCount() == total_frame_count);
 
-	for (size_t i = 0; i < total_frame_count; --i)
+	for (size_t i = 0; i < total_frame_count; ++i)
 	{
 		const size_t frame_index = total_frame_count - (i + 1);
 
@@ -104,4 +150,279 @@ TEST_CASE("Recorder can save and restore frame data")
 		REQUIRE(bar_data.m_Field0[1] == expected_bar_data.m_Field0[1]);
 		REQUIRE(bar_data.m_Field1 == expected_bar_data.m_Field1);
 	}
+}
+
+TEST_CASE("Recorder deltas restore every frame in any seek order")
+{
+	constexpr size_t state_size = 4096;
+	constexpr size_t frame_count = 2000;
+
+	RecorderDescription recorder_description;
+	const size_t sparse_channel = recorder_description.AddChannel(MakeChannelDescription("Sparse", state_size));
+	const size_t dense_channel = recorder_description.AddChannel(MakeChannelDescription("Dense", 64));
+	const size_t keyframe_interval = GENERATE(0, 1, 7, 300);
+	recorder_description.SetKeyframeInterval(keyframe_interval);
+	recorder_description.SetBlockSize(64 * 1024);
+
+	// A mostly static state with a few bytes changing every frame, plus a channel that changes completely
+	std::vector<std::vector<uint8_t>> sparse_frames;
+	std::vector<std::vector<uint8_t>> dense_frames;
+	std::vector<uint8_t> sparse(state_size, 0x55);
+	std::vector<uint8_t> dense(64);
+	uint32_t seed = 0x12345678;
+	const auto random = [&seed]()
+	{
+		seed = seed * 1664525 + 1013904223;
+		return seed >> 8;
+	};
+
+	Recorder recorder(recorder_description);
+	for (size_t i = 0; i < frame_count; ++i)
+	{
+		REQUIRE(recorder.NewFrame() == i);
+
+		for (size_t j = random() % 8; j > 0; --j)
+		{
+			sparse[random() % state_size] = static_cast<uint8_t>(random());
+		}
+		recorder.WriteChannelData(sparse_channel, sparse.data());
+
+		if (i % 3 == 0)
+		{
+			std::generate(dense.begin(), dense.end(), [&random]() { return static_cast<uint8_t>(random()); });
+			recorder.WriteChannelData(dense_channel, dense.data());
+		}
+
+		sparse_frames.push_back(sparse);
+		dense_frames.push_back(dense);
+	}
+
+	REQUIRE(recorder.GetFrameCount() == frame_count);
+
+	// Unless every frame is a keyframe, far less than a full copy per frame
+	if (keyframe_interval != 1)
+	{
+		REQUIRE(recorder.GetMemoryUsage() <= (frame_count / 4) * (state_size + 64));
+	}
+
+	const auto check_frame = [&](size_t a_Frame)
+	{
+		recorder.SetCurrentFrame(a_Frame);
+		REQUIRE(recorder.GetCurrentFrame() == a_Frame);
+		REQUIRE(std::memcmp(recorder.ReadChannelData(sparse_channel), sparse_frames[a_Frame].data(), state_size) == 0);
+		REQUIRE(std::memcmp(recorder.ReadChannelData(dense_channel), dense_frames[a_Frame].data(), 64) == 0);
+	};
+
+	for (size_t i = frame_count; i > 0; --i)
+	{
+		check_frame(i - 1);
+	}
+	for (size_t i = 0; i < 200; ++i)
+	{
+		check_frame(random() % frame_count);
+	}
+
+	// Recording resumes after the last frame, no matter where the recorder was seeked to
+	check_frame(5);
+	REQUIRE(recorder.NewFrame() == frame_count);
+	recorder.WriteChannelData(sparse_channel, sparse.data());
+	recorder.WriteChannelData(dense_channel, dense.data());
+	check_frame(frame_count - 1);
+	check_frame(5);
+	recorder.SetCurrentFrame(frame_count);
+	REQUIRE(std::memcmp(recorder.ReadChannelData(sparse_channel), sparse.data(), state_size) == 0);
+}
+
+TEST_CASE("Recorder drops the oldest frames to stay within its memory budget")
+{
+	constexpr size_t state_size = 1024;
+	constexpr size_t block_size = 16 * 1024;
+	constexpr size_t budget = block_size * 4;
+
+	RecorderDescription recorder_description;
+	const size_t channel = recorder_description.AddChannel(MakeChannelDescription("State", state_size));
+	recorder_description.SetKeyframeInterval(10);
+	recorder_description.SetBlockSize(block_size);
+	recorder_description.SetMemoryBudget(budget);
+
+	Recorder recorder(recorder_description);
+	std::vector<uint8_t> state(state_size);
+	for (size_t i = 0; i < 10000; ++i)
+	{
+		recorder.NewFrame();
+		std::memcpy(state.data(), &i, sizeof(i));
+		recorder.WriteChannelData(channel, state.data());
+
+		REQUIRE(recorder.GetMemoryUsage() <= budget);
+	}
+
+	REQUIRE(recorder.GetFirstFrame() > 0);
+	REQUIRE(recorder.GetFirstFrame() % 10 == 0);
+
+	for (size_t i = recorder.GetFirstFrame(); i < recorder.GetFrameCount(); ++i)
+	{
+		recorder.SetCurrentFrame(i);
+
+		size_t value;
+		std::memcpy(&value, recorder.ReadChannelData(channel), sizeof(value));
+		REQUIRE(value == i);
+	}
+
+	// Frames that were dropped clamp to the oldest one still around
+	recorder.SetCurrentFrame(0);
+	REQUIRE(recorder.GetCurrentFrame() == recorder.GetFirstFrame());
+}
+
+TEST_CASE("Recorder replays journaled inputs from the nearest keyframe")
+{
+	constexpr size_t frame_count = 5000;
+	constexpr size_t keyframe_interval = 64;
+
+	RecorderDescription recorder_description;
+	Machine machine;
+	machine.m_StateChannel = recorder_description.AddChannel(MakeChannelDescription("State", Machine::StateSize));
+	machine.m_InputChannel = recorder_description.AddChannel(MakeChannelDescription("Input", 1, true));
+	recorder_description.SetKeyframeInterval(keyframe_interval);
+	recorder_description.SetBlockSize(64 * 1024);
+
+	Recorder recorder(recorder_description);
+	recorder.SetReplayer(&machine);
+
+	std::vector<std::vector<uint8_t>> states;
+	uint8_t state[Machine::StateSize] = {};
+	uint32_t seed = 0x12345678;
+	for (size_t i = 0; i < frame_count; ++i)
+	{
+		recorder.NewFrame();
+
+		// Inputs change rarely, like a joypad would
+		seed = seed * 1664525 + 1013904223;
+		const uint8_t input = static_cast<uint8_t>((seed >> 24) & 0b1111'0000);
+		recorder.WriteChannelData(machine.m_InputChannel, &input);
+
+		Machine::Step(state, input);
+		recorder.WriteChannelData(machine.m_StateChannel, state);
+		states.emplace_back(state, state + Machine::StateSize);
+	}
+
+	// Only keyframes carry the state
+	REQUIRE(recorder.GetMemoryUsage() <= 64 * 1024 * 4);
+
+	for (size_t i = 0; i < 500; ++i)
+	{
+		seed = seed * 1664525 + 1013904223;
+		const size_t frame = (seed >> 8) % frame_count;
+
+		machine.m_ReplayedFrames = 0;
+		recorder.SetCurrentFrame(frame);
+
+		REQUIRE(machine.m_ReplayedFrames < keyframe_interval);
+		REQUIRE(std::memcmp(recorder.ReadChannelData(machine.m_StateChannel), states[frame].data(), Machine::StateSize) == 0);
+	}
+}
+
+TEST_CASE("Recorder stores keyframes early once deltas exceed the byte budget")
+{
+	constexpr size_t state_size = 1024;
+
+	RecorderDescription recorder_description;
+	const size_t channel = recorder_description.AddChannel(MakeChannelDescription("State", state_size));
+	recorder_description.SetKeyframeInterval(0);
+	recorder_description.SetKeyframeByteBudget(state_size * 4);
+	recorder_description.SetBlockSize(64 * 1024);
+
+	// Rewrite the whole state every frame, so each delta is about as large as a keyframe
+	Recorder recorder(recorder_description);
+	std::vector<uint8_t> state(state_size);
+	for (size_t i = 0; i < 100; ++i)
+	{
+		recorder.NewFrame();
+		std::fill(state.begin(), state.end(), static_cast<uint8_t>(i + 1));
+		recorder.WriteChannelData(channel, state.data());
+	}
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		recorder.SetCurrentFrame(99 - i);
+		REQUIRE(static_cast<const uint8_t*>(recorder.ReadChannelData(channel))[state_size - 1] == static_cast<uint8_t>(100 - i));
+	}
+
+	// A keyframe after every four deltas of a little over 1 kb each
+	REQUIRE(recorder.GetKeyframeCount() == 20);
+}
+
+TEST_CASE("Recorder journals can be reopened and appended to")
+{
+	constexpr size_t state_size = 1024;
+	const std::string path = (std::filesystem::temp_directory_path() / "amber_recorder_journal.bin").string();
+
+	RecorderDescription recorder_description;
+	recorder_description.AddChannel(MakeChannelDescription("State", state_size));
+	recorder_description.SetKeyframeInterval(16);
+	recorder_description.SetBlockSize(64 * 1024);
+
+	std::vector<std::vector<uint8_t>> frames;
+	std::vector<uint8_t> state(state_size);
+	const auto record = [&](Recorder& a_Recorder, size_t a_Count)
+	{
+		for (size_t i = 0; i < a_Count; ++i)
+		{
+			REQUIRE(a_Recorder.NewFrame() == frames.size());
+
+			const size_t frame = frames.size();
+			state[frame % state_size] = static_cast<uint8_t>(frame);
+			std::memcpy(state.data() + state_size - sizeof(frame), &frame, sizeof(frame));
+			a_Recorder.WriteChannelData(0, state.data());
+			frames.push_back(state);
+		}
+
+		// Leaving the last frame stores it
+		a_Recorder.SetCurrentFrame(0);
+	};
+	const auto check = [&](Recorder& a_Recorder)
+	{
+		REQUIRE(a_Recorder.GetFrameCount() == frames.size());
+		for (size_t i = frames.size(); i > 0; --i)
+		{
+			a_Recorder.SetCurrentFrame(i - 1);
+			REQUIRE(std::memcmp(a_Recorder.ReadChannelData(0), frames[i - 1].data(), state_size) == 0);
+		}
+	};
+
+	{
+		Recorder recorder(recorder_description, path);
+		record(recorder, 500);
+		check(recorder);
+	}
+
+	{
+		auto recorder = Recorder::OpenJournal(path);
+		REQUIRE(recorder->GetDescription().GetChannelCount() == 1);
+		REQUIRE(recorder->GetDescription().GetChannel(0).GetName() == "State");
+		REQUIRE(recorder->GetDescription().GetChannel(0).GetSize() == state_size);
+		REQUIRE(recorder->GetDescription().GetKeyframeInterval() == 16);
+		check(*recorder);
+
+		// Recording continues after the last stored frame
+		recorder->SetCurrentFrame(frames.size() - 1);
+		state = frames.back();
+		record(*recorder, 300);
+		check(*recorder);
+	}
+
+	// A block that was still being appended when the process died is dropped
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::app);
+		const std::vector<char> garbage(1000, 0);
+		file.write(garbage.data(), garbage.size());
+	}
+
+	{
+		auto recorder = Recorder::OpenJournal(path);
+		check(*recorder);
+	}
+
+	std::filesystem::remove(path);
+
+	REQUIRE_THROWS(Recorder::OpenJournal(path));
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <catch2/catch.hpp>
+
+#include <common/spscqueue.hpp>
+
+#include <thread>
+
+using namespace Amber;
+using namespace Common;
+
+TEST_CASE("SPSC queue pops values in push order until full", "[threading]")
+{
+	SPSCQueue<uint32_t, 4> queue;
+	REQUIRE(queue.IsEmpty());
+	REQUIRE(!queue.TryPop().has_value());
+
+	for (uint32_t round = 0; round < 3; ++round)
+	{
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			REQUIRE(queue.TryPush(round * 4 + i));
+		}
+		REQUIRE(!queue.TryPush(0));
+
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			REQUIRE(queue.TryPop() == round * 4 + i);
+		}
+		REQUIRE(queue.IsEmpty());
+	}
+}
+
+TEST_CASE("SPSC queue hands every value across threads exactly once", "[threading]")
+{
+	constexpr uint32_t count = 100000;
+	SPSCQueue<uint32_t, 64> queue;
+
+	std::thread producer([&queue]()
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			while (!queue.TryPush(i))
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	uint32_t expected = 0;
+	while (expected < count)
+	{
+		if (const auto value = queue.TryPop())
+		{
+			if (*value != expected)
+			{
+				break;
+			}
+			++expected;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+	REQUIRE(expected == count);
+	REQUIRE(queue.IsEmpty());
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <catch2/catch.hpp>
+
+#include <common/triplebuffer.hpp>
+
+#include <array>
+#include <thread>
+
+using namespace Amber;
+using namespace Common;
+
+TEST_CASE("Triple buffer only hands out the latest published value", "[threading]")
+{
+	TripleBuffer<uint32_t> buffer;
+	REQUIRE(!buffer.Acquire());
+
+	buffer.GetBack() = 1;
+	buffer.Publish();
+	buffer.GetBack() = 2;
+	buffer.Publish();
+
+	REQUIRE(buffer.Acquire());
+	REQUIRE(buffer.GetFront() == 2);
+	REQUIRE(!buffer.Acquire());
+	REQUIRE(buffer.GetFront() == 2);
+
+	buffer.GetBack() = 3;
+	buffer.Publish();
+	REQUIRE(buffer.Acquire());
+	REQUIRE(buffer.GetFront() == 3);
+}
+
+TEST_CASE("Triple buffer never hands out a torn value", "[threading]")
+{
+	constexpr uint32_t count = 100000;
+	TripleBuffer<std::array<uint32_t, 64>> buffer;
+
+	std::thread writer([&buffer]()
+	{
+		for (uint32_t i = 1; i <= count; ++i)
+		{
+			buffer.GetBack().fill(i);
+			buffer.Publish();
+		}
+	});
+
+	uint32_t last = 0;
+	size_t torn = 0;
+	size_t reordered = 0;
+	while (last < count)
+	{
+		if (!buffer.Acquire())
+		{
+			continue;
+		}
+
+		const auto& value = buffer.GetFront();
+		for (const uint32_t element : value)
+		{
+			torn += element != value[0];
+		}
+		reordered += value[0] <= last;
+		last = value[0];
+	}
+
+	writer.join();
+	REQUIRE(torn == 0);
+	REQUIRE(reordered == 0);
+}
\ No newline at end of file
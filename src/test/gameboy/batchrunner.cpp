@@ -0,0 +1,155 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/batchrunner.hpp>
+#include <gameboy/device.hpp>
+#include <gameboy/joypad.hpp>
+#include <gameboy/mmu.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace Amber;
+using namespace Gameboy;
+using namespace Test;
+
+namespace
+{
+	struct BatchRunnerTestFixture : DeviceFixture
+	{
+		BatchRunnerTestFixture():
+			DeviceFixture(0x2000)
+		{
+			// Sends "HI" over serial, then keeps counting in B and storing the count to C000
+			Write(0x0100, {
+				0x3E, 'H',        // LD A,'H'
+				0xE0, 0x01,       // LDH (01),A
+				0x3E, 0x81,       // LD A,81
+				0xE0, 0x02,       // LDH (02),A
+				0x3E, 'I',        // LD A,'I'
+				0xE0, 0x01,       // LDH (01),A
+				0x3E, 0x81,       // LD A,81
+				0xE0, 0x02,       // LDH (02),A
+				0x04,             // INC B
+				0x78,             // LD A,B
+				0xEA, 0x00, 0xC0, // LD (C000),A
+				0x18, 0xF9,       // JR -7
+			});
+		}
+
+		// The same frames the runner runs
+		static void RunFrames(Device& a_Device, size_t a_Count)
+		{
+			for (size_t frame = 0; frame < a_Count; ++frame)
+			{
+				RunFrame(a_Device);
+			}
+		}
+	};
+}
+
+TEST_CASE_METHOD(BatchRunnerTestFixture, "BatchRunner runs every instance like it would run on its own", "[Device][BatchRunner]")
+{
+	constexpr size_t instance_count = 9;
+
+	const size_t thread_count = GENERATE(1, 4);
+	BatchRunner runner(thread_count);
+	REQUIRE(runner.GetThreadCount() == thread_count);
+	runner.AddMemoryRegion(0xC000, 1);
+
+	for (size_t i = 0; i < instance_count; ++i)
+	{
+		REQUIRE(runner.AddInstance(GetDevice().Fork(), 1 + i % 3) == i);
+	}
+	runner.Run();
+
+	for (size_t i = 0; i < instance_count; ++i)
+	{
+		auto reference = GetDevice().Fork();
+		RunFrames(*reference, 1 + i % 3);
+		reference->Synchronize();
+
+		INFO("Instance " << i);
+		const auto& result = runner.GetResult(i);
+		REQUIRE(result.m_Frames == 1 + i % 3);
+		REQUIRE(result.m_SerialOutput == std::vector<uint8_t>{ 'H', 'I' });
+		REQUIRE(result.m_MemoryRegions.size() == 1);
+		REQUIRE(result.m_MemoryRegions[0] == std::vector<uint8_t>{ reference->GetMMU().Load8(0xC000) });
+
+		std::vector<uint8_t> expected;
+		std::vector<uint8_t> state;
+		reference->SaveState(expected);
+		runner.GetDevice(i).SaveState(state);
+		REQUIRE(state == expected);
+	}
+
+	REQUIRE(runner.GetResult(0).m_FrameBufferHash == runner.GetResult(3).m_FrameBufferHash);
+}
+
+TEST_CASE_METHOD(BatchRunnerTestFixture, "BatchRunner finishes instances when their callback asks to", "[Device][BatchRunner]")
+{
+	BatchRunner runner(2);
+	runner.AddInstance(GetDevice().Fork(), 10, [](Device&, size_t a_Frame) { return a_Frame < 2; });
+	runner.AddInstance(GetDevice().Fork(), 3);
+	runner.AddInstance(GetDevice().Fork(), 10, [](Device&, size_t a_Frame) -> bool { throw std::runtime_error("Failed"); });
+
+	REQUIRE_THROWS(runner.Run());
+	REQUIRE(runner.GetResult(0).m_Frames == 2);
+	REQUIRE(runner.GetResult(1).m_Frames == 3);
+	REQUIRE(runner.GetResult(2).m_Frames == 1);
+}
+
+TEST_CASE_METHOD(BatchRunnerTestFixture, "BatchRunner lockstep only runs identical instances once", "[Device][BatchRunner]")
+{
+	constexpr size_t instance_count = 8;
+	constexpr size_t frame_count = 4;
+
+	// Half of the instances press a different button after the second frame
+	const auto create_callback = [](size_t a_Instance) -> BatchRunner::FrameCallback
+	{
+		return [a_Instance](Device& a_Device, size_t a_Frame)
+		{
+			if (a_Frame == 2 && a_Instance >= instance_count / 2)
+			{
+				a_Device.GetJoypad().SetButtonState(uint8_t(1) << (a_Instance - instance_count / 2), true);
+			}
+			return true;
+		};
+	};
+
+	BatchRunner lockstep(GENERATE(1, 3));
+	BatchRunner reference(1);
+	lockstep.SetLockstepEnabled(true);
+	for (auto* runner : { &lockstep, &reference })
+	{
+		runner->AddMemoryRegion(0xC000, 1);
+		for (size_t i = 0; i < instance_count; ++i)
+		{
+			runner->AddInstance(GetDevice().Fork(), frame_count, create_callback(i));
+		}
+		runner->Run();
+	}
+
+	// Two frames for everyone, then two frames for the instances that stayed together and each one that diverged
+	REQUIRE(lockstep.GetFramesRun() == 2 + 2 + 2 * instance_count / 2);
+	REQUIRE(lockstep.GetFramesRun() + lockstep.GetFramesShared() == instance_count * frame_count);
+	REQUIRE(reference.GetFramesRun() == instance_count * frame_count);
+
+	for (size_t i = 0; i < instance_count; ++i)
+	{
+		INFO("Instance " << i);
+		const auto& result = lockstep.GetResult(i);
+		const auto& expected = reference.GetResult(i);
+		REQUIRE(result.m_Frames == expected.m_Frames);
+		REQUIRE(result.m_FrameBufferHash == expected.m_FrameBufferHash);
+		REQUIRE(result.m_MemoryRegions == expected.m_MemoryRegions);
+		REQUIRE(result.m_SerialOutput == expected.m_SerialOutput);
+
+		std::vector<uint8_t> state;
+		std::vector<uint8_t> expected_state;
+		lockstep.GetDevice(i).SaveState(state);
+		reference.GetDevice(i).SaveState(expected_state);
+		REQUIRE(state == expected_state);
+	}
+}
\ No newline at end of file
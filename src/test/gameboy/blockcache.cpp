@@ -0,0 +1,119 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/device.hpp>
+#include <gameboy/mbc1cartridge.hpp>
+
+#include <memory>
+
+using namespace Amber;
+using namespace Gameboy;
+using namespace Test;
+
+namespace
+{
+	struct BlockCacheTestFixture : DeviceFixture
+	{
+		static constexpr size_t ROMSize = 0x10000;
+		static constexpr size_t Cycles = 20000;
+
+		BlockCacheTestFixture():
+			DeviceFixture(std::make_unique<MBC1Cartridge>(ROMSize, 0))
+		{
+		}
+
+		DeviceState Run(bool a_BlockCache, bool a_JIT = false)
+		{
+			DeviceFixture fixture(std::make_unique<MBC1Cartridge>(ROMSize, 0));
+			fixture.CopyROM(*this);
+
+			auto& device = fixture.GetDevice();
+			auto& cpu = device.GetCPU();
+			cpu.SetBlockCacheEnabled(a_BlockCache);
+			cpu.SetJITEnabled(a_JIT);
+
+			for (size_t i = 0; i < Cycles; ++i)
+			{
+				device.Tick();
+			}
+
+			return fixture.GetState();
+		}
+	};
+}
+
+TEST_CASE_METHOD(BlockCacheTestFixture, "Block cache follows self-modifying code in WRAM", "[CPU][BlockCache]")
+{
+	Write(0x0100, {
+		0x21, 0x00, 0xC1, // LD HL,C100
+		0x36, 0x04,       // LD (HL),INC B
+		0x23,             // INC HL
+		0x36, 0xC9,       // LD (HL),RET
+		0xCD, 0x00, 0xC1, // CALL C100
+		0xFA, 0x00, 0xC1, // LD A,(C100)
+		0xEE, 0x08,       // XOR 08 (INC B <-> INC C)
+		0xEA, 0x00, 0xC1, // LD (C100),A
+		0xCB, 0x37,       // SWAP A
+		0xCB, 0x37,       // SWAP A
+		0x18, 0xEF,       // JR -17
+	});
+
+	const DeviceState interpreted = Run(false);
+	const DeviceState cached = Run(true);
+
+	REQUIRE((interpreted.m_Registers[CPU::RegisterBC] >> 8) != 0);
+	REQUIRE((interpreted.m_Registers[CPU::RegisterBC] & 0xFF) != 0);
+	REQUIRE(cached == interpreted);
+}
+
+TEST_CASE_METHOD(BlockCacheTestFixture, "Block cache keeps switched ROM banks apart", "[CPU][BlockCache]")
+{
+	Write(0x0100, {
+		0x3E, 0x01,       // LD A,01
+		0xEA, 0x00, 0x20, // LD (2000),A
+		0xCD, 0x00, 0x40, // CALL 4000
+		0x3E, 0x02,       // LD A,02
+		0xEA, 0x00, 0x20, // LD (2000),A
+		0xCD, 0x00, 0x40, // CALL 4000
+		0x18, 0xEE,       // JR -18
+	});
+	Write(0x4000, { 0x04, 0xC9 }); // Bank 1: INC B, RET
+	Write(0x8000, { 0x0C, 0xC9 }); // Bank 2: INC C, RET
+
+	const DeviceState interpreted = Run(false);
+	const DeviceState cached = Run(true);
+
+	REQUIRE((interpreted.m_Registers[CPU::RegisterBC] >> 8) != 0);
+	REQUIRE((interpreted.m_Registers[CPU::RegisterBC] & 0xFF) != 0);
+	REQUIRE(cached == interpreted);
+}
+
+TEST_CASE_METHOD(BlockCacheTestFixture, "JIT traces match the interpreter", "[CPU][JIT]")
+{
+	// The loop never ends and logs DIV to WRAM after every trace, so a trace that takes a cycle more or less than
+	// the interpreter shows up in the log and in how often the loop ran
+	Write(0x0100, {
+		0xF3,             // DI
+		0x21, 0x00, 0xC0, // LD HL,C000
+		0x06, 0x00,       // LD B,00
+		0x04,             // INC B
+		0x80,             // ADD A,B
+		0xEE, 0x5A,       // XOR 5A
+		0x07,             // RLCA
+		0xCB, 0x37,       // SWAP A
+		0x57,             // LD D,A
+		0x13,             // INC DE
+		0xF0, 0x04,       // LDH A,(04)
+		0x22,             // LD (HL+),A
+		0x18, 0xF2,       // JR -14
+	});
+
+	const DeviceState interpreted = Run(false);
+	const DeviceState compiled = Run(true, true);
+
+	REQUIRE(interpreted.m_Registers[CPU::RegisterBC] != 0);
+	REQUIRE(interpreted.m_Registers[CPU::RegisterHL] < 0xE000);
+	REQUIRE(compiled == interpreted);
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include <fixture.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/mmu.hpp>
+#include <gameboy/ppu.hpp>
+
+#include <cstring>
+
+using namespace Amber;
+using namespace Common;
+using namespace Gameboy;
+using namespace Test;
+
+bool DeviceState::operator==(const DeviceState& a_Other) const
+{
+	return m_Registers == a_Other.m_Registers && m_Timer == a_Other.m_Timer && m_InterruptRequests == a_Other.m_InterruptRequests && m_HRAM == a_Other.m_HRAM && m_WRAM == a_Other.m_WRAM && m_LCD == a_Other.m_LCD && m_LY == a_Other.m_LY && m_STAT == a_Other.m_STAT;
+}
+
+DeviceFixture::DeviceFixture(size_t a_RAMSize):
+	DeviceFixture(std::make_unique<BasicCartridge>(ROMSize, a_RAMSize))
+{
+}
+
+DeviceFixture::DeviceFixture(std::unique_ptr<BasicCartridge> a_Cartridge):
+	m_Cartridge(std::move(a_Cartridge)),
+	m_VRAM(0x2000),
+	m_WRAM(0x2000),
+	m_Device(DeviceDescription::DMG)
+{
+	auto& mmu = m_Device.GetMMU();
+	mmu.SetCartridge(m_Cartridge.get());
+	mmu.SetVRAM(&m_VRAM);
+	mmu.SetWRAM(&m_WRAM);
+
+	auto& cpu = m_Device.GetCPU();
+	cpu.StoreRegister16(CPU::RegisterSP, 0xFFFE);
+	cpu.StoreRegister16(CPU::RegisterPC, 0x0100);
+}
+
+Device& DeviceFixture::GetDevice() noexcept
+{
+	return m_Device;
+}
+
+BasicCartridge& DeviceFixture::GetCartridge() noexcept
+{
+	return *m_Cartridge;
+}
+
+RAM16<false>& DeviceFixture::GetVRAM() noexcept
+{
+	return m_VRAM;
+}
+
+RAM16<false>& DeviceFixture::GetWRAM() noexcept
+{
+	return m_WRAM;
+}
+
+void DeviceFixture::Write(size_t a_Offset, std::initializer_list<uint8_t> a_Bytes)
+{
+	std::memcpy(m_Cartridge->GetROM().GetData() + a_Offset, a_Bytes.begin(), a_Bytes.size());
+}
+
+void DeviceFixture::CopyROM(DeviceFixture& a_Other)
+{
+	auto& rom = m_Cartridge->GetROM();
+	std::memcpy(rom.GetData(), a_Other.GetCartridge().GetROM().GetData(), rom.GetSize());
+}
+
+void DeviceFixture::RunFrame()
+{
+	RunFrame(m_Device);
+}
+
+void DeviceFixture::RunFrame(Device& a_Device)
+{
+	for (size_t i = 0; i < PPU::FrameCycles / 4; ++i)
+	{
+		a_Device.Tick();
+	}
+	while (!a_Device.Tick())
+	{
+	}
+}
+
+DeviceState DeviceFixture::GetState()
+{
+	m_Device.Synchronize();
+
+	DeviceState state;
+	auto& cpu = m_Device.GetCPU();
+	for (uint8_t i = 0; i < state.m_Registers.size(); ++i)
+	{
+		state.m_Registers[i] = cpu.LoadRegister16(i);
+	}
+	state.m_Timer = { cpu.GetDIV(), cpu.GetTIMA(), cpu.GetTMA(), cpu.GetTAC() };
+	state.m_InterruptRequests = cpu.GetInterruptRequests();
+
+	for (uint16_t i = 0; i < state.m_HRAM.size(); ++i)
+	{
+		state.m_HRAM[i] = cpu.LoadMemory<uint8_t>(0xFF80 + i);
+	}
+	// Forking the device moves its WRAM into paged RAM, only the MMU always sees the current one
+	auto& mmu = m_Device.GetMMU();
+	for (uint16_t i = 0; i < state.m_WRAM.size(); ++i)
+	{
+		state.m_WRAM[i] = mmu.Load8(0xC000 + i);
+	}
+
+	auto& ppu = m_Device.GetPPU();
+	state.m_LCD.resize(PPU::LCDWidth * PPU::LCDHeight * 4);
+	ppu.Blit(state.m_LCD.data(), PPU::LCDWidth);
+	state.m_LY = ppu.GetLY();
+	state.m_STAT = ppu.GetSTAT();
+
+	return state;
+}
\ No newline at end of file
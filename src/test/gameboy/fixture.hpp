@@ -0,0 +1,64 @@
+#ifndef H_AMBER_TEST_GAMEBOY_FIXTURE
+#define H_AMBER_TEST_GAMEBOY_FIXTURE
+
+#include <gameboy/basiccartridge.hpp>
+#include <gameboy/device.hpp>
+
+#include <common/ram.hpp>
+
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace Amber::Test
+{
+	// Everything tests compare after running the same program in different modes
+	struct DeviceState
+	{
+		std::array<uint16_t, 6> m_Registers;
+		std::array<uint8_t, 4> m_Timer;
+		uint8_t m_InterruptRequests;
+		std::array<uint8_t, 0x7F> m_HRAM;
+		std::array<uint8_t, 0x2000> m_WRAM;
+		std::vector<uint8_t> m_LCD;
+		uint8_t m_LY;
+		uint8_t m_STAT;
+
+		bool operator==(const DeviceState& a_Other) const;
+	};
+
+	// A DMG with a cartridge and plain VRAM and WRAM, set up to start at the cartridge entry point with the stack at
+	// the top of HRAM. Tests write their program to the ROM before running it.
+	class DeviceFixture
+	{
+		public:
+		static constexpr size_t ROMSize = 0x8000;
+
+		explicit DeviceFixture(size_t a_RAMSize = 0);
+		explicit DeviceFixture(std::unique_ptr<Gameboy::BasicCartridge> a_Cartridge);
+
+		Gameboy::Device& GetDevice() noexcept;
+		Gameboy::BasicCartridge& GetCartridge() noexcept;
+		Common::RAM16<false>& GetVRAM() noexcept;
+		Common::RAM16<false>& GetWRAM() noexcept;
+
+		void Write(size_t a_Offset, std::initializer_list<uint8_t> a_Bytes);
+		// Copies the program another fixture has written, for tests that run it on several devices
+		void CopyROM(DeviceFixture& a_Other);
+
+		// Roughly a frame, ending between two instructions like the debugger does
+		void RunFrame();
+		static void RunFrame(Gameboy::Device& a_Device);
+
+		DeviceState GetState();
+
+		private:
+		std::unique_ptr<Gameboy::BasicCartridge> m_Cartridge;
+		Common::RAM16<false> m_VRAM;
+		Common::RAM16<false> m_WRAM;
+		Gameboy::Device m_Device;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/device.hpp>
+
+using namespace Amber;
+using namespace Gameboy;
+using namespace Test;
+
+namespace
+{
+	struct IdleSkipTestFixture : DeviceFixture
+	{
+		static constexpr size_t Cycles = 100000;
+
+		// Waits for a flag set by the timer interrupt, then for LY to reach 90, then halts until the next interrupt
+		void WriteProgram()
+		{
+			Write(0x0040, { 0x1C, 0xD9 });                   // VBlank: INC E, RETI
+			Write(0x0050, { 0x14, 0x3E, 0x01, 0xE0, 0x80, 0xD9 }); // Timer: INC D, LD A,01, LD (FF80),A, RETI
+			Write(0x0100, {
+				0x3E, 0x05,       // LD A,05
+				0xEA, 0xFF, 0xFF, // LD (FFFF),A
+				0xE0, 0x07,       // LD (FF07),A
+				0xFB,             // EI
+				0xAF,             // XOR A
+				0xE0, 0x80,       // LD (FF80),A
+				0xF0, 0x80,       // LD A,(FF80)
+				0xA7,             // AND A,A
+				0x28, 0xFB,       // JR Z,-5
+				0xF0, 0x44,       // LD A,(FF44)
+				0xFE, 0x90,       // CP A,90
+				0x20, 0xFA,       // JR NZ,-6
+				0x76,             // HALT
+				0x04,             // INC B
+				0x18, 0xEE,       // JR -18
+			});
+		}
+	};
+}
+
+TEST_CASE("Run matches ticking", "[Device][IdleSkip]")
+{
+	const bool scheduler = GENERATE(false, true);
+
+	IdleSkipTestFixture ticked;
+	ticked.WriteProgram();
+	ticked.GetDevice().SetSchedulerEnabled(scheduler);
+	for (size_t i = 0; i < IdleSkipTestFixture::Cycles; ++i)
+	{
+		ticked.GetDevice().Tick();
+	}
+
+	IdleSkipTestFixture run;
+	run.WriteProgram();
+	run.GetDevice().SetSchedulerEnabled(scheduler);
+	run.GetDevice().Run(IdleSkipTestFixture::Cycles);
+
+	const DeviceState ticked_state = ticked.GetState();
+	const DeviceState run_state = run.GetState();
+
+	REQUIRE((ticked_state.m_Registers[CPU::RegisterBC] >> 8) != 0);
+	REQUIRE((ticked_state.m_Registers[CPU::RegisterDE] >> 8) != 0);
+	REQUIRE((ticked_state.m_Registers[CPU::RegisterDE] & 0xFF) != 0);
+	REQUIRE(run_state == ticked_state);
+}
+
+TEST_CASE_METHOD(IdleSkipTestFixture, "CPU reports idle cycles", "[CPU][IdleSkip]")
+{
+	auto& device = GetDevice();
+	auto& cpu = device.GetCPU();
+
+	SECTION("Jump to itself")
+	{
+		Write(0x0100, { 0x18, 0xFE }); // JR -2
+		while (!device.Tick())
+		{
+		}
+
+		// Whole iterations of 3 cycles only
+		REQUIRE(cpu.GetIdleCycles(100) == 99);
+	}
+
+	SECTION("Halted until the timer overflows")
+	{
+		Write(0x0100, { 0x76 }); // HALT
+		cpu.SetTAC(0b101);
+		cpu.SetTIMA(0xFE);
+
+		// HALT stops the CPU in the cycle after it, which doesn't end an instruction
+		for (size_t i = 0; i < 3; ++i)
+		{
+			device.Tick();
+		}
+
+		// TIMA counts every 4 cycles, the cycle that overflows it has to be ticked
+		const size_t cycles = cpu.GetIdleCycles(1000);
+		REQUIRE(cycles > 0);
+		REQUIRE(cycles < 8);
+
+		cpu.Skip(cycles);
+		REQUIRE(cpu.GetTIMA() == 0xFF);
+		REQUIRE(cpu.GetIdleCycles(1000) == 0);
+	}
+
+	SECTION("Busy")
+	{
+		Write(0x0100, { 0x04, 0x18, 0xFD }); // INC B, JR -3
+		while (!device.Tick())
+		{
+		}
+
+		REQUIRE(cpu.GetIdleCycles(100) == 0);
+	}
+}
\ No newline at end of file
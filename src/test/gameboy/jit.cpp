@@ -0,0 +1,97 @@
+#include <catch2/catch.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/jit.hpp>
+
+#include <common/ram.hpp>
+#include <common/recordable.hpp>
+
+#include <type_traits>
+
+using namespace Amber;
+using namespace Gameboy;
+
+namespace
+{
+	struct First
+	{
+		virtual ~First() = default;
+
+		void Increment()
+		{
+			++m_First;
+		}
+
+		uint32_t m_First = 0;
+	};
+
+	struct Second
+	{
+		void Increment()
+		{
+			m_Second += 2;
+		}
+
+		uint32_t m_Second = 0;
+	};
+
+	// Calls into Second have to move the object pointer to the base
+	struct Both : First, Second
+	{
+		void Increment()
+		{
+			m_Both += 3;
+		}
+
+		uint32_t m_Both = 0;
+	};
+}
+
+TEST_CASE("JIT calls member functions through every base of a class", "[CPU][JIT]")
+{
+	if (!JIT::IsSupported())
+	{
+		return;
+	}
+
+	using Op = void (Both::*)();
+
+	JIT jit;
+	jit.Begin();
+	REQUIRE(jit.EmitCall(Op(&First::Increment)));
+	REQUIRE(jit.EmitCall(Op(&Second::Increment)));
+	REQUIRE(jit.EmitCall(Op(&Second::Increment)));
+	REQUIRE(jit.EmitCall(Op(&Both::Increment)));
+	const auto function = jit.End();
+	REQUIRE(function != nullptr);
+
+	Both both;
+	function(&both);
+	REQUIRE(both.m_First == 1);
+	REQUIRE(both.m_Second == 4);
+	REQUIRE(both.m_Both == 3);
+}
+
+TEST_CASE("JIT calls into the CPU", "[CPU][JIT]")
+{
+	// The CPU derives from Recordable as well, so its member function pointers have the multiple inheritance layout
+	static_assert(std::is_base_of_v<Common::Recordable, CPU>);
+
+	if (!JIT::IsSupported())
+	{
+		return;
+	}
+
+	Common::RAM16<false> memory(0x10000);
+	CPU cpu(memory);
+	cpu.StoreRegister16(CPU::RegisterPC, 0x1234);
+
+	JIT jit;
+	jit.Begin();
+	REQUIRE(jit.EmitCall(&CPU::Reset));
+	const auto function = jit.End();
+	REQUIRE(function != nullptr);
+
+	function(&cpu);
+	REQUIRE(cpu.LoadRegister16(CPU::RegisterPC) == 0);
+}
\ No newline at end of file
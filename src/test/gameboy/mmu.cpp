@@ -0,0 +1,148 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/basiccartridge.hpp>
+#include <gameboy/device.hpp>
+#include <gameboy/mbc1cartridge.hpp>
+#include <gameboy/mmu.hpp>
+
+#include <common/pagedram.hpp>
+
+using namespace Amber;
+using namespace Common;
+using namespace Gameboy;
+using namespace Test;
+
+// Every load below would see the old bank if the MMU kept a page mapped across the switch
+TEST_CASE("MMU pages follow MBC1 bank switches", "[MMU]")
+{
+	constexpr size_t ROMBankCount = 32;
+	constexpr size_t RAMBankCount = 4;
+
+	MBC1Cartridge cartridge(ROMBankCount * 0x4000, RAMBankCount * 0x2000);
+	uint8_t* const rom = cartridge.GetROM().GetData();
+	for (size_t bank = 0; bank < ROMBankCount; ++bank)
+	{
+		rom[bank * 0x4000] = static_cast<uint8_t>(bank);
+		rom[bank * 0x4000 + 0x3FFF] = static_cast<uint8_t>(0x80 | bank);
+	}
+
+	MMU mmu;
+	mmu.SetCartridge(&cartridge);
+
+	SECTION("ROM banks")
+	{
+		for (uint8_t bank = 1; bank < ROMBankCount; ++bank)
+		{
+			mmu.Store8(0x2000, bank);
+			REQUIRE(mmu.Load8(0x4000) == bank);
+			REQUIRE(mmu.Load8(0x7FFF) == (0x80 | bank));
+			REQUIRE(mmu.Load8(0x0000) == 0);
+		}
+
+		// Bank 0 can't be mapped to the switchable area, it selects bank 1
+		mmu.Store8(0x2000, 0);
+		REQUIRE(mmu.Load8(0x4000) == 1);
+	}
+
+	SECTION("RAM enable")
+	{
+		REQUIRE(mmu.Load8(0xA000) == 0xFF);
+		mmu.Store8(0xA000, 0x12);
+		REQUIRE(mmu.Load8(0xA000) == 0xFF);
+
+		mmu.Store8(0x0000, 0x0A);
+		REQUIRE(mmu.Load8(0xA000) == 0x00);
+		mmu.Store8(0xA000, 0x12);
+		mmu.Store8(0xBFFF, 0x34);
+		REQUIRE(mmu.Load8(0xA000) == 0x12);
+		REQUIRE(mmu.Load8(0xBFFF) == 0x34);
+
+		// Disabled RAM can't be written either, enabling it again shows what was there
+		mmu.Store8(0x0000, 0x00);
+		REQUIRE(mmu.Load8(0xA000) == 0xFF);
+		mmu.Store8(0xA000, 0x56);
+
+		mmu.Store8(0x0000, 0x0A);
+		REQUIRE(mmu.Load8(0xA000) == 0x12);
+		REQUIRE(mmu.Load8(0xBFFF) == 0x34);
+	}
+
+	SECTION("RAM banks")
+	{
+		mmu.Store8(0x0000, 0x0A);
+		mmu.Store8(0x6000, 0x01);
+
+		for (uint8_t bank = 0; bank < RAMBankCount; ++bank)
+		{
+			mmu.Store8(0x4000, bank);
+			mmu.Store8(0xA000, 0x40 | bank);
+			mmu.Store8(0xB000, 0x50 | bank);
+		}
+
+		for (uint8_t bank = 0; bank < RAMBankCount; ++bank)
+		{
+			mmu.Store8(0x4000, bank);
+			REQUIRE(mmu.Load8(0xA000) == (0x40 | bank));
+			REQUIRE(mmu.Load8(0xB000) == (0x50 | bank));
+		}
+
+		// Going back to ROM banking maps RAM bank 0 again
+		mmu.Store8(0x6000, 0x00);
+		REQUIRE(mmu.Load8(0xA000) == 0x40);
+	}
+}
+
+TEST_CASE("MMU pages shared with a fork are mapped again after the first store", "[MMU][Fork]")
+{
+	DeviceFixture fixture(0x2000);
+	auto& device = fixture.GetDevice();
+	auto& mmu = device.GetMMU();
+
+	mmu.Store8(0xA000, 0x01);
+	mmu.Store8(0xC000, 0x01);
+
+	// The first fork moves the plain RAM into pages, which both forks share with the device
+	auto base = device.Fork();
+	auto fork = base->Fork();
+	auto& base_mmu = base->GetMMU();
+	auto& fork_mmu = fork->GetMMU();
+	auto& fork_wram = static_cast<PagedRAM16<false>&>(*fork_mmu.GetWRAM());
+	auto& fork_cartridge = static_cast<BasicCartridge&>(*fork_mmu.GetCartridge());
+	REQUIRE(fork_wram.GetSharedPageCount() == 2);
+	REQUIRE(fork_cartridge.GetRAM().GetSharedPageCount() == 2);
+
+	const uint16_t address = GENERATE(uint16_t(0xA000), uint16_t(0xC000), uint16_t(0xD000), uint16_t(0xE000));
+	const uint16_t other = address == 0xE000 ? 0xC000 : address;
+	INFO("Address " << address);
+
+	// The first store copies the page, the ones after it have to land in the copy as well
+	fork_mmu.Store8(address, 0x02);
+	fork_mmu.Store8(address + 1, 0x03);
+	fork_mmu.Store16(address + 2, 0x0504);
+	REQUIRE(fork_mmu.Load8(other) == 0x02);
+	REQUIRE(fork_mmu.Load8(other + 1) == 0x03);
+	REQUIRE(fork_mmu.Load16(other + 2) == 0x0504);
+	REQUIRE(fork_wram.GetSharedPageCount() + fork_cartridge.GetRAM().GetSharedPageCount() == 3);
+
+	REQUIRE(base_mmu.Load8(other) == mmu.Load8(other));
+	REQUIRE(base_mmu.Load8(other + 1) == mmu.Load8(other + 1));
+	REQUIRE(base_mmu.Load16(other + 2) == mmu.Load16(other + 2));
+
+	// The base owns its page alone again, its stores don't reach the fork
+	base_mmu.Store8(address, 0x06);
+	base_mmu.Store8(address + 1, 0x07);
+	REQUIRE(base_mmu.Load8(other) == 0x06);
+	REQUIRE(fork_mmu.Load8(other) == 0x02);
+	REQUIRE(fork_mmu.Load8(other + 1) == 0x03);
+
+	// The original device wasn't touched, and forking unmapped the pages it now shares
+	REQUIRE(mmu.Load8(0xA000) == 0x01);
+	REQUIRE(mmu.Load8(0xC000) == 0x01);
+
+	const uint8_t base_value = base_mmu.Load8(0xA000);
+	mmu.Store8(0xA000, 0x08);
+	REQUIRE(mmu.Load8(0xA000) == 0x08);
+	REQUIRE(base_mmu.Load8(0xA000) == base_value);
+}
\ No newline at end of file
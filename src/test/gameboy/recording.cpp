@@ -0,0 +1,413 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/basiccartridge.hpp>
+#include <gameboy/cpu.hpp>
+#include <gameboy/device.hpp>
+#include <gameboy/devicereplayer.hpp>
+#include <gameboy/joypad.hpp>
+#include <gameboy/mmu.hpp>
+#include <gameboy/ppu.hpp>
+
+#include <common/pagedram.hpp>
+#include <common/recorder.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace Amber;
+using namespace Common;
+using namespace Gameboy;
+using namespace Test;
+
+namespace
+{
+	struct RecordingTestFixture : DeviceFixture
+	{
+		RecordingTestFixture():
+			DeviceFixture(0x2000)
+		{
+		}
+
+		// Stores the first VBlank count to WRAM, then keeps counting VBlanks in E and writing LY to VRAM and cartridge RAM
+		void WriteProgram()
+		{
+			Write(0x0040, { 0x1C, 0xD9 }); // VBlank: INC E, RETI
+			Write(0x0100, {
+				0x3E, 0x01,       // LD A,01
+				0xEA, 0xFF, 0xFF, // LD (FFFF),A
+				0x21, 0x00, 0xC0, // LD HL,C000
+				0xFB,             // EI
+				0x76,             // HALT
+				0x73,             // LD (HL),E
+				0x2C,             // INC L
+				0xFA, 0x44, 0xFF, // LD A,(FF44)
+				0xEA, 0x00, 0x98, // LD (9800),A
+				0xEA, 0x00, 0xA0, // LD (A000),A
+				0x14,             // INC D
+				0x18, 0xF3,       // JR -13
+			});
+		}
+	};
+}
+
+TEST_CASE_METHOD(RecordingTestFixture, "Restoring a recorded frame resumes the exact same execution", "[Device][Recording]")
+{
+	constexpr size_t frame_count = 12;
+
+	GetDevice().SetSchedulerEnabled(GENERATE(false, true));
+
+	WriteProgram();
+
+	RecorderDescription description;
+	GetDevice().AddRecorderChannels(description);
+	REQUIRE(description.FindChannel("CPU").has_value());
+	REQUIRE(description.FindChannel("PPU").has_value());
+	REQUIRE(description.FindChannel("MMU").has_value());
+	REQUIRE(description.FindChannel("Joypad").has_value());
+	REQUIRE(description.FindChannel("Cartridge").has_value());
+	REQUIRE(description.FindChannel("VRAM").has_value());
+	REQUIRE(description.FindChannel("WRAM").has_value());
+
+	Recorder recorder(description);
+	for (size_t i = 0; i < frame_count; ++i)
+	{
+		recorder.NewFrame();
+		GetDevice().Record(recorder);
+		RunFrame();
+	}
+	recorder.SetCurrentFrame(0);
+
+	REQUIRE(GetDevice().GetCPU().LoadRegister8(CPU::RegisterE) != 0);
+
+	// Restoring any frame and running from there has to record the same next frame
+	for (size_t frame : { size_t(3), size_t(0), size_t(7), size_t(frame_count - 2) })
+	{
+		recorder.SetCurrentFrame(frame);
+		GetDevice().Restore(recorder);
+		RunFrame();
+
+		Recorder replay(description);
+		replay.NewFrame();
+		GetDevice().Record(replay);
+
+		recorder.SetCurrentFrame(frame + 1);
+		for (size_t channel = 0; channel < description.GetChannelCount(); ++channel)
+		{
+			INFO("Frame " << frame << ", channel " << description.GetChannel(channel).GetName());
+			REQUIRE(std::memcmp(replay.ReadChannelData(channel), recorder.ReadChannelData(channel), description.GetChannel(channel).GetSize()) == 0);
+		}
+	}
+}
+
+TEST_CASE_METHOD(RecordingTestFixture, "Seeking a journaled recording replays the device from the nearest keyframe", "[Device][Recording]")
+{
+	constexpr size_t frame_count = 40;
+	constexpr size_t keyframe_interval = 8;
+
+	GetDevice().SetSchedulerEnabled(GENERATE(false, true));
+
+	// Stores the directions held at every VBlank to WRAM
+	Write(0x0040, { 0x1C, 0xD9 }); // VBlank: INC E, RETI
+	Write(0x0100, {
+		0x3E, 0x01,       // LD A,01
+		0xEA, 0xFF, 0xFF, // LD (FFFF),A
+		0x21, 0x00, 0xC0, // LD HL,C000
+		0xFB,             // EI
+		0x76,             // HALT
+		0x3E, 0x20,       // LD A,20
+		0xE0, 0x00,       // LDH (00),A
+		0xF0, 0x00,       // LDH A,(00)
+		0x22,             // LD (HL+),A
+		0x18, 0xF6,       // JR -10
+	});
+
+	DeviceReplayer replayer(GetDevice());
+
+	RecorderDescription description;
+	GetDevice().AddRecorderChannels(description, true);
+	description.SetKeyframeInterval(keyframe_interval);
+	REQUIRE(description.GetChannel(*description.FindChannel(Device::InputChannelName)).IsJournaled());
+
+	Recorder recorder(description);
+	recorder.SetReplayer(&replayer);
+
+	// Frames are run and recorded the way the client does, buttons only change in between
+	auto& joypad = GetDevice().GetJoypad();
+	std::vector<std::vector<uint8_t>> states;
+	for (size_t frame = 0; frame < frame_count; ++frame)
+	{
+		if (frame % 3 == 0)
+		{
+			joypad.SetButtonState(0b1111, false);
+			joypad.SetButtonState(static_cast<uint8_t>(1 << ((frame / 3) % 4)), true);
+		}
+
+		replayer.RunFrame();
+		recorder.NewFrame();
+		GetDevice().Record(recorder);
+
+		states.emplace_back();
+		GetDevice().SaveState(states.back());
+	}
+	recorder.SetCurrentFrame(0);
+
+	REQUIRE(GetWRAM().GetData()[frame_count / 2] != GetWRAM().GetData()[frame_count / 2 + 3]);
+
+	for (size_t frame : { size_t(frame_count - 1), size_t(5), size_t(17), size_t(16), size_t(30), size_t(2) })
+	{
+		recorder.SetCurrentFrame(frame);
+		GetDevice().Restore(recorder);
+
+		INFO("Frame " << frame);
+		std::vector<uint8_t> state;
+		GetDevice().SaveState(state);
+		REQUIRE(state == states[frame]);
+	}
+}
+
+TEST_CASE_METHOD(RecordingTestFixture, "Loading a save state resumes the exact same execution", "[Device][SaveState]")
+{
+	GetDevice().SetSchedulerEnabled(GENERATE(false, true));
+	WriteProgram();
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		RunFrame();
+	}
+
+	std::vector<uint8_t> state;
+	GetDevice().SaveState(state);
+
+	std::vector<uint8_t> expected;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		RunFrame();
+	}
+	GetDevice().SaveState(expected);
+	REQUIRE(expected.size() == state.size());
+	REQUIRE(expected != state);
+
+	// Loading twice from a device that has moved on has to end up in the same place
+	for (size_t attempt = 0; attempt < 2; ++attempt)
+	{
+		GetDevice().LoadState(state.data(), state.size());
+		for (size_t i = 0; i < 4; ++i)
+		{
+			RunFrame();
+		}
+
+		std::vector<uint8_t> replay;
+		GetDevice().SaveState(replay);
+		REQUIRE(replay == expected);
+	}
+}
+
+TEST_CASE_METHOD(RecordingTestFixture, "A save state between instructions keeps what the last one left pending", "[Device][SaveState]")
+{
+	// Both interrupts are requested up front: EI dispatches VBlank after INC B, and the RETI of its handler dispatches
+	// STAT right away
+	Write(0x0040, { 0x1C, 0xD9 }); // VBlank: INC E, RETI
+	Write(0x0048, { 0x14, 0xD9 }); // STAT: INC D, RETI
+	Write(0x0100, {
+		0x3E, 0x03,       // LD A,03
+		0xEA, 0xFF, 0xFF, // LD (FFFF),A
+		0xEA, 0x0F, 0xFF, // LD (FF0F),A
+		0xFB,             // EI
+		0x04,             // INC B
+		0x0C,             // INC C
+		0x18, 0xFD,       // JR -3
+	});
+
+	auto& cpu = GetDevice().GetCPU();
+	SECTION("Right after EI")
+	{
+		while (!GetDevice().Tick() || cpu.LoadRegister16(CPU::RegisterPC) != 0x0109)
+		{
+		}
+	}
+
+	SECTION("Right after RETI")
+	{
+		while (!GetDevice().Tick() || cpu.LoadRegister8(CPU::RegisterE) == 0 || cpu.LoadRegister16(CPU::RegisterPC) < 0x0100)
+		{
+		}
+		REQUIRE(cpu.LoadRegister8(CPU::RegisterD) == 0);
+	}
+
+	std::vector<uint8_t> state;
+	GetDevice().SaveState(state);
+
+	std::vector<uint8_t> expected;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		GetDevice().Tick();
+	}
+	GetDevice().SaveState(expected);
+	REQUIRE(cpu.LoadRegister8(CPU::RegisterD) == 1);
+	REQUIRE(cpu.LoadRegister8(CPU::RegisterE) == 1);
+
+	GetDevice().LoadState(state.data(), state.size());
+	for (size_t i = 0; i < 100; ++i)
+	{
+		GetDevice().Tick();
+	}
+
+	std::vector<uint8_t> replay;
+	GetDevice().SaveState(replay);
+	REQUIRE(replay == expected);
+}
+
+TEST_CASE_METHOD(RecordingTestFixture, "A device forked mid-frame presents the same next frame", "[Device][Fork]")
+{
+	GetDevice().SetSchedulerEnabled(GENERATE(false, true));
+	WriteProgram();
+
+	// Every background tile draws as stripes, so any line missing from the frame shows up
+	std::memset(GetVRAM().GetData(), 0x55, 0x1000);
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		RunFrame();
+	}
+	while (GetDevice().GetPPU().GetLY() < PPU::LCDHeight / 2)
+	{
+		GetDevice().Tick();
+	}
+
+	auto fork = GetDevice().Fork();
+
+	const auto run_to_next_frame = [](Device& a_Device)
+	{
+		auto& ppu = a_Device.GetPPU();
+		const auto sequence = ppu.GetFrameSequence();
+		while (ppu.GetFrameSequence() == sequence)
+		{
+			a_Device.Tick();
+		}
+		return std::vector<uint8_t>(ppu.GetFrameBuffer(), ppu.GetFrameBuffer() + PPU::FrameBufferSize);
+	};
+
+	const auto expected = run_to_next_frame(GetDevice());
+	REQUIRE(std::count(expected.begin(), expected.end(), 0) == 0);
+	REQUIRE(run_to_next_frame(*fork) == expected);
+}
+
+TEST_CASE_METHOD(RecordingTestFixture, "Invalid save states are rejected without touching the device", "[Device][SaveState]")
+{
+	WriteProgram();
+	RunFrame();
+
+	std::vector<uint8_t> state;
+	GetDevice().SaveState(state);
+	RunFrame();
+
+	std::vector<uint8_t> before;
+	GetDevice().SaveState(before);
+
+	SECTION("Wrong magic")
+	{
+		state[0] = 'X';
+		REQUIRE_THROWS(GetDevice().LoadState(state.data(), state.size()));
+	}
+
+	SECTION("Newer version")
+	{
+		state[8] = Device::SaveStateVersion + 1;
+		REQUIRE_THROWS(GetDevice().LoadState(state.data(), state.size()));
+	}
+
+	SECTION("Truncated")
+	{
+		REQUIRE_THROWS(GetDevice().LoadState(state.data(), state.size() - 1));
+		REQUIRE_THROWS(GetDevice().LoadState(state.data(), 4));
+	}
+
+	SECTION("Different cartridge RAM size")
+	{
+		BasicCartridge cartridge(ROMSize, 0x8000);
+		GetDevice().GetMMU().SetCartridge(&cartridge);
+		REQUIRE_THROWS(GetDevice().LoadState(state.data(), state.size()));
+		GetDevice().GetMMU().SetCartridge(&GetCartridge());
+	}
+
+	std::vector<uint8_t> after;
+	GetDevice().SaveState(after);
+	REQUIRE(after == before);
+}
+
+TEST_CASE_METHOD(RecordingTestFixture, "A forked device runs exactly like the original", "[Device][Fork]")
+{
+	GetDevice().SetSchedulerEnabled(GENERATE(false, true));
+	WriteProgram();
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		RunFrame();
+	}
+
+	// The first fork moves the plain RAM of the device into pages, forking again only shares them
+	auto base = GetDevice().Fork();
+	auto fork = base->Fork();
+	auto& wram = static_cast<PagedRAM16<false>&>(*fork->GetMMU().GetWRAM());
+	auto& cartridge = static_cast<BasicCartridge&>(*fork->GetMMU().GetCartridge());
+	REQUIRE(wram.GetSharedPageCount() == 2);
+	REQUIRE(cartridge.GetRAM().GetSharedPageCount() == 2);
+	REQUIRE(&cartridge.GetROM() == &GetCartridge().GetROM());
+
+	std::vector<uint8_t> base_state;
+	base->SaveState(base_state);
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		RunFrame();
+		RunFrame(*fork);
+	}
+
+	std::vector<uint8_t> expected;
+	std::vector<uint8_t> state;
+	GetDevice().SaveState(expected);
+	fork->SaveState(state);
+	REQUIRE(state == expected);
+
+	// By now the program only writes to the first page of cartridge RAM, the base didn't change at all
+	REQUIRE(wram.GetSharedPageCount() == 2);
+	REQUIRE(cartridge.GetRAM().GetSharedPageCount() == 1);
+
+	base->SaveState(state);
+	REQUIRE(state == base_state);
+}
+
+TEST_CASE_METHOD(RecordingTestFixture, "Forks of a device with plain RAM share its pages", "[Device][Fork]")
+{
+	WriteProgram();
+	RunFrame();
+
+	auto first = GetDevice().Fork();
+	auto second = GetDevice().Fork();
+
+	// The device's own RAM was swapped for the paged copy on the first fork, only the MMU sees it now
+	auto& mmu = GetDevice().GetMMU();
+	REQUIRE(mmu.GetVRAM() != &GetVRAM());
+	REQUIRE(mmu.GetWRAM() != &GetWRAM());
+
+	for (Device* device : { &GetDevice(), first.get(), second.get() })
+	{
+		auto& device_mmu = device->GetMMU();
+		REQUIRE(static_cast<PagedRAM16<false>&>(*device_mmu.GetVRAM()).GetSharedPageCount() == 2);
+		REQUIRE(static_cast<PagedRAM16<false>&>(*device_mmu.GetWRAM()).GetSharedPageCount() == 2);
+	}
+
+	// Running the device copies only the pages it writes to, the forks keep sharing theirs
+	RunFrame();
+	RunFrame(*first);
+
+	std::vector<uint8_t> expected;
+	std::vector<uint8_t> state;
+	GetDevice().SaveState(expected);
+	first->SaveState(state);
+	REQUIRE(state == expected);
+	REQUIRE(static_cast<PagedRAM16<false>&>(*second->GetMMU().GetWRAM()).GetSharedPageCount() == 2);
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/device.hpp>
+#include <gameboy/ppu.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+using namespace Amber;
+using namespace Gameboy;
+using namespace Test;
+
+namespace
+{
+	struct RendererTestFixture : DeviceFixture
+	{
+		static constexpr size_t Cycles = 60000;
+
+		RendererTestFixture()
+		{
+			// Arbitrary tiles, maps and sprites, overlapping and flipped in every possible way
+			uint32_t seed = 0x12345678;
+			const auto random = [&seed]()
+			{
+				seed = seed * 1664525 + 1013904223;
+				return static_cast<uint8_t>(seed >> 24);
+			};
+
+			for (auto& byte : m_VRAM)
+			{
+				byte = random();
+			}
+
+			for (size_t i = 0; i < m_OAM.size(); i += 4)
+			{
+				m_OAM[i + 0] = random() % 170;
+				m_OAM[i + 1] = random() % 176;
+				m_OAM[i + 2] = random();
+				m_OAM[i + 3] = random() & 0b1111'0000;
+			}
+
+			std::memcpy(GetVRAM().GetData(), m_VRAM.data(), m_VRAM.size());
+			std::memcpy(GetDevice().GetPPU().GetOAM(), m_OAM.data(), m_OAM.size());
+		}
+
+		DeviceState Run(bool a_Scanline, bool a_Scheduler)
+		{
+			DeviceFixture fixture;
+			fixture.CopyROM(*this);
+			std::memcpy(fixture.GetVRAM().GetData(), m_VRAM.data(), m_VRAM.size());
+
+			auto& device = fixture.GetDevice();
+			device.SetSchedulerEnabled(a_Scheduler);
+
+			auto& ppu = device.GetPPU();
+			std::memcpy(ppu.GetOAM(), m_OAM.data(), m_OAM.size());
+			ppu.SetScanlineRendererEnabled(a_Scanline);
+
+			for (size_t i = 0; i < Cycles; ++i)
+			{
+				device.Tick();
+			}
+
+			return fixture.GetState();
+		}
+
+		std::array<uint8_t, 0x2000> m_VRAM;
+		std::array<uint8_t, 160> m_OAM;
+	};
+}
+
+TEST_CASE_METHOD(RendererTestFixture, "Scanline renderer matches the pixel FIFO", "[PPU][Renderer]")
+{
+	// Scroll, palette and VRAM writes every few lines, some of which land in the middle of pixel transfer
+	const uint8_t delay = GENERATE(0x07, 0x35, 0xC8);
+
+	Write(0x0100, {
+		0x0E, 0x00,       // LD C,00
+		0x06, delay,      // LD B,<delay>
+		0x05,             // DEC B
+		0x20, 0xFD,       // JR NZ,-3
+		0x0C,             // INC C
+		0x79,             // LD A,C
+		0xEA, 0x43, 0xFF, // LD (FF43),A
+		0xEA, 0x42, 0xFF, // LD (FF42),A
+		0xEA, 0x10, 0x98, // LD (9810),A
+		0x07,             // RLCA
+		0xEA, 0x47, 0xFF, // LD (FF47),A
+		0xEA, 0x48, 0xFF, // LD (FF48),A
+		0x18, 0xE7,       // JR -25
+	});
+
+	const DeviceState fifo = Run(false, false);
+	const DeviceState scanline = Run(true, false);
+	const DeviceState scheduled = Run(true, true);
+
+	REQUIRE(scanline == fifo);
+	REQUIRE(scheduled == fifo);
+}
+
+TEST_CASE_METHOD(RendererTestFixture, "Blit formats and scales agree", "[PPU][Blit]")
+{
+	auto& ppu = GetDevice().GetPPU();
+	for (size_t i = 0; i < PPU::FrameCycles; ++i)
+	{
+		ppu.Tick();
+	}
+
+	std::vector<uint8_t> indexed(PPU::LCDWidth * PPU::LCDHeight);
+	ppu.Blit(indexed.data(), PPU::LCDWidth, PixelFormat::Indexed8);
+
+	const PixelFormat::Enum format = GENERATE(PixelFormat::RGBA8888, PixelFormat::BGRA8888, PixelFormat::RGB565, PixelFormat::Indexed8);
+	const size_t scale = GENERATE(1, 2, 3, 4, 5);
+	const size_t bytes_per_pixel = PixelFormat::GetBytesPerPixel(format);
+
+	// Leave some slack at the end of every row to check the pitch is honored
+	const size_t pitch = PPU::LCDWidth * scale + 3;
+	std::vector<uint8_t> output(pitch * PPU::LCDHeight * scale * bytes_per_pixel, 0xAB);
+	ppu.Blit(output.data(), pitch, format, scale);
+
+	static constexpr uint8_t shades[] = { 0xFF, 0xCC, 0x77, 0x00 };
+
+	const auto matches = [&](const uint8_t* a_Pixel, uint8_t a_Index)
+	{
+		const uint8_t shade = shades[a_Index];
+
+		switch (format)
+		{
+			case PixelFormat::RGB565:
+			{
+				uint16_t color;
+				std::memcpy(&color, a_Pixel, sizeof(color));
+				return color == (((shade >> 3) << 11) | ((shade >> 2) << 5) | (shade >> 3));
+			}
+
+			case PixelFormat::Indexed8:
+			return a_Pixel[0] == a_Index;
+
+			default:
+			return a_Pixel[0] == shade && a_Pixel[1] == shade && a_Pixel[2] == shade && a_Pixel[3] == 0xFF;
+		}
+	};
+
+	size_t mismatches = 0;
+	size_t overwrites = 0;
+	for (size_t y = 0; y < PPU::LCDHeight * scale; ++y)
+	{
+		for (size_t x = 0; x < pitch; ++x)
+		{
+			const uint8_t* const pixel = output.data() + (y * pitch + x) * bytes_per_pixel;
+
+			if (x >= PPU::LCDWidth * scale)
+			{
+				overwrites += std::count_if(pixel, pixel + bytes_per_pixel, [](uint8_t a_Byte) { return a_Byte != 0xAB; });
+			}
+			else if (!matches(pixel, indexed[(y / scale) * PPU::LCDWidth + x / scale]))
+			{
+				++mismatches;
+			}
+		}
+	}
+
+	REQUIRE(mismatches == 0);
+	REQUIRE(overwrites == 0);
+}
+
+TEST_CASE_METHOD(RendererTestFixture, "Frame buffer only changes when a frame is presented", "[PPU][Frame]")
+{
+	auto& ppu = GetDevice().GetPPU();
+
+	const auto tick_until_presented = [&ppu]()
+	{
+		const uint64_t sequence = ppu.GetFrameSequence();
+		for (size_t i = 0; i < PPU::FrameCycles && ppu.GetFrameSequence() == sequence; ++i)
+		{
+			ppu.Tick();
+		}
+		return ppu.GetFrameSequence();
+	};
+
+	const uint64_t sequence = tick_until_presented();
+	const std::vector<uint8_t> frame(ppu.GetFrameBuffer(), ppu.GetFrameBuffer() + PPU::FrameBufferSize);
+
+	// Draw most of the next frame from different tiles
+	for (auto& byte : m_VRAM)
+	{
+		byte = ~byte;
+	}
+	std::memcpy(GetVRAM().GetData(), m_VRAM.data(), m_VRAM.size());
+
+	for (size_t i = 0; i < PPU::ScreenCycles - PPU::LineCycles; ++i)
+	{
+		ppu.Tick();
+	}
+
+	REQUIRE(ppu.GetFrameSequence() == sequence);
+	REQUIRE(std::equal(frame.begin(), frame.end(), ppu.GetFrameBuffer()));
+
+	REQUIRE(tick_until_presented() == sequence + 1);
+	REQUIRE(!std::equal(frame.begin(), frame.end(), ppu.GetFrameBuffer()));
+}
\ No newline at end of file
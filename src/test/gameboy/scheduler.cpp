@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+
+#include <fixture.hpp>
+
+#include <gameboy/cpu.hpp>
+#include <gameboy/device.hpp>
+#include <gameboy/ppu.hpp>
+
+using namespace Amber;
+using namespace Gameboy;
+using namespace Test;
+
+namespace
+{
+	struct SchedulerTestFixture : DeviceFixture
+	{
+		static constexpr size_t Cycles = 60000;
+
+		DeviceState Run(bool a_Scheduler)
+		{
+			DeviceFixture fixture;
+			fixture.CopyROM(*this);
+
+			auto& device = fixture.GetDevice();
+			device.SetSchedulerEnabled(a_Scheduler);
+			for (size_t i = 0; i < Cycles; ++i)
+			{
+				device.Tick();
+			}
+
+			return fixture.GetState();
+		}
+	};
+}
+
+TEST_CASE_METHOD(SchedulerTestFixture, "Scheduler matches lock-step execution", "[Device][Scheduler]")
+{
+	const uint8_t stat = GENERATE(0x00, PPU::HBlankInterruptSTATMask, PPU::OAMInterruptSTATMask, PPU::LYCInterruptSTATMask);
+
+	Write(0x0040, { 0x1C, 0xD9 }); // VBlank: INC E, RETI
+	Write(0x0048, { 0x14, 0xD9 }); // STAT: INC D, RETI
+	Write(0x0100, {
+		0x3E, 0x03,       // LD A,03
+		0xEA, 0xFF, 0xFF, // LD (FFFF),A
+		0x3E, stat,       // LD A,<stat>
+		0xEA, 0x41, 0xFF, // LD (FF41),A
+		0x3E, 0x50,       // LD A,50
+		0xEA, 0x45, 0xFF, // LD (FF45),A
+		0x21, 0x00, 0xC0, // LD HL,C000
+		0xFB,             // EI
+		0xFA, 0x44, 0xFF, // LD A,(FF44)
+		0x77,             // LD (HL),A
+		0x2C,             // INC L
+		0xEA, 0x00, 0x98, // LD (9800),A
+		0xFA, 0x41, 0xFF, // LD A,(FF41)
+		0x77,             // LD (HL),A
+		0x2C,             // INC L
+		0x18, 0xF1,       // JR -15
+	});
+
+	const DeviceState lockstep = Run(false);
+	const DeviceState scheduled = Run(true);
+
+	REQUIRE((lockstep.m_Registers[CPU::RegisterDE] & 0xFF) != 0);
+	REQUIRE(scheduled == lockstep);
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include <catch2/catch.hpp>
+
+#include <gameboy/tiledecoder.hpp>
+
+using namespace Amber;
+using namespace Gameboy;
+
+namespace
+{
+	uint8_t ReferenceColor(uint8_t a_Low, uint8_t a_High, uint8_t a_Pixel)
+	{
+		const uint8_t bit0 = (a_Low >> (7 - a_Pixel)) & 0b1;
+		const uint8_t bit1 = (a_High >> (7 - a_Pixel)) & 0b1;
+		return bit0 | (bit1 << 1);
+	}
+}
+
+TEST_CASE("Tile decoder rows match bit-by-bit decoding", "[PPU][TileDecoder]")
+{
+	for (size_t low = 0; low < 256; ++low)
+	{
+		for (size_t high = 0; high < 256; ++high)
+		{
+			const uint64_t bytes = TileDecoder::DecodeRow(static_cast<uint8_t>(low), static_cast<uint8_t>(high));
+			const uint32_t nibbles = TileDecoder::DecodeRowNibbles(static_cast<uint8_t>(low), static_cast<uint8_t>(high));
+			const uint16_t interleaved = TileDecoder::InterleaveRow(static_cast<uint8_t>(low), static_cast<uint8_t>(high));
+
+			for (uint8_t pixel = 0; pixel < 8; ++pixel)
+			{
+				const uint8_t color = ReferenceColor(static_cast<uint8_t>(low), static_cast<uint8_t>(high), pixel);
+
+				REQUIRE(((bytes >> (pixel * 8)) & 0xFF) == color);
+				REQUIRE(((nibbles >> (pixel * 4)) & 0xF) == color);
+				REQUIRE(((interleaved >> ((7 - pixel) * 2)) & 0b11) == color);
+			}
+		}
+	}
+}
+
+TEST_CASE("Tile decoder tiles match bit-by-bit decoding", "[PPU][TileDecoder]")
+{
+	uint8_t data[16];
+	uint32_t seed = GENERATE(1, 2, 3, 4);
+	for (auto& byte : data)
+	{
+		seed = seed * 1664525 + 1013904223;
+		byte = static_cast<uint8_t>(seed >> 24);
+	}
+
+	uint8_t colors[64];
+	TileDecoder::DecodeTile(data, colors);
+
+	for (uint8_t row = 0; row < 8; ++row)
+	{
+		for (uint8_t pixel = 0; pixel < 8; ++pixel)
+		{
+			REQUIRE(colors[row * 8 + pixel] == ReferenceColor(data[row * 2], data[row * 2 + 1], pixel));
+		}
+	}
+}
\ No newline at end of file
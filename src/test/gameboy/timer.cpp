@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+
+#include <gameboy/cpu.hpp>
+
+#include <common/ram.hpp>
+
+using namespace Amber;
+using namespace Common;
+using namespace Gameboy;
+
+namespace
+{
+	// CPU running NOPs, with the timer counting every 4 cycles (TAC 05 increments TIMA when DIV bit 3 falls)
+	struct TimerTestFixture
+	{
+		TimerTestFixture():
+			m_Memory(0x10000),
+			m_CPU(m_Memory)
+		{
+			m_CPU.SetTAC(0b101);
+		}
+
+		void Tick(size_t a_Cycles)
+		{
+			for (size_t i = 0; i < a_Cycles; ++i)
+			{
+				m_CPU.Tick();
+			}
+		}
+
+		bool IsTimerRequested() const noexcept
+		{
+			return (m_CPU.GetInterruptRequests() & CPU::InterruptTimer) != 0;
+		}
+
+		RAM16<false> m_Memory;
+		CPU m_CPU;
+	};
+}
+
+TEST_CASE_METHOD(TimerTestFixture, "Timer counts falling edges of the DIV bit", "[CPU][Timer]")
+{
+	Tick(3);
+	REQUIRE(m_CPU.GetTIMA() == 0);
+
+	Tick(1);
+	REQUIRE(m_CPU.GetTIMA() == 1);
+
+	// 1000 edges, reloading the default TMA of 0 wraps around as usual
+	Tick(3996);
+	REQUIRE(m_CPU.GetTIMA() == 1000 % 256);
+	REQUIRE(m_CPU.GetDIV() == (4000 * 4 / 256) % 256);
+}
+
+TEST_CASE_METHOD(TimerTestFixture, "Timer reloads TMA the cycle after an overflow", "[CPU][Timer]")
+{
+	m_CPU.SetTIMA(0xFF);
+	m_CPU.SetTMA(0x42);
+
+	Tick(4);
+	REQUIRE(m_CPU.GetTIMA() == 0);
+	REQUIRE(!IsTimerRequested());
+
+	Tick(1);
+	REQUIRE(m_CPU.GetTIMA() == 0x42);
+	REQUIRE(IsTimerRequested());
+}
+
+TEST_CASE_METHOD(TimerTestFixture, "Timer reload overrides a TIMA write in the same cycle", "[CPU][Timer]")
+{
+	m_CPU.SetTIMA(0xFF);
+	m_CPU.SetTMA(0x42);
+
+	Tick(4);
+	m_CPU.SetTIMA(0x10);
+	Tick(1);
+	REQUIRE(m_CPU.GetTIMA() == 0x42);
+	REQUIRE(IsTimerRequested());
+}
+
+TEST_CASE_METHOD(TimerTestFixture, "Timer writes that drop the DIV bit count as a falling edge", "[CPU][Timer]")
+{
+	// DIV bit 3 is set after two cycles
+	Tick(2);
+	REQUIRE(m_CPU.GetTIMA() == 0);
+
+	SECTION("DIV reset")
+	{
+		m_CPU.SetDIV(0);
+		Tick(1);
+		REQUIRE(m_CPU.GetTIMA() == 1);
+
+		// Back on the regular schedule from the new DIV
+		Tick(3);
+		REQUIRE(m_CPU.GetTIMA() == 2);
+	}
+
+	SECTION("Timer disabled")
+	{
+		m_CPU.SetTAC(0b001);
+		Tick(1);
+		REQUIRE(m_CPU.GetTIMA() == 1);
+
+		Tick(100);
+		REQUIRE(m_CPU.GetTIMA() == 1);
+	}
+
+	SECTION("Input clock changed")
+	{
+		// DIV bit 5 is still clear
+		m_CPU.SetTAC(0b110);
+		Tick(1);
+		REQUIRE(m_CPU.GetTIMA() == 1);
+	}
+}
\ No newline at end of file